@@ -9,6 +9,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ast/node.hpp>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -20,30 +21,36 @@ namespace phylanx { namespace ast { namespace detail
     PHYLANX_EXPORT std::string function_attribute(primary_expr const& pe);
     PHYLANX_EXPORT std::vector<expression> function_arguments(
         primary_expr const& pe);
+    PHYLANX_EXPORT std::size_t function_argument_count(
+        primary_expr const& pe);
 
     PHYLANX_EXPORT bool is_function_call(operand const& op);
     PHYLANX_EXPORT std::string function_name(operand const& op);
     PHYLANX_EXPORT std::string function_attribute(operand const& op);
     PHYLANX_EXPORT std::vector<expression> function_arguments(
         operand const& op);
+    PHYLANX_EXPORT std::size_t function_argument_count(operand const& op);
 
     inline bool is_function_call(operation const& op);
     inline std::string function_name(operation const& op);
     inline std::string function_attribute(operation const& op);
     inline std::vector<expression> function_arguments(
         operation const& op);
+    inline std::size_t function_argument_count(operation const& op);
 
     inline bool is_function_call(expression const& expr);
     inline std::string function_name(expression const& expr);
     inline std::string function_attribute(expression const& expr);
     inline std::vector<expression> function_arguments(
         expression const& expr);
+    inline std::size_t function_argument_count(expression const& expr);
 
     inline bool is_function_call(function_call const& fc);
     inline std::string function_name(function_call const& fc);
     inline std::string function_attribute(function_call const& fc);
     inline std::vector<expression> function_arguments(
             function_call const& id);
+    inline std::size_t function_argument_count(function_call const& fc);
 
     template <typename Ast>
     bool is_function_call(Ast const&)
@@ -66,6 +73,11 @@ namespace phylanx { namespace ast { namespace detail
         static std::vector<expression> noargs;
         return noargs;
     }
+    template <typename Ast>
+    std::size_t function_argument_count(Ast const&)
+    {
+        return 0;
+    }
 
     template <typename Ast>
     bool is_function_call(util::recursive_wrapper<Ast> const& ast)
@@ -88,6 +100,12 @@ namespace phylanx { namespace ast { namespace detail
     {
         return function_arguments(ast.get());
     }
+    template <typename Ast>
+    std::size_t function_argument_count(
+        util::recursive_wrapper<Ast> const& ast)
+    {
+        return function_argument_count(ast.get());
+    }
 
     inline bool is_function_call(operation const& op)
     {
@@ -106,6 +124,10 @@ namespace phylanx { namespace ast { namespace detail
     {
         return function_arguments(op.operand_);
     }
+    inline std::size_t function_argument_count(operation const& op)
+    {
+        return function_argument_count(op.operand_);
+    }
 
     inline bool is_function_call(expression const& expr)
     {
@@ -141,6 +163,14 @@ namespace phylanx { namespace ast { namespace detail
         }
         return function_arguments(expr.first);
     }
+    inline std::size_t function_argument_count(expression const& expr)
+    {
+        if (!expr.rest.empty())
+        {
+            return 0;
+        }
+        return function_argument_count(expr.first);
+    }
 
     inline bool is_function_call(function_call const& fc)
     {
@@ -159,6 +189,10 @@ namespace phylanx { namespace ast { namespace detail
     {
         return fc.args;
     }
+    inline std::size_t function_argument_count(function_call const& fc)
+    {
+        return fc.args.size();
+    }
 }}}
 
 #endif
@@ -22,9 +22,27 @@ namespace phylanx { namespace ast
             std::string const& code);
     }
 
+    /// The parsers available for converting PhySL source code into AST
+    /// instances. Both generate identical ASTs.
+    enum class parser_type
+    {
+        /// Use the parser selected by the configuration setting
+        /// phylanx.parser ("spirit" (default) or "recursive_descent")
+        configured,
+        /// The Boost.Spirit based grammar
+        spirit,
+        /// The hand-written recursive-descent parser
+        recursive_descent
+    };
+
     /// Parse the given string and convert it into a list of AST instances
     PHYLANX_EXPORT std::vector<ast::expression> generate_ast(
         std::string const& input);
+
+    /// Parse the given string using the given parser and convert it into a
+    /// list of AST instances
+    PHYLANX_EXPORT std::vector<ast::expression> generate_ast(
+        std::string const& input, parser_type type);
 }}
 
 #endif
@@ -0,0 +1,28 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_AST_PARSER_RECURSIVE_DESCENT_HPP)
+#define PHYLANX_AST_PARSER_RECURSIVE_DESCENT_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace ast { namespace parser
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Hand-written recursive-descent parser for PhySL. It accepts the same
+    // language as the Spirit grammar (see expression_def.hpp) and generates
+    // identical AST instances, including the line/column information the
+    // grammar attaches to identifiers and literals. Operator precedence is
+    // not resolved while parsing, binary operations are collected into the
+    // flat operand list of ast::expression, exactly as the grammar does.
+    PHYLANX_EXPORT std::vector<ast::expression> parse_recursive_descent(
+        std::string const& input);
+}}}
+
+#endif
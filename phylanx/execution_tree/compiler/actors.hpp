@@ -13,6 +13,7 @@
 #include <hpx/exception.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/async_base/launch_policy.hpp>
+#include <hpx/modules/naming.hpp>
 #include <hpx/serialization/serialization_fwd.hpp>
 
 #if !defined(PHYLANX_HAVE_CXX17_SHARED_PTR_ARRAY)
@@ -634,6 +635,23 @@ namespace phylanx { namespace execution_tree { namespace compiler
         entry_point_set::iterator last_inserted_;
     };
 
+    // Data used for the elimination of common subexpressions performed by
+    // the compiler (if enabled, see phylanx.cse)
+    struct common_subexpressions
+    {
+        struct node_info
+        {
+            std::string signature_;     // structural signature of the node
+            std::size_t references_;    // number of referencing expressions
+        };
+
+        // primitive shared by all subexpressions with a given signature
+        std::map<std::string, primitive_argument_type> expressions_;
+
+        // nodes created for pure subexpressions and variable accesses
+        std::map<hpx::naming::gid_type, node_info> nodes_;
+    };
+
     struct function_list
     {
         function_list()
@@ -649,6 +667,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
         std::size_t compile_id_;    // sequence number of this compiler invocation
         program program_;           // storage for top-level code
         std::map<std::string, std::size_t> sequence_numbers_;
+        common_subexpressions common_subexpressions_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -80,11 +80,31 @@ namespace phylanx { namespace execution_tree { namespace compiler
             return false;
         }
 
+        // Could this pattern match a function call with the given number of
+        // arguments?
+        bool matches_arity(std::size_t num_args) const
+        {
+            return has_variadics_ ? num_args >= num_fixed_args_ :
+                                    num_args == num_fixed_args_;
+        }
+
         std::string pattern_;               // pattern
         ast::expression pattern_ast_;       // simplified pattern AST (no arg())
         factory_function_type creator_;     // creator function for the primitive
         std::vector<std::string> args_;     // argument names
         std::vector<std::string> defaults_; // default values
+        bool is_pure_ = false;              // primitive has no side effects
+
+        // creator function for a (local) instance of the primitive, used for
+        // evaluating pure expressions at compile time
+        primitive_factory_function_type instance_creator_ = nullptr;
+
+        // precompiled data used for dispatching the compilation of
+        // expressions to this pattern
+        std::vector<ast::expression> default_asts_; // parsed default values
+        bool is_function_call_ = false;     // pattern_ast_ is a function call
+        bool has_variadics_ = false;        // pattern_ast_ has a '__N' argument
+        std::size_t num_fixed_args_ = 0;    // arguments before any '__N'
     };
 
     using expression_pattern_list =
@@ -0,0 +1,38 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_DEAD_CODE_ELIMINATION_HPP)
+#define PHYLANX_EXECUTION_TREE_DEAD_CODE_ELIMINATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    // Remove dead statements from all block() expressions in the given ASTs:
+    //
+    //  - define(x, ...) statements for variables (and functions) that are
+    //    never referenced, and
+    //  - store(x, ...) statements for variables that are overwritten by a
+    //    subsequent store(x, ...) before being read.
+    //
+    // Statements are removed only if evaluating them has no side effects,
+    // i.e. if they invoke pure primitives only. The last statement of a
+    // block determines its value and is always kept. Returns the number of
+    // removed statements.
+    PHYLANX_EXPORT std::size_t eliminate_dead_code(
+        std::vector<ast::expression>& exprs,
+        expression_pattern_list const& patterns);
+
+    // Return the overall number of statements removed by eliminate_dead_code
+    PHYLANX_EXPORT std::int64_t dead_code_eliminated_count(bool reset);
+}}}
+
+#endif
@@ -23,6 +23,7 @@
 
 #include <boost/utility/string_ref.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <map>
@@ -92,6 +93,13 @@ namespace phylanx { namespace execution_tree
     PHYLANX_EXPORT bool is_primitive_operand(
         primitive_argument_type const& val);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // The variable generation is advanced whenever a variable is (re-)defined
+    // or modified. Memoized evaluation results are valid only for the
+    // generation they were computed for.
+    PHYLANX_EXPORT std::size_t variable_generation() noexcept;
+    PHYLANX_EXPORT void next_variable_generation() noexcept;
+
     ///////////////////////////////////////////////////////////////////////////
     enum class language { cxx = 0, python = 1 };
 
@@ -218,6 +226,12 @@ namespace phylanx { namespace execution_tree
             return bool(variables_);
         }
 
+        // the innermost variable frame of this context
+        std::shared_ptr<variable_frame> const& frame() const noexcept
+        {
+            return variables_;
+        }
+
         std::vector<std::string> back_trace() const
         {
             return variables_->back_trace();
@@ -303,10 +317,10 @@ namespace phylanx { namespace execution_tree
         PHYLANX_EXPORT primitive(hpx::future<hpx::id_type>&& fid,
             std::string const& name, bool register_with_agas = true);
 
-        primitive(primitive const&) = default;
+        PHYLANX_EXPORT primitive(primitive const& rhs);
         primitive(primitive &&) = default;
 
-        primitive& operator=(primitive const&) = default;
+        PHYLANX_EXPORT primitive& operator=(primitive const& rhs);
         primitive& operator=(primitive &&) = default;
 
         PHYLANX_EXPORT hpx::future<primitive_argument_type> eval(
@@ -361,8 +375,32 @@ namespace phylanx { namespace execution_tree
         PHYLANX_EXPORT bool bind(
             primitive_arguments_type const& args, eval_context ctx) const;
 
+        // Memoize the evaluation results of the referenced component. This
+        // is supported for local components only, returns false otherwise.
+        PHYLANX_EXPORT bool enable_memoization() const;
+
     public:
         static bool enable_tracing;
+
+        // access data for performance counters: number of evaluations that
+        // were dispatched directly to a local component and through an
+        // action, respectively
+        PHYLANX_EXPORT static std::int64_t local_eval_count(bool reset);
+        PHYLANX_EXPORT static std::int64_t action_eval_count(bool reset);
+
+    private:
+        // Record the (local) component this client refers to in the local
+        // primitive registry instead of registering its name with AGAS.
+        // Returns false if the component is not local.
+        bool register_locally(std::string const& name) const;
+
+        // Return the component this client refers to, if it is local. The
+        // pinned component is resolved once and cached afterwards.
+        std::shared_ptr<primitives::primitive_component>
+        local_component() const;
+
+        mutable std::shared_ptr<primitives::primitive_component>
+            local_component_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -1064,6 +1102,11 @@ namespace phylanx { namespace execution_tree
         {
             it->second = std::move(var);
         }
+
+        // invalidate all memoized evaluation results, the new value is
+        // visible now
+        next_variable_generation();
+
         return it->second;
     }
 
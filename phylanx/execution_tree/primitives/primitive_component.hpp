@@ -59,6 +59,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_->set_eval_context(std::move(ctx));
         }
 
+        PHYLANX_EXPORT ~primitive_component();
+
         // eval_action
         PHYLANX_EXPORT hpx::future<primitive_argument_type> eval(
             primitive_arguments_type const& params,
@@ -106,6 +108,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         PHYLANX_EXPORT void enable_measurements();
 
+        // memoize the evaluation results of this component (used for
+        // primitives shared between common subexpressions)
+        PHYLANX_EXPORT void enable_memoization();
+
         // decide whether to execute eval directly
         PHYLANX_EXPORT static hpx::launch select_direct_execution(
             eval_action, hpx::launch policy, hpx::naming::address_type lva);
@@ -113,6 +119,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             eval_single_action, hpx::launch policy,
             hpx::naming::address_type lva);
 
+        // decide whether to execute eval directly, used for local
+        // invocations that bypass the actions above
+        PHYLANX_EXPORT hpx::launch select_eval_policy(
+            hpx::launch policy) const;
+
     private:
         std::shared_ptr<primitive_component_base> primitive_;
     };
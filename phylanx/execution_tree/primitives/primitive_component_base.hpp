@@ -83,6 +83,10 @@ namespace phylanx { namespace execution_tree
             // initialize evaluation context (used by target-reference only)
             virtual void set_eval_context(eval_context ctx);
 
+            // access data for performance counter: number of evaluations that
+            // were satisfied by a memoized result
+            static std::int64_t memoized_eval_count(bool reset);
+
         protected:
             friend class primitive_component;
 
@@ -103,6 +107,12 @@ namespace phylanx { namespace execution_tree
 
             void enable_measurements();
 
+            // Memoize the evaluation results of this primitive. This is
+            // enabled by the compiler for primitives shared between identical
+            // (pure) subexpressions. A memoized result is reused as long as
+            // the evaluation context and the variable generation match.
+            void enable_memoization();
+
             // decide whether to execute eval directly
             hpx::launch select_direct_eval_execution(hpx::launch policy) const;
 
@@ -146,6 +156,9 @@ namespace phylanx { namespace execution_tree
             mutable std::int64_t execute_directly_;
             bool measurements_enabled_;
 
+            struct memoized_result;
+            std::shared_ptr<memoized_result> memoized_;
+
 #if defined(HPX_HAVE_APEX)
             std::string eval_name_;
 #ifdef PHYLANX_HAVE_TASK_INLINING_POLICY
@@ -193,6 +206,7 @@ namespace phylanx { namespace execution_tree
           , create_instance_(hpx::get<3>(data))
           , help_string_(std::move(hpx::get<4>(data)))
           , supports_dtype_(false)
+          , is_pure_(false)
         {}
 
         match_pattern_type(char const* primitive_type,
@@ -200,13 +214,14 @@ namespace phylanx { namespace execution_tree
                 factory_function_type create_primitive,
                 primitive_factory_function_type create_instance,
                 std::string && help_string,
-                bool supports_dtype = false)
+                bool supports_dtype = false, bool is_pure = false)
           : primitive_type_(primitive_type)
           , patterns_(std::move(patterns))
           , create_primitive_(create_primitive)
           , create_instance_(create_instance)
           , help_string_(std::move(help_string))
           , supports_dtype_(supports_dtype)
+          , is_pure_(is_pure)
         {}
 
         match_pattern_type(char const* primitive_type,
@@ -214,13 +229,14 @@ namespace phylanx { namespace execution_tree
                 factory_function_type create_primitive,
                 primitive_factory_function_type create_instance,
                 std::string const& help_string,
-                bool supports_dtype = false)
+                bool supports_dtype = false, bool is_pure = false)
           : primitive_type_(primitive_type)
           , patterns_(std::move(patterns))
           , create_primitive_(create_primitive)
           , create_instance_(create_instance)
           , help_string_(help_string)
           , supports_dtype_(supports_dtype)
+          , is_pure_(is_pure)
         {}
 
         std::string primitive_type_;
@@ -229,6 +245,11 @@ namespace phylanx { namespace execution_tree
         primitive_factory_function_type create_instance_;
         std::string help_string_;
         bool supports_dtype_;
+
+        // The primitive has no side effects and its result depends on the
+        // values of its operands only. The compiler may share instances of
+        // pure primitives between identical subexpressions.
+        bool is_pure_;
     };
 
     struct pattern
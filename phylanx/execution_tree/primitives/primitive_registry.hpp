@@ -0,0 +1,54 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_PRIMITIVE_REGISTRY)
+#define PHYLANX_PRIMITIVES_PRIMITIVE_REGISTRY
+
+#include <phylanx/config.hpp>
+
+#include <hpx/modules/naming.hpp>
+
+#include <map>
+#include <string>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace primitives
+    {
+        class primitive_component;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // By default, every named primitive component is registered with AGAS.
+    // If the configuration setting phylanx.agas_registration is set to
+    // 'defined', only the components representing defined entities
+    // (variables, functions, and the define-variable nodes) are registered
+    // with AGAS. All other (anonymous expression) nodes living on this
+    // locality are recorded in a local registry instead. This avoids one
+    // synchronous AGAS round trip for each node created by the compiler.
+    PHYLANX_EXPORT bool requires_agas_registration(std::string const& name);
+
+    // Record the given (local) component in the local registry. The registry
+    // does not keep the component alive, the component removes itself from
+    // the registry during its destruction.
+    PHYLANX_EXPORT void register_local_primitive(std::string const& name,
+        hpx::id_type const& id, primitives::primitive_component const* p);
+
+    PHYLANX_EXPORT void unregister_local_primitive(
+        std::string const& name, primitives::primitive_component const* p);
+
+    // Resolve the given primitive name using the local registry first and
+    // AGAS second. Returns an invalid id if the name is not known.
+    PHYLANX_EXPORT hpx::id_type resolve_primitive_name(std::string const& name);
+
+    // Return all primitives whose name matches the given pattern ('*'
+    // matches any sequence of characters). The result contains the matching
+    // AGAS entries and the matching entries of the local registry.
+    PHYLANX_EXPORT std::map<std::string, hpx::id_type> find_primitives(
+        std::string const& pattern);
+}}
+
+#endif
@@ -184,6 +184,19 @@ namespace phylanx { namespace execution_tree
 
         tiling_span spans_[3];    // page, row and column spans
     };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Number of redistribution plans computed and reused by retile_d
+    PHYLANX_EXPORT std::int64_t retile_plans_computed(bool reset);
+    PHYLANX_EXPORT std::int64_t retile_plans_reused(bool reset);
+
+    namespace detail
+    {
+        PHYLANX_EXPORT void count_retile_plan(bool reused);
+
+        // Maximal number of redistribution plans cached by each retile_d
+        PHYLANX_EXPORT std::size_t retile_plan_cache_capacity();
+    }
 }}
 
 #endif
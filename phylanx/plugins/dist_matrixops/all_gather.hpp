@@ -37,7 +37,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
       , public std::enable_shared_from_this<all_gather>
     {
     public:
-        static execution_tree::match_pattern_type const match_data;
+        static std::vector<execution_tree::match_pattern_type> const
+            match_data;
 
         all_gather() = default;
 
@@ -50,13 +51,20 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
             execution_tree::primitive_arguments_type const& args,
             execution_tree::eval_context ctx) const override;
     private:
+        // a root of -1 gathers the array on all localities
         template <typename T>
         execution_tree::primitive_argument_type all_gather2d(
             ir::node_data<T>&& arr,
-        execution_tree::localities_information&& locs) const;
+            execution_tree::localities_information&& locs, std::int64_t root,
+            execution_tree::primitive_argument_type::annotation_ptr&& ann)
+            const;
 
         execution_tree::primitive_argument_type all_gather2d(
-            execution_tree::primitive_argument_type&& arr) const;
+            execution_tree::primitive_argument_type&& arr,
+            std::int64_t root) const;
+
+    private:
+        bool gather_to_root_;
     };
 
     inline execution_tree::primitive create_all_gather(
@@ -67,6 +75,15 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         return create_primitive_component(
             locality, "all_gather_d", std::move(operands), name, codename);
     }
+
+    inline execution_tree::primitive create_gather(
+        hpx::id_type const& locality,
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "gather_d", std::move(operands), name, codename);
+    }
 }}}    // namespace phylanx::execution_tree::primitives
 
 #endif
@@ -188,16 +188,32 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         std::size_t iter_idx = (lhs_local_tile_index + 1) % lhs_tile_row_size;
         bool lhs_flag = true;
         bool rhs_flag = true;
+        // the tiles are requested as regions, which allows to prefetch the
+        // tiles needed two steps ahead while the ones for the next step are
+        // still in flight
+        auto fetch_lhs_tile = [&](std::size_t idx) {
+            std::size_t loc = lhs_tile_row[idx];
+            auto const& tile = lhs_localities.tiles_[loc];
+            return lhs_data.fetch(loc, 0, 0, tile.spans_[0].size(),
+                tile.spans_[1].size());
+        };
+        auto fetch_rhs_tile = [&](std::size_t idx) {
+            std::size_t loc = rhs_tile_col[idx];
+            auto const& tile = rhs_localities.tiles_[loc];
+            return rhs_data.fetch(loc, 0, 0, tile.spans_[0].size(),
+                tile.spans_[1].size());
+        };
+
         hpx::lcos::future<blaze::DynamicMatrix<T>> lhs_tmp1;
         hpx::lcos::future<blaze::DynamicMatrix<T>> rhs_tmp1;
         if (iter_idx != lhs_local_tile_index)
         {
-            lhs_tmp1 = lhs_data.fetch(lhs_tile_row[iter_idx]);
+            lhs_tmp1 = fetch_lhs_tile(iter_idx);
             lhs_flag = false;
         }
         if (iter_idx != rhs_local_tile_index)
         {
-            rhs_tmp1 = rhs_data.fetch(rhs_tile_col[iter_idx]);
+            rhs_tmp1 = fetch_rhs_tile(iter_idx);
             rhs_flag = false;
         }
         iter_idx = (iter_idx + 1) % lhs_tile_row_size;
@@ -212,11 +228,31 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
             {
                 if (iter_idx != lhs_local_tile_index)
                 {
-                    lhs_tmp2 = lhs_data.fetch(lhs_tile_row[iter_idx]);
+                    lhs_tmp2 = fetch_lhs_tile(iter_idx);
                 }
                 if (iter_idx != rhs_local_tile_index)
                 {
-                    rhs_tmp2 = rhs_data.fetch(rhs_tile_col[iter_idx]);
+                    rhs_tmp2 = fetch_rhs_tile(iter_idx);
+                }
+            }
+
+            // prefetching the tiles for the step after the next one
+            if (i + 2 < lhs_tile_row_size)
+            {
+                std::size_t next_idx = (iter_idx + 1) % lhs_tile_row_size;
+                if (next_idx != lhs_local_tile_index)
+                {
+                    std::size_t loc = lhs_tile_row[next_idx];
+                    auto const& tile = lhs_localities.tiles_[loc];
+                    lhs_data.prefetch(loc, 0, 0, tile.spans_[0].size(),
+                        tile.spans_[1].size());
+                }
+                if (next_idx != rhs_local_tile_index)
+                {
+                    std::size_t loc = rhs_tile_col[next_idx];
+                    auto const& tile = rhs_localities.tiles_[loc];
+                    rhs_data.prefetch(loc, 0, 0, tile.spans_[0].size(),
+                        tile.spans_[1].size());
                 }
             }
 
@@ -22,6 +22,8 @@
 #include <utility>
 #include <vector>
 
+#include <blaze/Math.h>
+
 namespace phylanx { namespace dist_matrixops { namespace primitives
 {
     class dist_dot_operation
@@ -59,7 +61,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type dot1d2d(
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
             execution_tree::localities_information&& lhs_localities,
-            execution_tree::localities_information const& rhs_localities) const;
+            execution_tree::localities_information const& rhs_localities,
+            std::string const& tiling_type) const;
         template <typename T>
         execution_tree::primitive_argument_type dot1d3d(
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const;
@@ -67,21 +70,25 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type dot1d(
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
             execution_tree::localities_information&& lhs_localities,
-            execution_tree::localities_information const& rhs_localities) const;
+            execution_tree::localities_information const& rhs_localities,
+            std::string const& tiling_type) const;
         execution_tree::primitive_argument_type dot1d(
             execution_tree::primitive_argument_type&&,
-            execution_tree::primitive_argument_type&&) const;
+            execution_tree::primitive_argument_type&&,
+            std::string const& tiling_type) const;
 
         template <typename T>
         execution_tree::primitive_argument_type dot2d1d(
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
             execution_tree::localities_information&& lhs_localities,
-            execution_tree::localities_information const& rhs_localities) const;
+            execution_tree::localities_information const& rhs_localities,
+            std::string const& tiling_type) const;
         template <typename T>
         execution_tree::primitive_argument_type dot2d2d(ir::node_data<T>&& lhs,
             ir::node_data<T>&& rhs,
             execution_tree::localities_information&& lhs_localities,
-            execution_tree::localities_information const& rhs_localities) const;
+            execution_tree::localities_information const& rhs_localities,
+            std::string const& tiling_type) const;
         template <typename T>
         execution_tree::primitive_argument_type dot2d3d(
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const;
@@ -89,10 +96,12 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type dot2d(
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
             execution_tree::localities_information&& lhs_localities,
-            execution_tree::localities_information const& rhs_localities) const;
+            execution_tree::localities_information const& rhs_localities,
+            std::string const& tiling_type) const;
         execution_tree::primitive_argument_type dot2d(
             execution_tree::primitive_argument_type&&,
-            execution_tree::primitive_argument_type&&) const;
+            execution_tree::primitive_argument_type&&,
+            std::string const& tiling_type) const;
 
         template <typename T>
         execution_tree::primitive_argument_type dot3d1d(
@@ -114,7 +123,20 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
 
         execution_tree::primitive_argument_type dot_nd(
             execution_tree::primitive_argument_type&& lhs,
-            execution_tree::primitive_argument_type&& rhs) const;
+            execution_tree::primitive_argument_type&& rhs,
+            std::string const& tiling_type) const;
+
+        // combine the partial results of all localities such that each
+        // locality keeps its tile of the overall result only
+        template <typename T>
+        execution_tree::primitive_argument_type reduce_scatter1d(
+            blaze::DynamicVector<T>&& partial_result,
+            execution_tree::localities_information&& lhs_localities) const;
+        template <typename T>
+        execution_tree::primitive_argument_type reduce_scatter2d(
+            blaze::DynamicMatrix<T>&& partial_result,
+            execution_tree::localities_information&& lhs_localities,
+            std::string const& tiling_type) const;
 
     private:
         std::int64_t get_transferred_bytes(bool reset) const;
@@ -17,11 +17,12 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/common/dot_operation_nd.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_dot_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/tile_calculation_helper.hpp>
+#include <phylanx/util/collectives.hpp>
 #include <phylanx/util/distributed_matrix.hpp>
 #include <phylanx/util/distributed_vector.hpp>
 
 #include <hpx/assert.hpp>
-#include <hpx/collectives/all_reduce.hpp>
 #include <hpx/errors/throw_exception.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -32,6 +33,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -88,6 +90,148 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         }
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    // The partial results of all localities are combined using a
+    // reduce-scatter, each locality receives one (balanced) tile of the
+    // overall result only.
+    template <typename T>
+    execution_tree::primitive_argument_type
+    dist_dot_operation::reduce_scatter1d(
+        blaze::DynamicVector<T>&& partial_result,
+        execution_tree::localities_information&& lhs_localities) const
+    {
+        std::uint32_t const num_localities =
+            lhs_localities.locality_.num_localities_;
+        std::uint32_t const locality_id = lhs_localities.locality_.locality_id_;
+
+        std::vector<std::size_t> chunk_starts(num_localities + 1);
+        for (std::uint32_t i = 0; i != num_localities; ++i)
+        {
+            chunk_starts[i] = std::get<0>(tile_calculation::tile_calculation_1d(
+                i, partial_result.size(), num_localities));
+        }
+        chunk_starts[num_localities] = partial_result.size();
+
+        execution_tree::tiling_span span(
+            static_cast<std::int64_t>(chunk_starts[locality_id]),
+            static_cast<std::int64_t>(chunk_starts[locality_id + 1]));
+
+        execution_tree::primitive_argument_type result{util::reduce_scatter(
+            "reduce_scatter_" + lhs_localities.annotation_.name_,
+            std::move(partial_result), std::move(chunk_starts), blaze::Add{},
+            num_localities, locality_id)
+                                                           .get()};
+
+        // Generate new tiling annotation for the result vector
+        execution_tree::tiling_information_1d tile_info(
+            execution_tree::tiling_information_1d::columns, span);
+
+        ++lhs_localities.annotation_.generation_;
+
+        auto locality_ann = lhs_localities.locality_.as_annotation();
+        result.set_annotation(
+            execution_tree::localities_annotation(locality_ann,
+                tile_info.as_annotation(name_, codename_),
+                lhs_localities.annotation_, name_, codename_),
+            name_, codename_);
+
+        return result;
+    }
+
+    template <typename T>
+    execution_tree::primitive_argument_type
+    dist_dot_operation::reduce_scatter2d(
+        blaze::DynamicMatrix<T>&& partial_result,
+        execution_tree::localities_information&& lhs_localities,
+        std::string const& tiling_type) const
+    {
+        std::uint32_t const num_localities =
+            lhs_localities.locality_.num_localities_;
+        std::uint32_t const locality_id = lhs_localities.locality_.locality_id_;
+
+        std::size_t const rows = partial_result.rows();
+        std::size_t const columns = partial_result.columns();
+
+        // the result is tiled along the rows or along the columns, the
+        // matrix is flattened such that each tile is a contiguous chunk
+        bool const row_tiling = tiling_type == "row";
+        std::size_t const dim = row_tiling ? rows : columns;
+        std::size_t const stride = row_tiling ? columns : rows;
+
+        blaze::DynamicVector<T> flat(rows * columns);
+        if (row_tiling)
+        {
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>(
+                flat.data(), rows, columns) = partial_result;
+        }
+        else
+        {
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>(
+                flat.data(), columns, rows) = blaze::trans(partial_result);
+        }
+        partial_result = blaze::DynamicMatrix<T>();
+
+        std::vector<std::size_t> chunk_starts(num_localities + 1);
+        for (std::uint32_t i = 0; i != num_localities; ++i)
+        {
+            chunk_starts[i] = stride *
+                std::get<0>(tile_calculation::tile_calculation_1d(
+                    i, dim, num_localities));
+        }
+        chunk_starts[num_localities] = rows * columns;
+
+        std::size_t const start = chunk_starts[locality_id] / stride;
+        std::size_t const stop = chunk_starts[locality_id + 1] / stride;
+
+        blaze::DynamicVector<T> tile = util::reduce_scatter(
+            "reduce_scatter_" + lhs_localities.annotation_.name_,
+            std::move(flat), std::move(chunk_starts), blaze::Add{},
+            num_localities, locality_id)
+                                           .get();
+
+        using custom_matrix =
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>;
+
+        execution_tree::primitive_argument_type result;
+        execution_tree::annotation ann;
+        if (row_tiling)
+        {
+            result = execution_tree::primitive_argument_type{
+                blaze::DynamicMatrix<T>(
+                    custom_matrix(tile.data(), stop - start, columns))};
+            ann = execution_tree::annotation{ir::range("tile",
+                ir::range("rows", static_cast<std::int64_t>(start),
+                    static_cast<std::int64_t>(stop)),
+                ir::range("columns", static_cast<std::int64_t>(0),
+                    static_cast<std::int64_t>(columns)))};
+        }
+        else
+        {
+            result = execution_tree::primitive_argument_type{
+                blaze::DynamicMatrix<T>(blaze::trans(
+                    custom_matrix(tile.data(), stop - start, rows)))};
+            ann = execution_tree::annotation{ir::range("tile",
+                ir::range("rows", static_cast<std::int64_t>(0),
+                    static_cast<std::int64_t>(rows)),
+                ir::range("columns", static_cast<std::int64_t>(start),
+                    static_cast<std::int64_t>(stop)))};
+        }
+
+        // Generate new tiling annotation for the result matrix
+        execution_tree::tiling_information_2d tile_info(ann, name_, codename_);
+
+        ++lhs_localities.annotation_.generation_;
+
+        auto locality_ann = lhs_localities.locality_.as_annotation();
+        result.set_annotation(
+            execution_tree::localities_annotation(locality_ann,
+                tile_info.as_annotation(name_, codename_),
+                lhs_localities.annotation_, name_, codename_),
+            name_, codename_);
+
+        return result;
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     template <typename T>
     execution_tree::primitive_argument_type dist_dot_operation::dot1d1d(
@@ -187,10 +331,9 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         // collect overall result if left hand side vector is distributed
         if (lhs_localities.locality_.num_localities_ > 1)
         {
-            lhs = hpx::all_reduce(
-                ("all_reduce_" + lhs_localities.annotation_.name_).c_str(),
-                dot_result, std::plus<T>{},
-                lhs_localities.locality_.num_localities_, std::size_t(-1),
+            lhs = util::all_reduce(
+                "all_reduce_" + lhs_localities.annotation_.name_, dot_result,
+                std::plus<T>{}, lhs_localities.locality_.num_localities_,
                 lhs_localities.locality_.locality_id_)
                       .get();
         }
@@ -206,7 +349,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
     execution_tree::primitive_argument_type dist_dot_operation::dot1d2d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         execution_tree::localities_information&& lhs_localities,
-        execution_tree::localities_information const& rhs_localities) const
+        execution_tree::localities_information const& rhs_localities,
+        std::string const& tiling_type) const
     {
         std::size_t rhs_ndim = rhs_localities.num_dimensions();
         if (lhs_localities.num_dimensions() > 1 ||
@@ -308,15 +452,22 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         execution_tree::primitive_argument_type result;
         if (lhs_localities.locality_.num_localities_ > 1)
         {
-            result =
-                execution_tree::primitive_argument_type{hpx::all_reduce(
-                    ("all_reduce_" + lhs_localities.annotation_.name_)
-                        .c_str(),
-                    dot_result, blaze::Add{},
-                    lhs_localities.locality_.num_localities_,
-                    std::size_t(-1), lhs_localities.locality_.locality_id_)
-                                                            .get()};
-
+            if (!tiling_type.empty())
+            {
+                // keep only the local tile of the result
+                result = reduce_scatter1d(
+                    std::move(dot_result), std::move(lhs_localities));
+            }
+            else
+            {
+                result =
+                    execution_tree::primitive_argument_type{util::all_reduce(
+                        "all_reduce_" + lhs_localities.annotation_.name_,
+                        dot_result, blaze::Add{},
+                        lhs_localities.locality_.num_localities_,
+                        lhs_localities.locality_.locality_id_)
+                            .get()};
+            }
         }
         else
         {
@@ -369,7 +520,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
     execution_tree::primitive_argument_type dist_dot_operation::dot1d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         execution_tree::localities_information&& lhs_localities,
-        execution_tree::localities_information const& rhs_localities) const
+        execution_tree::localities_information const& rhs_localities,
+        std::string const& tiling_type) const
     {
         switch (rhs.num_dimensions())
         {
@@ -385,7 +537,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         case 2:
             // If is_vector(lhs) && is_matrix(rhs)
             return dot1d2d(std::move(lhs), std::move(rhs),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         case 3:
             // If is_vector(lhs) && is_tensor(rhs)
@@ -404,7 +556,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
     execution_tree::primitive_argument_type dist_dot_operation::dot2d1d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         execution_tree::localities_information&& lhs_localities,
-        execution_tree::localities_information const& rhs_localities) const
+        execution_tree::localities_information const& rhs_localities,
+        std::string const& tiling_type) const
     {
         std::size_t lhs_ndim = lhs_localities.num_dimensions();
         if ((lhs_ndim != 2 && lhs_ndim != 0) ||
@@ -522,16 +675,21 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
                         lhs_localities.annotation_, name_, codename_),
                     name_, codename_);
             }
+            else if (!tiling_type.empty())
+            {
+                // keep only the local tile of the result
+                result = reduce_scatter1d(
+                    std::move(dot_result), std::move(lhs_localities));
+            }
             else
             {
                 result =
-                    execution_tree::primitive_argument_type{hpx::all_reduce(
-                        ("all_reduce_" + lhs_localities.annotation_.name_)
-                            .c_str(),
+                    execution_tree::primitive_argument_type{util::all_reduce(
+                        "all_reduce_" + lhs_localities.annotation_.name_,
                         dot_result, blaze::Add{},
                         lhs_localities.locality_.num_localities_,
-                        std::size_t(-1), lhs_localities.locality_.locality_id_)
-                                                                .get()};
+                        lhs_localities.locality_.locality_id_)
+                            .get()};
             }
         }
         else
@@ -559,7 +717,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
     execution_tree::primitive_argument_type dist_dot_operation::dot2d2d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         execution_tree::localities_information&& lhs_localities,
-        execution_tree::localities_information const& rhs_localities) const
+        execution_tree::localities_information const& rhs_localities,
+        std::string const& tiling_type) const
     {
         std::size_t lhs_ndim = lhs_localities.num_dimensions();
         std::size_t rhs_ndim = rhs_localities.num_dimensions();
@@ -707,16 +866,21 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
                         lhs_localities.annotation_, name_, codename_),
                     name_, codename_);
             }
+            else if (!tiling_type.empty())
+            {
+                // keep only the local tile of the result
+                result = reduce_scatter2d(std::move(result_matrix),
+                    std::move(lhs_localities), tiling_type);
+            }
             else
             {
                 result =
-                    execution_tree::primitive_argument_type{hpx::all_reduce(
-                        ("all_reduce_" + lhs_localities.annotation_.name_)
-                            .c_str(),
+                    execution_tree::primitive_argument_type{util::all_reduce(
+                        "all_reduce_" + lhs_localities.annotation_.name_,
                         result_matrix, blaze::Add{},
                         lhs_localities.locality_.num_localities_,
-                        std::size_t(-1), lhs_localities.locality_.locality_id_)
-                                                                .get()};
+                        lhs_localities.locality_.locality_id_)
+                            .get()};
             }
         }
         else
@@ -772,7 +936,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
     execution_tree::primitive_argument_type dist_dot_operation::dot2d(
         ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
         execution_tree::localities_information&& lhs_localities,
-        execution_tree::localities_information const& rhs_localities) const
+        execution_tree::localities_information const& rhs_localities,
+        std::string const& tiling_type) const
     {
         switch (rhs.num_dimensions())
         {
@@ -783,12 +948,12 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         case 1:
             // If is_matrix(lhs) && is_vector(rhs)
             return dot2d1d(std::move(lhs), std::move(rhs),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         case 2:
             // If is_matrix(lhs) && is_matrix(rhs)
             return dot2d2d(std::move(lhs), std::move(rhs),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         case 3:
             // If is_matrix(lhs) && is_tensor(rhs)
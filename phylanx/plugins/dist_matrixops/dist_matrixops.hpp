@@ -18,5 +18,6 @@
 #include <phylanx/plugins/dist_matrixops/dist_random.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_transpose_operation.hpp>
 #include <phylanx/plugins/dist_matrixops/retile_annotations.hpp>
+#include <phylanx/plugins/dist_matrixops/update_halo.hpp>
 
 #endif
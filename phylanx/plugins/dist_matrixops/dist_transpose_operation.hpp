@@ -50,13 +50,22 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type transpose1d(
             execution_tree::primitive_argument_type&& arg) const;
         execution_tree::primitive_argument_type transpose2d(
-            execution_tree::primitive_argument_type&& arg) const;
+            execution_tree::primitive_argument_type&& arg,
+            bool keep_tiling) const;
         execution_tree::primitive_argument_type transpose2d(
             execution_tree::primitive_argument_type&& arg,
-            ir::node_data<std::int64_t>&& axes) const;
+            ir::node_data<std::int64_t>&& axes, bool keep_tiling) const;
 
         template <typename T>
         execution_tree::primitive_argument_type transpose2d(
+            ir::node_data<T>&& arg,
+            execution_tree::localities_information&& localities,
+            bool keep_tiling) const;
+
+        // transpose a distributed matrix such that the result is tiled the
+        // same way as the argument
+        template <typename T>
+        execution_tree::primitive_argument_type transpose2d_keep_tiling(
             ir::node_data<T>&& arg,
             execution_tree::localities_information&& localities) const;
 
@@ -74,6 +83,11 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type transpose3d(
             ir::node_data<T>&& arg, ir::node_data<std::int64_t>&& axes,
             execution_tree::localities_information&& localities) const;
+
+    private:
+        std::int64_t get_transferred_bytes(bool reset) const;
+
+        mutable std::int64_t transferred_bytes_;
     };
 
     inline execution_tree::primitive
@@ -11,12 +11,16 @@
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
 
 #include <hpx/futures/future.hpp>
+#include <hpx/synchronization/spinlock.hpp>
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -81,6 +85,40 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         std::int64_t get_transferred_bytes(bool reset) const;
 
         mutable std::int64_t transferred_bytes_;
+
+        // The redistribution plan for retiling a matrix describes for each
+        // locality the block of the local tile that has to be sent to it and
+        // the block of the new local tile that receives the data sent from
+        // it. Blocks are given as {row start, column start, rows, columns},
+        // relative to the start of the respective tile.
+        struct redistribution_plan_2d
+        {
+            using block = std::array<std::int64_t, 4>;
+
+            std::vector<block> send_;
+            std::vector<block> receive_;
+
+            // true if any of the localities needs data from another one
+            bool exchange_ = false;
+        };
+
+        using plan_key_type = std::vector<std::int64_t>;
+
+        std::shared_ptr<redistribution_plan_2d const> get_plan_2d(
+            std::uint32_t loc_id,
+            std::vector<execution_tree::tiling_information> const& source,
+            std::vector<std::array<execution_tree::tiling_span, 2>> const&
+                destination) const;
+
+        using plans_type = std::map<plan_key_type,
+            std::shared_ptr<redistribution_plan_2d const>>;
+
+        // retiling plans cached by source and destination tiling, at most
+        // phylanx.retile.plan_cache_size plans are kept, the oldest plan is
+        // evicted first
+        mutable hpx::lcos::local::spinlock mtx_;
+        mutable plans_type plans_;
+        mutable std::deque<plans_type::iterator> plans_order_;
     };
 
     inline execution_tree::primitive create_retile_annotations(
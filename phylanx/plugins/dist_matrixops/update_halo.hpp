@@ -0,0 +1,79 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_UPDATE_HALO)
+#define PHYLANX_PRIMITIVES_UPDATE_HALO
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    class update_halo
+      : public execution_tree::primitives::primitive_component_base
+      , public std::enable_shared_from_this<update_halo>
+    {
+    public:
+        static execution_tree::match_pattern_type const match_data;
+
+        update_halo() = default;
+
+        update_halo(execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        hpx::future<execution_tree::primitive_argument_type> eval(
+            execution_tree::primitive_arguments_type const& operands,
+            execution_tree::primitive_arguments_type const& args,
+            execution_tree::eval_context ctx) const override;
+
+    private:
+        hpx::future<execution_tree::primitive_argument_type> update_halo1d(
+            execution_tree::primitive_argument_type&& arr) const;
+        template <typename T>
+        hpx::future<execution_tree::primitive_argument_type> update_halo1d(
+            ir::node_data<T>&& arr,
+            execution_tree::localities_information&& arr_localities,
+            execution_tree::primitive_argument_type::annotation_ptr&& ann)
+            const;
+
+        hpx::future<execution_tree::primitive_argument_type> update_halo2d(
+            execution_tree::primitive_argument_type&& arr) const;
+        template <typename T>
+        hpx::future<execution_tree::primitive_argument_type> update_halo2d(
+            ir::node_data<T>&& arr,
+            execution_tree::localities_information&& arr_localities,
+            execution_tree::primitive_argument_type::annotation_ptr&& ann)
+            const;
+
+    private:
+        std::int64_t get_transferred_bytes(bool reset) const;
+
+        mutable std::int64_t transferred_bytes_;
+    };
+
+    inline execution_tree::primitive create_update_halo(
+        hpx::id_type const& locality,
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "update_halo_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
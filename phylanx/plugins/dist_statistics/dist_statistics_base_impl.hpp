@@ -9,9 +9,11 @@
 #define PHYLANX_PRIMITIVE_DIST_STATISTICS_IMPL_2020_JUN_19_1229PM
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/common/statistics_nd.hpp>
 #include <phylanx/plugins/dist_statistics/dist_statistics_base.hpp>
+#include <phylanx/util/collectives.hpp>
 
 #include <hpx/assert.hpp>
 #include <hpx/datastructures/optional.hpp>
@@ -20,6 +22,7 @@
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -175,6 +178,91 @@ namespace phylanx { namespace execution_tree { namespace primitives {
             std::move(initial), dtype, name_, codename_, std::move(ctx));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The partial results are combined using the operation itself. This
+        // requires for the operation to not rely on finalize, which holds
+        // for all distributed statistics operations.
+        template <template <class T> class Op, typename T>
+        struct statistics_all_reduce_op
+        {
+            T operator()(T lhs, T rhs) const
+            {
+                return Op<T>("", "")(lhs, rhs);
+            }
+        };
+
+        // An empty tile does not contribute to the overall result, it is
+        // replaced by the identity of the operation
+        template <template <class T> class Op>
+        primitive_argument_type statistics_identity(node_data_type type)
+        {
+            switch (type)
+            {
+            case node_data_type_bool:
+                return primitive_argument_type{
+                    ir::node_data<std::uint8_t>{Op<std::uint8_t>::initial()}};
+
+            case node_data_type_int64:
+                return primitive_argument_type{
+                    ir::node_data<std::int64_t>{Op<std::int64_t>::initial()}};
+
+            default:
+                break;
+            }
+            return primitive_argument_type{
+                ir::node_data<double>{Op<double>::initial()}};
+        }
+    }
+
+    template <template <class T> class Op, typename Derived>
+    template <typename T>
+    primitive_argument_type
+    dist_statistics_base<Op, Derived>::statistics_all_reduce(
+        ir::node_data<T>&& local, localities_information const& locs) const
+    {
+        return primitive_argument_type{util::all_reduce(
+            "statistics_" + locs.annotation_.name_, local.scalar(),
+            detail::statistics_all_reduce_op<Op, T>{},
+            locs.locality_.num_localities_, locs.locality_.locality_id_)
+                                               .get()};
+    }
+
+    template <template <class T> class Op, typename Derived>
+    primitive_argument_type
+    dist_statistics_base<Op, Derived>::statistics_all_reduce(
+        primitive_argument_type&& local,
+        localities_information const& locs) const
+    {
+        switch (extract_common_type(local))
+        {
+        case node_data_type_bool:
+            return statistics_all_reduce(
+                extract_boolean_value_strict(std::move(local), name_, codename_),
+                locs);
+
+        case node_data_type_int64:
+            return statistics_all_reduce(
+                extract_integer_value_strict(std::move(local), name_, codename_),
+                locs);
+
+        case node_data_type_unknown: HPX_FALLTHROUGH;
+        case node_data_type_double:
+            return statistics_all_reduce(
+                extract_numeric_value(std::move(local), name_, codename_),
+                locs);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_statistics_base<Op, Derived>::statistics_all_reduce",
+            generate_error_message(
+                "the local result has an unsupported type"));
+    }
+
     template <template <class T> class Op, typename Derived>
     primitive_argument_type dist_statistics_base<Op, Derived>::statisticsnd(
         primitive_argument_type&& arg,
@@ -190,6 +278,39 @@ namespace phylanx { namespace execution_tree { namespace primitives {
 
         std::size_t a_dims =
             extract_numeric_value_dimension(arg, name_, codename_);
+
+        // reduce the flattened array: calculate the result for the local
+        // part and combine the results of all localities
+        if (!axis && !keepdims && a_dims != 0)
+        {
+            localities_information locs =
+                extract_localities_information(arg, name_, codename_);
+            if (locs.locality_.num_localities_ > 1)
+            {
+                // the initial value is taken into account only once
+                if (locs.locality_.locality_id_ != 0)
+                {
+                    initial = primitive_argument_type{};
+                }
+
+                // all localities have to take part in the reduction, even if
+                // their tile is empty
+                auto dims =
+                    extract_numeric_value_dimensions(arg, name_, codename_);
+                if (std::find(dims.begin(), dims.begin() + a_dims, 0) !=
+                    dims.begin() + a_dims)
+                {
+                    arg = detail::statistics_identity<Op>(
+                        extract_common_type(arg));
+                }
+
+                return statistics_all_reduce(
+                    common::statisticsnd<Op>(std::move(arg), axis, keepdims,
+                        std::move(initial), dtype, name_, codename_,
+                        std::move(ctx)),
+                    locs);
+            }
+        }
         switch (a_dims)
         {
         case 0:
@@ -0,0 +1,90 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_FILEIO_ASYNC_FILE_WRITE)
+#define PHYLANX_PLUGINS_FILEIO_ASYNC_FILE_WRITE
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+#include <hpx/include/run_as.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        // Asynchronous file writes are performed on the I/O thread pool,
+        // while the primitive that issued the write returns immediately.
+        // Every pending write holds a snapshot of the written data, the
+        // number of writes in flight is therefore bounded by the
+        // configuration setting phylanx.file_write.max_in_flight (default:
+        // 4). Issuing more writes blocks until an earlier write has finished.
+        void acquire_async_write_slot();
+        void release_async_write_slot();
+
+        // Keep track of an issued write, releases its slot once the write
+        // has finished.
+        void register_async_write(hpx::future<void>&& f);
+
+        // Returns a future that becomes ready once all writes issued so far
+        // have finished, it holds the number of those writes. Any error
+        // reported by one of the writes is rethrown.
+        hpx::future<std::size_t> wait_for_async_writes();
+
+        // Run the given write operation asynchronously
+        template <typename F>
+        void launch_async_write(F&& f)
+        {
+            acquire_async_write_slot();
+            try
+            {
+                register_async_write(
+                    hpx::threads::run_as_os_thread(std::forward<F>(f)));
+            }
+            catch (...)
+            {
+                release_async_write_slot();
+                throw;
+            }
+        }
+
+        // Make sure the data written asynchronously does not refer to
+        // storage which may be modified while the write is pending
+        inline ir::node_data<double> snapshot_for_async_write(
+            ir::node_data<double>&& val)
+        {
+            if (!val.is_ref())
+            {
+                return std::move(val);
+            }
+
+            switch (val.num_dimensions())
+            {
+            case 0:
+                return ir::node_data<double>{val.scalar()};
+
+            case 1:
+                return ir::node_data<double>{val.vector_copy()};
+
+            case 2:
+                return ir::node_data<double>{val.matrix_copy()};
+
+            case 3:
+                return ir::node_data<double>{val.tensor_copy()};
+
+            default:
+                break;
+            }
+            return ir::node_data<double>{val.quatern_copy()};
+        }
+    }
+}}}
+
+#endif
@@ -23,6 +23,7 @@
 #include <boost/spirit/include/qi_parse.hpp>
 #include <boost/spirit/include/qi_real.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
@@ -36,58 +37,312 @@
 
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    // read data from given file in blocks of (at most) a given number of
+    // rows, the memory required is bounded by the size of a single block
+    class csv_block_reader
+    {
+    public:
+        csv_block_reader(std::ifstream&& infile, std::string const& filename)
+          : infile_(std::move(infile))
+          , filename_(filename)
+          , header_parsed_(false)
+          , n_rows_(0)
+          , n_cols_(0)
+        {
+        }
+
+        // replace the content of data with the next block of rows, returns
+        // the number of rows read (zero if the end of the file was reached)
+        std::size_t read_block(std::vector<double>& data, std::size_t max_rows)
+        {
+            data.clear();
+
+            std::size_t block_rows = 0;
+            while (block_rows != max_rows && std::getline(infile_, line_))
+            {
+                std::size_t before_readln = data.size();
+
+                auto begin_local = line_.begin();
+                if (boost::spirit::qi::parse(begin_local, line_.end(),
+                        boost::spirit::qi::double_ % ',', current_line_))
+                {
+                    if (begin_local == line_.end() || header_parsed_)
+                    {
+                        header_parsed_ = true;
+
+                        data.insert(data.end(), current_line_.begin(),
+                            current_line_.end());
+
+                        std::size_t after_readln = data.size();
+                        if (n_rows_ == 0)
+                        {
+                            n_cols_ = after_readln;
+                        }
+                        else if (n_cols_ != (after_readln - before_readln))
+                        {
+                            throw std::runtime_error(
+                                util::generate_error_message(
+                                    "wrong data format, different number of "
+                                    "element in this row " + filename_ + ':' +
+                                    std::to_string(n_rows_)));
+                        }
+                        ++n_rows_;
+                        ++block_rows;
+                    }
+                    current_line_.clear();
+                }
+                else
+                {
+                    throw std::runtime_error(
+                        util::generate_error_message("wrong data format " +
+                            filename_ + ':' + std::to_string(n_rows_)));
+                }
+            }
+            return block_rows;
+        }
+
+        std::size_t columns() const
+        {
+            return n_cols_;
+        }
+
+        std::size_t rows_read() const
+        {
+            return n_rows_;
+        }
+
+    private:
+        std::ifstream infile_;
+        std::string filename_;
+        std::string line_;
+        std::vector<double> current_line_;
+        bool header_parsed_;
+        std::size_t n_rows_;
+        std::size_t n_cols_;
+    };
 
     // read data from given file and return content
     inline std::tuple<std::vector<double>, std::size_t, std::size_t>
     read_helper(std::ifstream&& infile, std::string const& filename)
     {
-        std::string line;
-        bool header_parsed = false;
-        std::vector<double> matrix_array, current_line;
-        std::size_t n_rows = 0, n_cols = 0;
-        std::size_t before_readln, after_readln;
+        csv_block_reader reader(std::move(infile), filename);
+
+        std::vector<double> matrix_array;
+        reader.read_block(matrix_array, std::size_t(-1));
 
-        while (std::getline(infile, line))
+        return std::make_tuple(
+            std::move(matrix_array), reader.rows_read(), reader.columns());
+    }
+
+    // read the rows of a csv file that belong to one of several partitions
+    // of the file, each partition is assigned a contiguous range of bytes
+    // and a row belongs to the partition its first character is located in
+    class csv_partitioned_reader
+    {
+    public:
+        // description of the rows in a partition: the offset of the first
+        // row in the file, the number of rows, and the number of columns (zero
+        // if the partition does not hold any rows)
+        using partition_info = std::array<std::int64_t, 3>;
+
+        csv_partitioned_reader(
+                std::ifstream&& infile, std::string const& filename)
+          : infile_(std::move(infile))
+          , filename_(filename)
+          , n_cols_(0)
         {
-            before_readln = matrix_array.size();
+            infile_.seekg(0, std::ios::end);
+            size_ = static_cast<std::int64_t>(infile_.tellg());
+            data_start_ = skip_header();
+        }
+
+        // scan the rows of the given partition without parsing all of them,
+        // the partitions cover the file after the header lines only
+        partition_info scan(
+            std::uint32_t partition, std::uint32_t num_partitions)
+        {
+            std::int64_t const data_size = size_ - data_start_;
+            std::int64_t pos = row_start(
+                data_start_ + data_size * partition / num_partitions);
+            std::int64_t end = row_start(
+                data_start_ + data_size * (partition + 1) / num_partitions);
+
+            partition_info result = {pos, 0, 0};
 
-            auto begin_local = line.begin();
-            if (boost::spirit::qi::parse(begin_local, line.end(),
-                    boost::spirit::qi::double_ % ',', current_line))
+            infile_.clear();
+            infile_.seekg(pos);
+            while (pos < end && std::getline(infile_, line_))
             {
-                if (begin_local == line.end() || header_parsed)
+                std::int64_t next = pos + line_.size() + 1;
+
+                // the number of columns is determined by the first row
+                if (result[2] == 0)
                 {
-                    header_parsed = true;
+                    auto begin_local = line_.begin();
+                    if (!parse_line(begin_local))
+                    {
+                        throw std::runtime_error(util::generate_error_message(
+                            "wrong data format " + filename_ + ':' +
+                            std::to_string(pos)));
+                    }
+                    result[2] = current_line_.size();
+                }
 
-                    matrix_array.insert(matrix_array.end(),
-                        current_line.begin(), current_line.end());
+                ++result[1];
+                pos = next;
+            }
+            return result;
+        }
+
+        // establish the layout of the file from the partitions of all
+        // localities, returns the overall number of rows and columns
+        std::tuple<std::size_t, std::size_t> layout(
+            std::vector<partition_info>&& partitions)
+        {
+            partitions_ = std::move(partitions);
 
-                    after_readln = matrix_array.size();
-                    if (n_rows == 0)
+            std::size_t n_rows = 0;
+            for (auto const& p : partitions_)
+            {
+                if (p[2] != 0)
+                {
+                    if (n_cols_ == 0)
                     {
-                        n_cols = matrix_array.size();
+                        n_cols_ = p[2];
                     }
-                    else if (n_cols != (after_readln - before_readln))
+                    else if (n_cols_ != std::size_t(p[2]))
                     {
                         throw std::runtime_error(util::generate_error_message(
-                            "wrong data format, different number of element in "
-                            "this row " +
-                            filename + ':' + std::to_string(n_rows)));
+                            "wrong data format, different number of element "
+                            "in rows of " + filename_));
                     }
-                    n_rows++;
                 }
-                current_line.clear();
+                n_rows += p[1];
             }
-            else
+            return std::make_tuple(n_rows, n_cols_);
+        }
+
+        // parse the rows [first_row, last_row) for which select(row) returns
+        // true and invoke f(row, values) for each of those
+        template <typename Select, typename F>
+        void read_rows(std::size_t first_row, std::size_t last_row,
+            Select&& select, F&& f)
+        {
+            if (first_row == last_row)
+            {
+                return;
+            }
+
+            // find partition holding the first requested row
+            std::size_t row = 0;
+            auto it = partitions_.begin();
+            for (/**/; it != partitions_.end(); ++it)
             {
-                throw std::runtime_error(
-                    util::generate_error_message("wrong data format " +
-                        filename + ':' + std::to_string(n_rows)));
+                if (row + (*it)[1] > first_row)
+                {
+                    break;
+                }
+                row += (*it)[1];
+            }
+
+            if (it == partitions_.end())
+            {
+                throw std::runtime_error(util::generate_error_message(
+                    "unexpected end of file " + filename_));
+            }
+
+            // rows are stored contiguously, even across partitions
+            infile_.clear();
+            infile_.seekg((*it)[0]);
+            while (row != last_row && std::getline(infile_, line_))
+            {
+                if (row >= first_row && select(row))
+                {
+                    auto begin_local = line_.begin();
+                    if (!parse_line(begin_local) ||
+                        current_line_.size() != n_cols_)
+                    {
+                        throw std::runtime_error(util::generate_error_message(
+                            "wrong data format, different number of element "
+                            "in this row " + filename_ + ':' +
+                            std::to_string(row)));
+                    }
+                    f(row, current_line_);
+                }
+                ++row;
+            }
+
+            if (row != last_row)
+            {
+                throw std::runtime_error(util::generate_error_message(
+                    "unexpected end of file " + filename_));
             }
         }
 
-        return std::move(std::make_tuple(matrix_array, n_rows, n_cols));
-    }
+    private:
+        // As csv_block_reader, skip all leading lines that can't be parsed
+        // completely (headers), return the offset of the first row
+        std::int64_t skip_header()
+        {
+            std::int64_t pos = 0;
+
+            infile_.clear();
+            infile_.seekg(0);
+            while (std::getline(infile_, line_))
+            {
+                auto begin_local = line_.begin();
+                if (!parse_line(begin_local))
+                {
+                    throw std::runtime_error(util::generate_error_message(
+                        "wrong data format " + filename_ + ':' +
+                        std::to_string(pos)));
+                }
+
+                if (begin_local == line_.end())
+                {
+                    return pos;
+                }
+                pos += line_.size() + 1;
+            }
+            return size_;
+        }
+
+        // return the offset of the first row starting at or after the given
+        // offset
+        std::int64_t row_start(std::int64_t offset)
+        {
+            if (offset <= data_start_ || offset >= size_)
+            {
+                return offset;
+            }
+
+            // skip the remainder of the row the previous character belongs to
+            infile_.clear();
+            infile_.seekg(offset - 1);
+            std::getline(infile_, line_);
+            if (infile_.eof())
+            {
+                return size_;
+            }
+            return offset + line_.size();
+        }
+
+        bool parse_line(std::string::iterator& begin_local)
+        {
+            current_line_.clear();
+            return boost::spirit::qi::parse(begin_local, line_.end(),
+                boost::spirit::qi::double_ % ',', current_line_);
+        }
+
+        std::ifstream infile_;
+        std::string filename_;
+        std::string line_;
+        std::vector<double> current_line_;
+        std::vector<partition_info> partitions_;
+        std::int64_t size_;
+        std::int64_t data_start_;
+        std::size_t n_cols_;
+    };
 }}}
 
 #endif
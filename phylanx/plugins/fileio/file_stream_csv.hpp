@@ -0,0 +1,82 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_FILE_STREAM_CSV)
+#define PHYLANX_PRIMITIVES_FILE_STREAM_CSV
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Reads a csv file in blocks of rows and reduces the (optionally
+    ///        transformed) blocks incrementally. At most two blocks of the
+    ///        file are held in memory at any point in time: while one block
+    ///        is being reduced, the next one is read.
+    ///
+    /// \param filename   The csv file to read
+    /// \param reduction  One of "sum", "mean", "var", "min", "max" or "dot"
+    /// \param axis       The axis to reduce along (nil, 0, or 1)
+    /// \param transform  A function that is applied to each block of rows
+    ///                   before it is reduced
+    /// \param rhs        The right hand side of the "dot" reduction
+    /// \param block_rows The number of rows read at once
+    class file_stream_csv
+      : public primitive_component_base
+      , public std::enable_shared_from_this<file_stream_csv>
+    {
+    public:
+        enum stream_reduction
+        {
+            stream_sum,
+            stream_mean,
+            stream_var,
+            stream_min,
+            stream_max,
+            stream_dot
+        };
+
+        static match_pattern_type const match_data;
+
+        file_stream_csv() = default;
+
+        file_stream_csv(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        stream_reduction extract_reduction(std::string const& name) const;
+
+        primitive_argument_type stream(std::string const& filename,
+            stream_reduction reduction, std::int64_t axis, bool has_axis,
+            primitive_argument_type&& transform, primitive_argument_type&& rhs,
+            std::size_t block_rows, eval_context ctx) const;
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+    };
+
+    inline primitive create_file_stream_csv(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "file_stream_csv", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -39,6 +39,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     private:
         hpx::future<primitive_argument_type> write_to_file(
             primitive_argument_type&& val, std::string&& filename) const;
+        void write_to_file_async(
+            primitive_argument_type const& val, std::string&& filename) const;
 
         std::string filename_;
         primitive_argument_type operand_;
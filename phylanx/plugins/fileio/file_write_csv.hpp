@@ -36,8 +36,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::string const& name, std::string const& codename);
 
     private:
+        void write_csv(ir::node_data<double> const& val,
+            std::string const& filename) const;
+
         hpx::future<primitive_argument_type> write_to_file_csv(
             ir::node_data<double>&& val, std::string&& filename) const;
+        void write_to_file_csv_async(
+            ir::node_data<double> const& val, std::string&& filename) const;
     };
 
     inline primitive create_file_write_csv(hpx::id_type const& locality,
@@ -0,0 +1,88 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_KERAS_SUPPORT_FUSED_CROSSENTROPY_OPERATION)
+#define PHYLANX_PLUGINS_KERAS_SUPPORT_FUSED_CROSSENTROPY_OPERATION
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx {  namespace execution_tree {  namespace primitives  {
+
+    /// \brief Computes the cross entropy loss and its gradient with respect
+    ///        to the logits in a single pass over the logits, without
+    ///        materializing the softmax (or sigmoid) of the logits
+    ///
+    /// \param target  The labels, an array of the same shape as logits
+    /// \param logits  The unscaled log probabilities
+    ///
+    /// Both primitives return a list [loss, gradient]. The batch (all
+    /// dimensions but the last) is processed in cache sized chunks which are
+    /// distributed over the HPX worker threads.
+    class fused_crossentropy_operation
+        : public primitive_component_base
+        , public std::enable_shared_from_this<fused_crossentropy_operation>
+    {
+    public:
+        enum crossentropy_mode
+        {
+            crossentropy_mode_softmax,      // softmax_cross_entropy_with_logits
+            crossentropy_mode_sigmoid       // sigmoid_cross_entropy_with_logits
+        };
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+        using arg_type = ir::node_data<double>;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        fused_crossentropy_operation() = default;
+
+        fused_crossentropy_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        primitive_argument_type softmax_cross_entropy(
+            arg_type&& target, arg_type&& logits) const;
+        primitive_argument_type sigmoid_cross_entropy(
+            arg_type&& target, arg_type&& logits) const;
+
+    private:
+        crossentropy_mode mode_;
+    };
+
+    inline primitive create_softmax_cross_entropy_with_logits_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(locality,
+            "softmax_cross_entropy_with_logits", std::move(operands), name,
+            codename);
+    }
+
+    inline primitive create_sigmoid_cross_entropy_with_logits_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(locality,
+            "sigmoid_cross_entropy_with_logits", std::move(operands), name,
+            codename);
+    }
+}}}
+
+#endif
@@ -17,6 +17,7 @@
 #include <phylanx/plugins/keras_support/conv2d_transpose_operation.hpp>
 #include <phylanx/plugins/keras_support/ctc_decode_operation.hpp>
 #include <phylanx/plugins/keras_support/elu_operation.hpp>
+#include <phylanx/plugins/keras_support/fused_crossentropy_operation.hpp>
 #include <phylanx/plugins/keras_support/hard_sigmoid_operation.hpp>
 #include <phylanx/plugins/keras_support/l2_normalize_operation.hpp>
 #include <phylanx/plugins/keras_support/max_pool2d_operation.hpp>
@@ -28,6 +28,8 @@ namespace phylanx { namespace execution_tree { namespace primitives {
 /// \param pool_size The size of pooling over each dimension
 /// \param padding   Padding mode, either `same` or `valid`
 /// \param strides   The step to apply pooling on each dimension
+/// \param return_indices Optional. If true, the flat indices of the maxima
+///                  are returned as well
 
     class max_pool3d_operation
       : public primitive_component_base
@@ -51,30 +53,9 @@ namespace phylanx { namespace execution_tree { namespace primitives {
     private:
         primitive_argument_type max_pool3d(ir::node_data<double>&& arg,
             std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width) const;
-
-        primitive_argument_type max_pool3d(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::size_t stride_depth,
-            std::size_t stride_height, std::size_t stride_width) const;
-
-        primitive_argument_type max_pool3d_same(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width) const;
-
-        primitive_argument_type max_pool3d_same(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::size_t stride_depth,
-            std::size_t stride_height, std::size_t stride_width) const;
-
-        primitive_argument_type max_pool_any_pad(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::string&& padding) const;
-        primitive_argument_type max_pool_any_pad(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::string&& padding,
+            std::size_t filter_width, std::string const& padding,
             std::size_t stride_depth, std::size_t stride_height,
-            std::size_t stride_width) const;
+            std::size_t stride_width, bool return_indices) const;
     };
 
     inline primitive create_max_pool3d_operation(hpx::id_type const& locality,
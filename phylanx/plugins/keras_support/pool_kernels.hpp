@@ -0,0 +1,83 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_KERAS_SUPPORT_POOL_KERNELS)
+#define PHYLANX_KERAS_SUPPORT_POOL_KERNELS
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/pool_indices_helper.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+// Blocked pooling kernels shared by the max_pool and avg_pool primitives.
+//
+// A pooling window is separable, the pooled value of a box is computed by
+// reducing the windows along one axis at a time. The results of a pass are
+// reused by all overlapping windows of the next pass. Within a pass, windows
+// that overlap (stride < pool size) are reduced from precomputed block
+// prefix/suffix maxima (van Herk/Gil-Werman) or prefix sums, such that every
+// output element costs O(1) independently of the pool size.
+namespace pool_kernels
+{
+    enum pool_mode
+    {
+        pool_max,
+        pool_avg
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Describes the pooling windows along one axis of the image
+    struct pool_axis
+    {
+        pool_axis(std::size_t image_size, std::size_t filter_size,
+            std::size_t stride, bool same_padding);
+
+        // Start and (clipped) size of the i'th window
+        pool_indices::sizes window(std::size_t i) const
+        {
+            return pool_indices::get_subsizes(
+                static_cast<std::int64_t>(image_size_),
+                static_cast<std::int64_t>(filter_size_),
+                static_cast<std::int64_t>(i * stride_) - pad_begin_);
+        }
+
+        // Do neighboring windows share enough elements for reusing partial
+        // results to pay off?
+        bool overlapping() const
+        {
+            return stride_ < filter_size_ && filter_size_ > 2;
+        }
+
+        std::size_t image_size_;
+        std::size_t filter_size_;
+        std::size_t stride_;
+        std::int64_t pad_begin_;
+        std::size_t result_size_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Pool a (batch, rows, columns, channels) array over rows and columns.
+    // The work is distributed over the batch x channels planes. If indices
+    // is given, it receives for each pooled value the flat index
+    // (row * columns + column) of the maximum inside its plane.
+    blaze::DynamicArray<4UL, double> pool2d(ir::node_data<double>&& arg,
+        pool_axis const& rows, pool_axis const& columns, pool_mode mode,
+        blaze::DynamicArray<4UL, std::int64_t>* indices = nullptr);
+
+    // Pool a (pages, rows, columns) tensor over all three dimensions. If
+    // indices is given, it receives for each pooled value the flat index
+    // ((page * rows) + row) * columns + column of the maximum.
+    blaze::DynamicTensor<double> pool3d(ir::node_data<double>&& arg,
+        pool_axis const& pages, pool_axis const& rows,
+        pool_axis const& columns, pool_mode mode,
+        blaze::DynamicTensor<std::int64_t>* indices = nullptr);
+}
+
+#endif
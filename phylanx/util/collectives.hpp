@@ -0,0 +1,581 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_COLLECTIVES_HPP)
+#define PHYLANX_UTIL_COLLECTIVES_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/assert.hpp>
+#include <hpx/futures/future.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/runtime.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Phylanx-level collective operations on arrays
+//
+// Small payloads are handled by the collectives provided by HPX, which
+// route all data through a single site. For large payloads and many sites
+// the operations below use point-to-point channels between the sites:
+//
+//  - ring: the bandwidth-optimal all_reduce, a reduce-scatter followed by an
+//    all_gather along a ring of all sites. The data is split into segments
+//    which are forwarded independently of each other, i.e. the reduction of
+//    a segment is overlapped with the transfer of the next one.
+//  - tree: the latency-optimal all_reduce, a reduction along a binomial tree
+//    rooted at site zero followed by a broadcast along the same tree.
+//
+// The algorithm is selected based on the payload size and the number of
+// sites (see select_collective_algorithm). The payload size has to be the
+// same on all sites to ensure that all sites select the same algorithm.
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum class collective_algorithm
+    {
+        direct,     // use the collectives provided by HPX
+        ring,       // segmented ring (reduce-scatter + all_gather)
+        tree        // binomial tree (reduce + broadcast)
+    };
+
+    // Select the algorithm to use for the given payload (in bytes) and
+    // number of sites. This can be overridden using the configuration
+    // setting phylanx.collectives.algorithm (auto, direct, ring, or tree).
+    // The ring algorithm is used for payloads of at least
+    // phylanx.collectives.ring_threshold bytes (default: 1MB), the tree
+    // algorithm for more than phylanx.collectives.tree_threshold sites
+    // (default: 8).
+    PHYLANX_EXPORT collective_algorithm select_collective_algorithm(
+        std::size_t payload, std::size_t num_sites);
+
+    // The size (in bytes) of the segments the ring algorithm sends in one
+    // message (phylanx.collectives.segment_size, default: 256kB)
+    PHYLANX_EXPORT std::size_t collective_segment_size();
+
+    // Generate a unique name for the next invocation of a collective
+    // operation using the given base name
+    PHYLANX_EXPORT std::string generate_collective_name(
+        std::string const& basename);
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The point-to-point endpoints of one invocation of a collective
+        // operation. Each site receives through its own channel, messages
+        // are told apart by their tag.
+        template <typename Data>
+        class collective_channels
+        {
+        public:
+            collective_channels(std::string const& basename,
+                    std::size_t num_sites, std::size_t this_site)
+              : basename_(generate_collective_name(basename))
+              , receive_(hpx::find_here())
+              , send_(num_sites)
+            {
+                receive_.register_as(channel_name(this_site)).get();
+            }
+
+            // connect to the channel of the given site, this has to be done
+            // before sending data to it
+            void connect(std::size_t site)
+            {
+                send_[site].connect_to(channel_name(site));
+            }
+
+            void send(std::size_t site, Data&& data, std::size_t tag)
+            {
+                send_[site].set(hpx::launch::apply, std::move(data), tag);
+            }
+
+            hpx::future<Data> receive(std::size_t tag)
+            {
+                return receive_.get(hpx::launch::async, tag);
+            }
+
+        private:
+            std::string channel_name(std::size_t site) const
+            {
+                return basename_ + "/" + std::to_string(site);
+            }
+
+            std::string basename_;
+            hpx::lcos::channel<Data> receive_;
+            std::vector<hpx::lcos::channel<Data>> send_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // ring all_reduce on a flat vector
+        template <typename T, typename Op>
+        class ring_all_reduce
+          : public std::enable_shared_from_this<ring_all_reduce<T, Op>>
+        {
+            using vector_type = blaze::DynamicVector<T>;
+
+        public:
+            ring_all_reduce(std::string const& basename, vector_type&& data,
+                    Op const& op, std::size_t num_sites, std::size_t this_site)
+              : ring_all_reduce(basename, std::move(data),
+                    balanced_chunks(data.size(), num_sites), op, num_sites,
+                    this_site, false)
+            {
+            }
+
+            // If scatter is set, the all_gather phase is skipped and each
+            // site ends up with its own (fully reduced) chunk only.
+            ring_all_reduce(std::string const& basename, vector_type&& data,
+                    std::vector<std::size_t>&& chunk_starts, Op const& op,
+                    std::size_t num_sites, std::size_t this_site,
+                    bool scatter)
+              : data_(std::move(data))
+              , op_(op)
+              , num_sites_(num_sites)
+              , this_site_(this_site)
+              , channels_(basename, num_sites, this_site)
+              , chunk_starts_(std::move(chunk_starts))
+              , scatter_(scatter)
+              , shift_(scatter ? num_sites - 1 : 0)
+            {
+                HPX_ASSERT(chunk_starts_.size() == num_sites + 1);
+
+                // the chunks are sent in segments of (at most) the
+                // configured size
+                std::size_t chunk_size = 0;
+                for (std::size_t i = 0; i != num_sites; ++i)
+                {
+                    chunk_size = (std::max)(
+                        chunk_size, chunk_starts_[i + 1] - chunk_starts_[i]);
+                }
+                segment_size_ = (std::max)(
+                    collective_segment_size() / sizeof(T), std::size_t(1));
+                num_segments_ = (std::max)(
+                    (chunk_size + segment_size_ - 1) / segment_size_,
+                    std::size_t(1));
+
+                channels_.connect((this_site_ + 1) % num_sites_);
+            }
+
+            // balanced split of the data into one chunk per site
+            static std::vector<std::size_t> balanced_chunks(
+                std::size_t size, std::size_t num_sites)
+            {
+                std::vector<std::size_t> chunk_starts(num_sites + 1);
+                for (std::size_t i = 0; i <= num_sites; ++i)
+                {
+                    chunk_starts[i] = i * size / num_sites;
+                }
+                return chunk_starts;
+            }
+
+            hpx::future<vector_type> run()
+            {
+                std::vector<hpx::future<void>> segments;
+                segments.reserve(num_segments_);
+                for (std::size_t segment = 0; segment != num_segments_;
+                     ++segment)
+                {
+                    send(0, segment, (this_site_ + shift_) % num_sites_);
+                    segments.push_back(process(0, segment));
+                }
+
+                auto this_ = this->shared_from_this();
+                return hpx::when_all(std::move(segments))
+                    .then(hpx::launch::sync,
+                        [this_ = std::move(this_)](
+                            hpx::future<std::vector<hpx::future<void>>>&& f)
+                            -> vector_type {
+                            for (auto& segment : f.get())
+                            {
+                                segment.get();    // rethrow exceptions
+                            }
+
+                            if (this_->scatter_)
+                            {
+                                std::size_t const site = this_->this_site_;
+                                std::size_t const start =
+                                    this_->chunk_starts_[site];
+                                return vector_type(blaze::subvector(
+                                    this_->data_, start,
+                                    this_->chunk_starts_[site + 1] - start));
+                            }
+                            return std::move(this_->data_);
+                        });
+            }
+
+        private:
+            std::size_t steps() const
+            {
+                return scatter_ ? num_sites_ - 1 : 2 * (num_sites_ - 1);
+            }
+
+            // the part of the data that is represented by the given segment
+            // of the given chunk
+            auto segment_data(std::size_t chunk, std::size_t segment)
+            {
+                std::size_t const start = (std::min)(
+                    chunk_starts_[chunk] + segment * segment_size_,
+                    chunk_starts_[chunk + 1]);
+                std::size_t const stop = (std::min)(
+                    start + segment_size_, chunk_starts_[chunk + 1]);
+                return blaze::subvector(data_, start, stop - start);
+            }
+
+            void send(std::size_t step, std::size_t segment, std::size_t chunk)
+            {
+                channels_.send((this_site_ + 1) % num_sites_,
+                    vector_type(segment_data(chunk, segment)),
+                    step * num_segments_ + segment + 1);
+            }
+
+            // Each segment is forwarded along the ring 2 * (num_sites - 1)
+            // times. In the first half of the steps the received segment is
+            // combined with the local one, after that the received segment
+            // is fully reduced and replaces the local one. The segment
+            // received in a step is sent in the next step. The chunks are
+            // shifted for reduce-scatter such that each site ends up with
+            // its own chunk being fully reduced.
+            hpx::future<void> process(std::size_t step, std::size_t segment)
+            {
+                auto this_ = this->shared_from_this();
+                return channels_.receive(step * num_segments_ + segment + 1)
+                    .then(hpx::launch::sync,
+                        [this_ = std::move(this_), step, segment](
+                            hpx::future<vector_type>&& f) -> hpx::future<void> {
+                            vector_type data = f.get();
+
+                            std::size_t const n = this_->num_sites_;
+                            std::size_t const site =
+                                this_->this_site_ + this_->shift_;
+                            std::size_t chunk = 0;
+                            if (step < n - 1)
+                            {
+                                // reduce-scatter
+                                chunk = (site + 2 * n - step - 1) % n;
+                                auto local =
+                                    this_->segment_data(chunk, segment);
+                                local = this_->op_(local, data);
+                            }
+                            else
+                            {
+                                // all_gather
+                                chunk = (site + 2 * n - (step - n + 1)) % n;
+                                auto local =
+                                    this_->segment_data(chunk, segment);
+                                local = data;
+                            }
+
+                            if (step + 1 == this_->steps())
+                            {
+                                return hpx::make_ready_future();
+                            }
+
+                            this_->send(step + 1, segment, chunk);
+                            return this_->process(step + 1, segment);
+                        });
+            }
+
+            vector_type data_;
+            Op op_;
+            std::size_t num_sites_;
+            std::size_t this_site_;
+            collective_channels<vector_type> channels_;
+            std::vector<std::size_t> chunk_starts_;
+            bool scatter_;
+            std::size_t shift_;
+            std::size_t segment_size_;
+            std::size_t num_segments_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // tree all_reduce on a flat vector
+        template <typename T, typename Op>
+        class tree_all_reduce
+          : public std::enable_shared_from_this<tree_all_reduce<T, Op>>
+        {
+            using vector_type = blaze::DynamicVector<T>;
+
+        public:
+            tree_all_reduce(std::string const& basename, vector_type&& data,
+                    Op const& op, std::size_t num_sites, std::size_t this_site)
+              : data_(std::move(data))
+              , op_(op)
+              , num_sites_(num_sites)
+              , this_site_(this_site)
+              , channels_(basename, num_sites, this_site)
+            {
+            }
+
+            hpx::future<vector_type> run()
+            {
+                auto this_ = this->shared_from_this();
+                hpx::future<void> f = hpx::make_ready_future();
+
+                // reduce: in round r the sites with bit r set send their
+                // (partially reduced) data to the site with that bit cleared
+                std::size_t mask = 1;
+                std::size_t round = 1;
+                for (/**/; mask < num_sites_; mask <<= 1, ++round)
+                {
+                    if ((this_site_ & mask) != 0)
+                    {
+                        break;
+                    }
+                    if (this_site_ + mask < num_sites_)
+                    {
+                        f = f.then(hpx::launch::sync,
+                            [this_, round](hpx::future<void>&& f) {
+                                f.get();
+                                return this_->channels_.receive(round);
+                            })
+                                .then(hpx::launch::sync,
+                                    [this_](hpx::future<vector_type>&& f) {
+                                        this_->data_ =
+                                            this_->op_(this_->data_, f.get());
+                                    });
+                    }
+                }
+
+                // the broadcast messages are tagged past all reduce rounds
+                std::size_t broadcast = round;
+                for (std::size_t m = mask; m < num_sites_; m <<= 1)
+                {
+                    ++broadcast;
+                }
+
+                if (this_site_ != 0)
+                {
+                    std::size_t const parent = this_site_ - mask;
+                    channels_.connect(parent);
+                    f = f.then(hpx::launch::sync,
+                        [this_, parent, round, broadcast](
+                            hpx::future<void>&& f) {
+                            f.get();
+                            this_->channels_.send(
+                                parent, vector_type(this_->data_), round);
+                            return this_->channels_.receive(broadcast);
+                        })
+                            .then(hpx::launch::sync,
+                                [this_](hpx::future<vector_type>&& f) {
+                                    this_->data_ = f.get();
+                                });
+                }
+
+                // broadcast: send the result to the sites this site has
+                // received data from
+                std::vector<std::size_t> children;
+                for (std::size_t m = mask >> 1; m != 0; m >>= 1)
+                {
+                    if (this_site_ + m < num_sites_)
+                    {
+                        children.push_back(this_site_ + m);
+                        channels_.connect(this_site_ + m);
+                    }
+                }
+
+                return f.then(hpx::launch::sync,
+                    [this_ = std::move(this_), children = std::move(children),
+                        broadcast](hpx::future<void>&& f) -> vector_type {
+                        f.get();
+                        for (std::size_t child : children)
+                        {
+                            this_->channels_.send(
+                                child, vector_type(this_->data_), broadcast);
+                        }
+                        return std::move(this_->data_);
+                    });
+            }
+
+        private:
+            vector_type data_;
+            Op op_;
+            std::size_t num_sites_;
+            std::size_t this_site_;
+            collective_channels<vector_type> channels_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename Op>
+        hpx::future<blaze::DynamicVector<T>> all_reduce_flat(
+            collective_algorithm algorithm, std::string const& basename,
+            blaze::DynamicVector<T>&& data, Op const& op,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            if (algorithm == collective_algorithm::ring)
+            {
+                return std::make_shared<ring_all_reduce<T, Op>>(basename,
+                    std::move(data), op, num_sites, this_site)
+                    ->run();
+            }
+            return std::make_shared<tree_all_reduce<T, Op>>(
+                basename, std::move(data), op, num_sites, this_site)
+                ->run();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        std::size_t payload_size(T const&)
+        {
+            return sizeof(T);
+        }
+
+        template <typename T>
+        std::size_t payload_size(blaze::DynamicVector<T> const& v)
+        {
+            return v.size() * sizeof(T);
+        }
+
+        template <typename T>
+        std::size_t payload_size(blaze::DynamicMatrix<T> const& m)
+        {
+            return m.rows() * m.columns() * sizeof(T);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Data, typename Op>
+        hpx::future<Data> all_reduce(collective_algorithm,
+            std::string const& basename, Data&& data, Op const& op,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            return hpx::all_reduce(basename.c_str(), std::move(data), op,
+                num_sites, std::size_t(-1), this_site);
+        }
+
+        template <typename T, typename Op>
+        hpx::future<blaze::DynamicVector<T>> all_reduce(
+            collective_algorithm algorithm, std::string const& basename,
+            blaze::DynamicVector<T>&& data, Op const& op,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            if (algorithm == collective_algorithm::direct)
+            {
+                return hpx::all_reduce(basename.c_str(), std::move(data), op,
+                    num_sites, std::size_t(-1), this_site);
+            }
+            return all_reduce_flat(algorithm, basename, std::move(data), op,
+                num_sites, this_site);
+        }
+
+        template <typename T, typename Op>
+        hpx::future<blaze::DynamicMatrix<T>> all_reduce(
+            collective_algorithm algorithm, std::string const& basename,
+            blaze::DynamicMatrix<T>&& data, Op const& op,
+            std::size_t num_sites, std::size_t this_site)
+        {
+            if (algorithm == collective_algorithm::direct)
+            {
+                return hpx::all_reduce(basename.c_str(), std::move(data), op,
+                    num_sites, std::size_t(-1), this_site);
+            }
+
+            // the rows of the matrix are reduced as one contiguous vector
+            std::size_t const rows = data.rows();
+            std::size_t const columns = data.columns();
+
+            blaze::DynamicVector<T> flat(rows * columns);
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded>(
+                flat.data(), rows, columns) = data;
+
+            return all_reduce_flat(algorithm, basename, std::move(flat), op,
+                num_sites, this_site)
+                .then(hpx::launch::sync,
+                    [rows, columns](hpx::future<blaze::DynamicVector<T>>&& f)
+                        -> blaze::DynamicMatrix<T> {
+                        blaze::DynamicVector<T> flat = f.get();
+                        return blaze::DynamicMatrix<T>(
+                            blaze::CustomMatrix<T, blaze::unaligned,
+                                blaze::unpadded>(flat.data(), rows, columns));
+                    });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Combine the given data of all sites using the given binary operation,
+    // all sites receive the combined result.
+    template <typename Data, typename Op>
+    hpx::future<typename std::decay<Data>::type> all_reduce(
+        std::string const& basename, Data&& data, Op const& op,
+        std::size_t num_sites, std::size_t this_site)
+    {
+        using data_type = typename std::decay<Data>::type;
+
+        data_type local(std::forward<Data>(data));
+        collective_algorithm algorithm = select_collective_algorithm(
+            detail::payload_size(local), num_sites);
+
+        return detail::all_reduce(algorithm, basename, std::move(local), op,
+            num_sites, this_site);
+    }
+
+    // Combine the given data of all sites using the given binary operation,
+    // each site receives the part of the combined result described by its
+    // chunk only, i.e. the elements [chunk_starts[this_site],
+    // chunk_starts[this_site + 1]). This always uses the ring algorithm as
+    // no site has to hold the complete result.
+    template <typename T, typename Op>
+    hpx::future<blaze::DynamicVector<T>> reduce_scatter(
+        std::string const& basename, blaze::DynamicVector<T>&& data,
+        std::vector<std::size_t>&& chunk_starts, Op const& op,
+        std::size_t num_sites, std::size_t this_site)
+    {
+        if (num_sites < 2)
+        {
+            return hpx::make_ready_future(std::move(data));
+        }
+
+        return std::make_shared<detail::ring_all_reduce<T, Op>>(basename,
+            std::move(data), std::move(chunk_starts), op, num_sites, this_site,
+            true)
+            ->run();
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+// channels used by the collective operations
+namespace phylanx { namespace util { namespace detail
+{
+    using collective_vector_double = blaze::DynamicVector<double>;
+    using collective_vector_int64 = blaze::DynamicVector<std::int64_t>;
+    using collective_vector_uint8 = blaze::DynamicVector<std::uint8_t>;
+
+    using collective_matrix_double = blaze::DynamicMatrix<double>;
+    using collective_matrix_int64 = blaze::DynamicMatrix<std::int64_t>;
+    using collective_matrix_uint8 = blaze::DynamicMatrix<std::uint8_t>;
+}}}
+
+HPX_REGISTER_CHANNEL_DECLARATION(
+    phylanx::util::detail::collective_vector_double,
+    phylanx_collective_vector_double);
+HPX_REGISTER_CHANNEL_DECLARATION(
+    phylanx::util::detail::collective_vector_int64,
+    phylanx_collective_vector_int64);
+HPX_REGISTER_CHANNEL_DECLARATION(
+    phylanx::util::detail::collective_vector_uint8,
+    phylanx_collective_vector_uint8);
+
+HPX_REGISTER_CHANNEL_DECLARATION(
+    phylanx::util::detail::collective_matrix_double,
+    phylanx_collective_matrix_double);
+HPX_REGISTER_CHANNEL_DECLARATION(
+    phylanx::util::detail::collective_matrix_int64,
+    phylanx_collective_matrix_int64);
+HPX_REGISTER_CHANNEL_DECLARATION(
+    phylanx::util::detail::collective_matrix_uint8,
+    phylanx_collective_matrix_uint8);
+
+#endif
@@ -0,0 +1,139 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_COMPRESSION_HPP)
+#define PHYLANX_UTIL_COMPRESSION_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/assert.hpp>
+#include <hpx/serialization/array.hpp>
+#include <hpx/serialization/serialize.hpp>
+#include <hpx/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Optional compression of the tiles exchanged between the parts of the
+// distributed data structures (distributed_vector, distributed_matrix, and
+// distributed_tensor).
+//
+// The elements are byte-shuffled (all first bytes of the elements, followed
+// by all second bytes, etc.) before being compressed using a simple LZ77
+// style codec. This turns data with few distinct values (sparse data,
+// repeated values, small integers) into long runs of identical bytes.
+//
+// Compression is disabled by default. It is enabled by setting
+// phylanx.compression=1, in which case all tiles of at least
+// phylanx.compression.threshold bytes (default: 64kB) are compressed. A tile
+// is sent uncompressed if compressing it does not reduce its size.
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Return whether a payload of the given size should be compressed
+    PHYLANX_EXPORT bool use_compression(std::size_t bytes);
+
+    // Compress the given elements of the given size, return an empty buffer
+    // if compressing does not reduce the size of the data
+    PHYLANX_EXPORT std::vector<char> compress(
+        char const* data, std::size_t size, std::size_t element_size);
+
+    // Decompress the given data into a buffer of the given size (which has
+    // to be the size of the original data)
+    PHYLANX_EXPORT void decompress(char const* data, std::size_t size,
+        char* target, std::size_t target_size, std::size_t element_size);
+
+    // Number of bytes of all compressed tiles before and after compression
+    PHYLANX_EXPORT std::int64_t compression_bytes_uncompressed(bool reset);
+    PHYLANX_EXPORT std::int64_t compression_bytes_compressed(bool reset);
+
+    namespace detail
+    {
+        PHYLANX_EXPORT void count_compressed_bytes(
+            std::size_t uncompressed, std::size_t compressed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Serialize a (strided) block of row-major elements, the dimensions of
+    // the block have to be serialized separately
+    template <typename T>
+    void save_block(hpx::serialization::output_archive& ar, T const* data,
+        std::size_t rows, std::size_t columns, std::size_t spacing)
+    {
+        std::size_t const bytes = rows * columns * sizeof(T);
+
+        // the size of the data is estimated only while preprocessing
+        std::vector<char> compressed;
+        if (!ar.is_preprocessing() && use_compression(bytes))
+        {
+            std::vector<char> buffer(bytes);
+            T* p = reinterpret_cast<T*>(buffer.data());
+            for (std::size_t i = 0; i != rows; ++i)
+            {
+                p = std::copy_n(data + i * spacing, columns, p);
+            }
+            compressed = compress(buffer.data(), bytes, sizeof(T));
+        }
+
+        bool const is_compressed = !compressed.empty();
+        ar << is_compressed;
+
+        if (is_compressed)
+        {
+            ar << compressed;
+            detail::count_compressed_bytes(bytes, compressed.size());
+            return;
+        }
+
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            ar << hpx::serialization::make_array(data + i * spacing, columns);
+        }
+    }
+
+    template <typename T>
+    void load_block(hpx::serialization::input_archive& ar, T* data,
+        std::size_t rows, std::size_t columns, std::size_t spacing)
+    {
+        bool is_compressed = false;
+        ar >> is_compressed;
+
+        if (is_compressed)
+        {
+            std::vector<char> compressed;
+            ar >> compressed;
+
+            std::size_t const bytes = rows * columns * sizeof(T);
+            if (spacing == columns)
+            {
+                decompress(compressed.data(), compressed.size(),
+                    reinterpret_cast<char*>(data), bytes, sizeof(T));
+                return;
+            }
+
+            std::vector<char> buffer(bytes);
+            decompress(compressed.data(), compressed.size(), buffer.data(),
+                bytes, sizeof(T));
+
+            T const* p = reinterpret_cast<T const*>(buffer.data());
+            for (std::size_t i = 0; i != rows; ++i)
+            {
+                std::copy_n(p + i * columns, columns, data + i * spacing);
+            }
+            return;
+        }
+
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            ar >> hpx::serialization::make_array(data + i * spacing, columns);
+        }
+    }
+}}
+
+#endif
@@ -8,6 +8,7 @@
 #define PHYLANX_UTIL_DISTRIBUTED_MATRIX_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/compression.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 
 #include <hpx/actions_base/component_action.hpp>
@@ -20,22 +21,187 @@
 #include <hpx/preprocessor/cat.hpp>
 #include <hpx/runtime.hpp>
 #include <hpx/runtime_local/get_locality_id.hpp>
+#include <hpx/serialization/array.hpp>
+#include <hpx/serialization/serialize.hpp>
 #include <hpx/synchronization/spinlock.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <blaze/Math.h>
 
 /// \cond NOINTERNAL
+namespace phylanx { namespace util {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Number of fetches of matrix parts that were (not) satisfied by a part
+    // prefetched earlier, only distributed_matrix instances which have
+    // prefetched parts are taken into account
+    PHYLANX_EXPORT std::int64_t prefetch_cache_hits(bool reset);
+    PHYLANX_EXPORT std::int64_t prefetch_cache_misses(bool reset);
+
+    namespace detail
+    {
+        PHYLANX_EXPORT void count_prefetch_cache_access(bool hit);
+
+        // Maximal number of prefetched parts kept by each distributed_matrix
+        PHYLANX_EXPORT std::size_t prefetch_cache_capacity();
+
+        // The target blocks of pending fetches. A fetch registers its target
+        // and sends the returned handle along with its request. The response
+        // looks up the target by that handle while it is deserialized. The
+        // target is unregistered once the fetch has completed, a response
+        // for a target that is no longer registered is not received into it.
+        PHYLANX_EXPORT std::uint64_t register_fetch_target(
+            std::shared_ptr<void> target);
+        PHYLANX_EXPORT std::shared_ptr<void> find_fetch_target(
+            std::uint64_t handle);
+        PHYLANX_EXPORT void unregister_fetch_target(std::uint64_t handle);
+    }
+}}
+
 namespace phylanx { namespace util { namespace server {
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Describes a (strided) rectangular block of row-major matrix elements
+    template <typename T>
+    struct matrix_block
+    {
+        T* data_;
+        std::size_t rows_;
+        std::size_t columns_;
+        std::size_t spacing_;
+    };
+
+    // A part of a matrix as returned by distributed_matrix_part::fetch_part.
+    // On the sending side the part holds a copy of the requested elements,
+    // which is created while the action is executed. The response is
+    // serialized only after the action has returned, at which point the
+    // source matrix may have been modified or released already. On the
+    // receiving side the rows are unpacked either directly into the target
+    // block the part was requested for or into a newly allocated matrix.
+    // Large parts are compressed, if enabled (see compression.hpp).
+    template <typename T>
+    class matrix_part
+    {
+    public:
+        using data_type = blaze::DynamicMatrix<T>;
+
+        matrix_part() = default;
+
+        template <typename Source>
+        matrix_part(Source const& source, std::uint64_t target)
+          : data_(source)
+          , target_(target)
+          , rows_(source.rows())
+          , columns_(source.columns())
+          , received_(false)
+        {
+        }
+
+        matrix_part(data_type&& source, std::uint64_t target)
+          : data_(std::move(source))
+          , target_(target)
+          , rows_(data_.rows())
+          , columns_(data_.columns())
+          , received_(false)
+        {
+        }
+
+        std::size_t rows() const
+        {
+            return rows_;
+        }
+        std::size_t columns() const
+        {
+            return columns_;
+        }
+
+        // Copy the elements into the given block unless they were received
+        // into it already
+        void extract(matrix_block<T> const& target) const
+        {
+            if (received_)
+            {
+                return;
+            }
+            for (std::size_t i = 0; i != rows_; ++i)
+            {
+                std::copy_n(data_.data() + i * data_.spacing(), columns_,
+                    target.data_ + i * target.spacing_);
+            }
+        }
+
+        // Return the elements as a matrix, the part must not have been
+        // received into a target block
+        data_type extract()
+        {
+            HPX_ASSERT(!received_);
+            return std::move(data_);
+        }
+
+    private:
+        friend class hpx::serialization::access;
+
+        void save(hpx::serialization::output_archive& ar, unsigned) const
+        {
+            ar << target_ << rows_ << columns_;
+            save_block(ar, data_.data(), rows_, columns_, data_.spacing());
+        }
+
+        void load(hpx::serialization::input_archive& ar, unsigned)
+        {
+            ar >> target_ >> rows_ >> columns_;
+
+            // the target is registered by the fetch that requested this part
+            // on the receiving locality until that fetch has completed, the
+            // requester guarantees that the target is alive until then
+            std::shared_ptr<matrix_block<T>> target;
+            if (target_ != 0)
+            {
+                target = std::static_pointer_cast<matrix_block<T>>(
+                    detail::find_fetch_target(target_));
+            }
+
+            if (!target)
+            {
+                data_.resize(rows_, columns_, false);
+                load_block(ar, data_.data(), rows_, columns_, data_.spacing());
+                received_ = false;
+                return;
+            }
+
+            if (target->rows_ != rows_ || target->columns_ != columns_)
+            {
+                HPX_THROW_EXCEPTION(hpx::invalid_data,
+                    "phylanx::util::server::matrix_part::load",
+                    "the size of the received matrix part does not match "
+                    "the size of its target");
+            }
+
+            load_block(ar, target->data_, rows_, columns_, target->spacing_);
+            received_ = true;
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER();
+
+        data_type data_;
+        std::uint64_t target_ = 0;
+        std::size_t rows_ = 0;
+        std::size_t columns_ = 0;
+        bool received_ = false;
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     template <typename T>
     class distributed_matrix_part
@@ -78,18 +244,21 @@ namespace phylanx { namespace util { namespace server {
             return &data_;
         }
 
-        data_type fetch() const
+        matrix_part<T> fetch() const
         {
-            return data_;
+            return matrix_part<T>(data_, 0);
         }
 
         HPX_DEFINE_COMPONENT_ACTION(distributed_matrix_part, fetch);
 
-        data_type fetch_part(std::size_t start_row, std::size_t start_column,
-            std::size_t stop_row, std::size_t stop_column) const
+        matrix_part<T> fetch_part(std::size_t start_row,
+            std::size_t start_column, std::size_t stop_row,
+            std::size_t stop_column, std::uint64_t target) const
         {
-            return data_type{blaze::submatrix(data_, start_row, start_column,
-                stop_row - start_row, stop_column - start_column)};
+            return matrix_part<T>(
+                blaze::submatrix(data_, start_row, start_column,
+                    stop_row - start_row, stop_column - start_column),
+                target);
         }
 
         HPX_DEFINE_COMPONENT_ACTION(distributed_matrix_part, fetch_part);
@@ -227,6 +396,15 @@ namespace phylanx { namespace util {
         /// the symbolic name
         ~distributed_matrix()
         {
+            // the pending transfers refer to this object
+            for (auto& p : cache_)
+            {
+                p.second.wait();
+            }
+            for (auto& f : evicted_)
+            {
+                f.wait();
+            }
             hpx::unregister_with_basename(basename_, this_site_).get();
         }
 
@@ -271,27 +449,15 @@ namespace phylanx { namespace util {
             using action_type =
                 typename server::distributed_matrix_part<T>::fetch_action;
 
-            auto f = hpx::async<action_type>(get_part_id(idx));
-
-            // keep track of number of transferred bytes, if needed
-            if (transferred_bytes_ != nullptr)
-            {
-                auto shared_state = hpx::traits::detail::get_shared_state(f);
-                shared_state->set_on_completed([this, shared_state]() -> void {
-                    data_type* r = shared_state->get_result();
-                    if (r != nullptr)
+            return hpx::async<action_type>(get_part_id(idx))
+                .then(hpx::launch::sync,
+                    [this](hpx::future<server::matrix_part<T>>&& f)
+                    -> data_type
                     {
-                        using spinlock_pool =
-                            hpx::util::spinlock_pool<std::uint64_t>;
-
-                        std::lock_guard<hpx::util::detail::spinlock> l(
-                            spinlock_pool::spinlock_for(transferred_bytes_));
-
-                        *transferred_bytes_ += r->capacity() * sizeof(T);
-                    }
-                });
-            }
-            return f;
+                        data_type result = f.get().extract();
+                        add_transferred_bytes(result.capacity() * sizeof(T));
+                        return result;
+                    });
             /// \endcond
         }
 
@@ -306,38 +472,247 @@ namespace phylanx { namespace util {
         hpx::future<data_type> fetch(std::size_t idx, std::size_t start_row,
             std::size_t start_column, std::size_t stop_row,
             std::size_t stop_column) const
+        {
+            /// \cond NOINTERNAL
+            hpx::future<data_type> f;
+            if (extract_prefetched(
+                    {idx, start_row, start_column, stop_row, stop_column}, f))
+            {
+                return f;
+            }
+            return fetch_part(
+                idx, start_row, start_column, stop_row, stop_column);
+            /// \endcond
+        }
+
+        /// fetch() function is an asynchronous function. This copies (part
+        /// of) the instance of this distributed_matrix associated with the
+        /// given locality index into the given target matrix (which is
+        /// usually a submatrix of a larger matrix). The data is received
+        /// directly into the target without creating an intermediate copy.
+        /// The target (i.e. the memory it refers to) has to be kept alive
+        /// until the returned future has become ready, the future has to be
+        /// waited for before the target is released.
+        template <typename Target>
+        hpx::future<void> fetch(std::size_t idx, std::size_t start_row,
+            std::size_t start_column, std::size_t stop_row,
+            std::size_t stop_column, Target& target) const
         {
             /// \cond NOINTERNAL
             using action_type =
                 typename server::distributed_matrix_part<T>::fetch_part_action;
 
-            auto f = hpx::async<action_type>(get_part_id(idx), start_row,
-                start_column, stop_row, stop_column);
+            if (target.rows() != stop_row - start_row ||
+                target.columns() != stop_column - start_column)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "distributed_matrix::fetch",
+                    "the size of the target does not match the size of the "
+                    "requested part");
+            }
 
-            // keep track of number of transferred bytes, if needed
-            if (transferred_bytes_ != nullptr)
+            auto block = std::make_shared<server::matrix_block<T>>(
+                server::matrix_block<T>{target.data(), target.rows(),
+                    target.columns(), target.spacing()});
+
+            hpx::future<data_type> prefetched;
+            if (extract_prefetched(
+                    {idx, start_row, start_column, stop_row, stop_column},
+                    prefetched))
             {
-                auto shared_state = hpx::traits::detail::get_shared_state(f);
-                shared_state->set_on_completed([this, shared_state]() -> void {
-                    data_type* r = shared_state->get_result();
-                    if (r != nullptr)
+                return prefetched.then(hpx::launch::sync,
+                    [block = std::move(block)](
+                        hpx::future<data_type>&& f) -> void
+                    {
+                        server::matrix_part<T>(f.get(), 0).extract(*block);
+                    });
+            }
+            std::uint64_t const handle = detail::register_fetch_target(block);
+
+            return hpx::async<action_type>(get_part_id(idx), start_row,
+                start_column, stop_row, stop_column, handle)
+                .then(hpx::launch::sync,
+                    [this, handle, block = std::move(block)](
+                        hpx::future<server::matrix_part<T>>&& f) -> void
                     {
-                        using spinlock_pool =
-                            hpx::util::spinlock_pool<std::uint64_t>;
+                        detail::unregister_fetch_target(handle);
 
-                        std::lock_guard<hpx::util::detail::spinlock> l(
-                            spinlock_pool::spinlock_for(transferred_bytes_));
+                        server::matrix_part<T> part = f.get();
+                        part.extract(*block);
+                        add_transferred_bytes(
+                            part.rows() * part.columns() * sizeof(T));
+                    });
+            /// \endcond
+        }
+
+        /// prefetch() function is an asynchronous function. This starts
+        /// the transfer of (part of) the instance of this distributed_matrix
+        /// associated with the given locality index into a local cache. A
+        /// later fetch() of the same part is satisfied from the cache, which
+        /// allows to overlap the communication for the next step of an
+        /// algorithm with the computation of the current one. The cache holds
+        /// at most phylanx.distributed_matrix.prefetch_cache_size parts
+        /// (default: 16), the part prefetched first is evicted once the cache
+        /// is full. Note that the cached parts are not updated if the
+        /// remote data is modified after the transfer was started.
+        void prefetch(std::size_t idx, std::size_t start_row,
+            std::size_t start_column, std::size_t stop_row,
+            std::size_t stop_column) const
+        {
+            /// \cond NOINTERNAL
+            resolve_part_ids();
+
+            cache_key key{idx, start_row, start_column, stop_row, stop_column};
+            {
+                std::lock_guard<hpx::lcos::local::spinlock> l(cache_mtx_);
+                if (cache_.find(key) != cache_.end())
+                {
+                    return;
+                }
+            }
+
+            hpx::future<data_type> f =
+                fetch_part(idx, start_row, start_column, stop_row, stop_column);
+
+            std::lock_guard<hpx::lcos::local::spinlock> l(cache_mtx_);
+            prefetching_ = true;
+            if (cache_.find(key) != cache_.end())
+            {
+                evict(std::move(f));    // prefetched concurrently
+                return;
+            }
+            cache_.emplace(key, std::move(f));
+            cache_order_.push_back(key);
 
-                        *transferred_bytes_ += r->capacity() * sizeof(T);
+            std::size_t const capacity = detail::prefetch_cache_capacity();
+            while (cache_order_.size() > capacity)
+            {
+                auto it = cache_.find(cache_order_.front());
+                cache_order_.pop_front();
+                if (it != cache_.end())
+                {
+                    evict(std::move(it->second));
+                    cache_.erase(it);
+                }
+            }
+            /// \endcond
+        }
+
+        /// Start resolving the ids of the parts of this distributed_matrix on
+        /// all localities without waiting for the operation to complete.
+        /// This is done implicitly by the first call to prefetch().
+        void resolve_part_ids() const
+        {
+            /// \cond NOINTERNAL
+            std::vector<std::size_t> indices;
+            {
+                std::lock_guard<hpx::lcos::local::spinlock> l(part_ids_mtx_);
+                if (resolving_part_ids_)
+                {
+                    return;
+                }
+                resolving_part_ids_ = true;
+
+                for (std::size_t idx = 0; idx != num_sites_; ++idx)
+                {
+                    if (part_ids_.find(idx) == part_ids_.end())
+                    {
+                        indices.push_back(idx);
                     }
-                });
+                }
+            }
+
+            std::map<std::size_t, hpx::shared_future<hpx::id_type>> resolving;
+            for (std::size_t idx : indices)
+            {
+                resolving.emplace(idx,
+                    hpx::agas::on_symbol_namespace_event(
+                        hpx::detail::name_from_basename(basename_, idx), true));
             }
-            return f;
+
+            std::lock_guard<hpx::lcos::local::spinlock> l(part_ids_mtx_);
+            pending_part_ids_.insert(resolving.begin(), resolving.end());
             /// \endcond
         }
 
     private:
         /// \cond NOINTERNAL
+        using cache_key = std::array<std::size_t, 5>;
+
+        hpx::future<data_type> fetch_part(std::size_t idx,
+            std::size_t start_row, std::size_t start_column,
+            std::size_t stop_row, std::size_t stop_column) const
+        {
+            using action_type =
+                typename server::distributed_matrix_part<T>::fetch_part_action;
+
+            return hpx::async<action_type>(get_part_id(idx), start_row,
+                start_column, stop_row, stop_column, std::uint64_t(0))
+                .then(hpx::launch::sync,
+                    [this](hpx::future<server::matrix_part<T>>&& f)
+                    -> data_type
+                    {
+                        data_type result = f.get().extract();
+                        add_transferred_bytes(result.capacity() * sizeof(T));
+                        return result;
+                    });
+        }
+
+        // Remove the given part from the cache, if it was prefetched. The
+        // accesses are counted only if prefetch() was used before.
+        bool extract_prefetched(
+            cache_key const& key, hpx::future<data_type>& f) const
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(cache_mtx_);
+            if (!prefetching_)
+            {
+                return false;
+            }
+
+            auto it = cache_.find(key);
+            if (it == cache_.end())
+            {
+                detail::count_prefetch_cache_access(false);
+                return false;
+            }
+
+            detail::count_prefetch_cache_access(true);
+            f = std::move(it->second);
+            cache_.erase(it);
+            cache_order_.remove(key);
+            return true;
+        }
+
+        // The transfers of evicted parts still refer to this object, thus
+        // they are kept until they have finished
+        void evict(hpx::future<data_type>&& f) const
+        {
+            evicted_.erase(std::remove_if(evicted_.begin(), evicted_.end(),
+                               [](hpx::future<data_type> const& pending) {
+                                   return pending.is_ready();
+                               }),
+                evicted_.end());
+
+            if (!f.is_ready())
+            {
+                evicted_.push_back(std::move(f));
+            }
+        }
+
+        // keep track of number of transferred bytes, if needed
+        void add_transferred_bytes(std::size_t bytes) const
+        {
+            if (transferred_bytes_ != nullptr)
+            {
+                using spinlock_pool = hpx::util::spinlock_pool<std::uint64_t>;
+
+                std::lock_guard<hpx::util::detail::spinlock> l(
+                    spinlock_pool::spinlock_for(transferred_bytes_));
+
+                *transferred_bytes_ += bytes;
+            }
+        }
+
         template <typename Arg>
         hpx::id_type create_and_register_server(Arg&& value)
         {
@@ -377,13 +752,29 @@ namespace phylanx { namespace util {
             {
                 hpx::id_type id;
 
+                // use the id resolved by resolve_part_ids(), if available
+                hpx::shared_future<hpx::id_type> pending;
+                auto pit = pending_part_ids_.find(idx);
+                if (pit != pending_part_ids_.end())
+                {
+                    pending = pit->second;
+                }
+
                 {
                     hpx::util::unlock_guard<hpx::lcos::local::spinlock> ul(
                         part_ids_mtx_);
 
-                    id = hpx::agas::on_symbol_namespace_event(
-                        hpx::detail::name_from_basename(basename_, idx), true)
-                             .get();
+                    if (pending.valid())
+                    {
+                        id = pending.get();
+                    }
+                    else
+                    {
+                        id = hpx::agas::on_symbol_namespace_event(
+                            hpx::detail::name_from_basename(basename_, idx),
+                            true)
+                                 .get();
+                    }
                 }
 
                 it = part_ids_.find(idx);
@@ -403,6 +794,15 @@ namespace phylanx { namespace util {
 
         mutable hpx::lcos::local::spinlock part_ids_mtx_;
         mutable std::map<std::size_t, hpx::id_type> part_ids_;
+        mutable std::map<std::size_t, hpx::shared_future<hpx::id_type>>
+            pending_part_ids_;
+        mutable bool resolving_part_ids_ = false;
+
+        mutable hpx::lcos::local::spinlock cache_mtx_;
+        mutable std::map<cache_key, hpx::future<data_type>> cache_;
+        mutable std::list<cache_key> cache_order_;
+        mutable std::vector<hpx::future<data_type>> evicted_;
+        mutable bool prefetching_ = false;
 
         std::int64_t* transferred_bytes_;
         /// \endcond
@@ -9,6 +9,7 @@
 #define PHYLANX_UTIL_DISTRIBUTED_TENSOR_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/compression.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 
 #include <hpx/actions_base/component_action.hpp>
@@ -21,6 +22,7 @@
 #include <hpx/preprocessor/cat.hpp>
 #include <hpx/runtime.hpp>
 #include <hpx/runtime_local/get_locality_id.hpp>
+#include <hpx/serialization/serialize.hpp>
 #include <hpx/synchronization/spinlock.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
 
@@ -38,6 +40,52 @@
 /// \cond NOINTERNAL
 namespace phylanx { namespace util { namespace server {
 
+    ////////////////////////////////////////////////////////////////////////////
+    // A part of a tensor as returned by distributed_tensor_part::fetch and
+    // distributed_tensor_part::fetch_part. Large parts are compressed, if
+    // enabled (see compression.hpp).
+    template <typename T>
+    class tensor_part
+    {
+    public:
+        using data_type = blaze::DynamicTensor<T>;
+
+        tensor_part() = default;
+
+        explicit tensor_part(data_type&& data)
+          : data_(std::move(data))
+        {
+        }
+
+        data_type extract()
+        {
+            return std::move(data_);
+        }
+
+    private:
+        friend class hpx::serialization::access;
+
+        void save(hpx::serialization::output_archive& ar, unsigned) const
+        {
+            ar << data_.pages() << data_.rows() << data_.columns();
+            save_block(ar, data_.data(), data_.pages() * data_.rows(),
+                data_.columns(), data_.spacing());
+        }
+
+        void load(hpx::serialization::input_archive& ar, unsigned)
+        {
+            std::size_t pages = 0, rows = 0, columns = 0;
+            ar >> pages >> rows >> columns;
+            data_.resize(pages, rows, columns, false);
+            load_block(ar, data_.data(), pages * rows, columns,
+                data_.spacing());
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER();
+
+        data_type data_;
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     template <typename T>
     class distributed_tensor_part
@@ -80,20 +128,21 @@ namespace phylanx { namespace util { namespace server {
             return &data_;
         }
 
-        data_type fetch() const
+        tensor_part<T> fetch() const
         {
-            return data_;
+            return tensor_part<T>(data_type{data_});
         }
 
         HPX_DEFINE_COMPONENT_ACTION(distributed_tensor_part, fetch);
 
-        data_type fetch_part(std::size_t start_page, std::size_t start_row,
-            std::size_t start_column, std::size_t stop_page,
-            std::size_t stop_row, std::size_t stop_column) const
+        tensor_part<T> fetch_part(std::size_t start_page,
+            std::size_t start_row, std::size_t start_column,
+            std::size_t stop_page, std::size_t stop_row,
+            std::size_t stop_column) const
         {
-            return data_type{blaze::subtensor(data_, start_page, start_row,
-                start_column, stop_page - start_page, stop_row - start_row,
-                stop_column - start_column)};
+            return tensor_part<T>(data_type{blaze::subtensor(data_, start_page,
+                start_row, start_column, stop_page - start_page,
+                stop_row - start_row, stop_column - start_column)});
         }
 
         HPX_DEFINE_COMPONENT_ACTION(distributed_tensor_part, fetch_part);
@@ -275,27 +324,15 @@ namespace phylanx { namespace util {
             using action_type =
                 typename server::distributed_tensor_part<T>::fetch_action;
 
-            auto f = hpx::async<action_type>(get_part_id(idx));
-
-            // keep track of number of transferred bytes, if needed
-            if (transferred_bytes_ != nullptr)
-            {
-                auto shared_state = hpx::traits::detail::get_shared_state(f);
-                shared_state->set_on_completed([this, shared_state]() -> void {
-                    data_type* r = shared_state->get_result();
-                    if (r != nullptr)
+            return hpx::async<action_type>(get_part_id(idx))
+                .then(hpx::launch::sync,
+                    [this](hpx::future<server::tensor_part<T>>&& f)
+                    -> data_type
                     {
-                        using spinlock_pool =
-                            hpx::util::spinlock_pool<std::uint64_t>;
-
-                        std::lock_guard<hpx::util::detail::spinlock> l(
-                            spinlock_pool::spinlock_for(transferred_bytes_));
-
-                        *transferred_bytes_ += r->capacity() * sizeof(T);
-                    }
-                });
-            }
-            return f;
+                        data_type result = f.get().extract();
+                        add_transferred_bytes(result.capacity() * sizeof(T));
+                        return result;
+                    });
             /// \endcond
         }
 
@@ -316,33 +353,35 @@ namespace phylanx { namespace util {
             using action_type =
                 typename server::distributed_tensor_part<T>::fetch_part_action;
 
-            auto f = hpx::async<action_type>(get_part_id(idx), start_page,
-                start_row, start_column, stop_page, stop_row, stop_column);
+            return hpx::async<action_type>(get_part_id(idx), start_page,
+                start_row, start_column, stop_page, stop_row, stop_column)
+                .then(hpx::launch::sync,
+                    [this](hpx::future<server::tensor_part<T>>&& f)
+                    -> data_type
+                    {
+                        data_type result = f.get().extract();
+                        add_transferred_bytes(result.capacity() * sizeof(T));
+                        return result;
+                    });
+            /// \endcond
+        }
 
-            // keep track of number of transferred bytes, if needed
+    private:
+        /// \cond NOINTERNAL
+        // keep track of number of transferred bytes, if needed
+        void add_transferred_bytes(std::size_t bytes) const
+        {
             if (transferred_bytes_ != nullptr)
             {
-                auto shared_state = hpx::traits::detail::get_shared_state(f);
-                shared_state->set_on_completed([this, shared_state]() -> void {
-                    data_type* r = shared_state->get_result();
-                    if (r != nullptr)
-                    {
-                        using spinlock_pool =
-                            hpx::util::spinlock_pool<std::uint64_t>;
+                using spinlock_pool = hpx::util::spinlock_pool<std::uint64_t>;
 
-                        std::lock_guard<hpx::util::detail::spinlock> l(
-                            spinlock_pool::spinlock_for(transferred_bytes_));
+                std::lock_guard<hpx::util::detail::spinlock> l(
+                    spinlock_pool::spinlock_for(transferred_bytes_));
 
-                        *transferred_bytes_ += r->capacity() * sizeof(T);
-                    }
-                });
+                *transferred_bytes_ += bytes;
             }
-            return f;
-            /// \endcond
         }
 
-    private:
-        /// \cond NOINTERNAL
         template <typename Arg>
         hpx::id_type create_and_register_server(Arg&& value)
         {
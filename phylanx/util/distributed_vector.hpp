@@ -8,6 +8,7 @@
 #define PHYLANX_UTIL_DISTRIBUTED_VECTOR_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/compression.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 
 #include <hpx/actions_base/component_action.hpp>
@@ -20,6 +21,7 @@
 #include <hpx/preprocessor/cat.hpp>
 #include <hpx/runtime.hpp>
 #include <hpx/runtime_local/get_locality_id.hpp>
+#include <hpx/serialization/serialize.hpp>
 #include <hpx/synchronization/spinlock.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
 
@@ -35,6 +37,51 @@
 
 /// \cond NOINTERNAL
 namespace phylanx { namespace util { namespace server {
+    ////////////////////////////////////////////////////////////////////////////
+    // A part of a vector as returned by distributed_vector_part::fetch and
+    // distributed_vector_part::fetch_part. Large parts are compressed, if
+    // enabled (see compression.hpp).
+    template <typename T>
+    class vector_part
+    {
+    public:
+        using data_type = blaze::DynamicVector<T>;
+
+        vector_part() = default;
+
+        explicit vector_part(data_type&& data)
+          : data_(std::move(data))
+        {
+        }
+
+        data_type extract()
+        {
+            return std::move(data_);
+        }
+
+    private:
+        friend class hpx::serialization::access;
+
+        void save(hpx::serialization::output_archive& ar, unsigned) const
+        {
+            std::size_t const size = data_.size();
+            ar << size;
+            save_block(ar, data_.data(), 1, size, size);
+        }
+
+        void load(hpx::serialization::input_archive& ar, unsigned)
+        {
+            std::size_t size = 0;
+            ar >> size;
+            data_.resize(size, false);
+            load_block(ar, data_.data(), 1, size, size);
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER();
+
+        data_type data_;
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     template <typename T>
     class distributed_vector_part
@@ -77,16 +124,17 @@ namespace phylanx { namespace util { namespace server {
             return &data_;
         }
 
-        data_type fetch() const
+        vector_part<T> fetch() const
         {
-            return data_;
+            return vector_part<T>(data_type{data_});
         }
 
         HPX_DEFINE_COMPONENT_ACTION(distributed_vector_part, fetch);
 
-        data_type fetch_part(std::size_t start, std::size_t stop) const
+        vector_part<T> fetch_part(std::size_t start, std::size_t stop) const
         {
-            return data_type{blaze::subvector(data_, start, stop - start)};
+            return vector_part<T>(
+                data_type{blaze::subvector(data_, start, stop - start)});
         }
 
         HPX_DEFINE_COMPONENT_ACTION(distributed_vector_part, fetch_part);
@@ -268,27 +316,15 @@ namespace phylanx { namespace util {
             using action_type =
                 typename server::distributed_vector_part<T>::fetch_action;
 
-            auto f = hpx::async<action_type>(get_part_id(idx));
-
-            // keep track of number of transferred bytes, if needed
-            if (transferred_bytes_ != nullptr)
-            {
-                auto shared_state = hpx::traits::detail::get_shared_state(f);
-                shared_state->set_on_completed([this, shared_state]() -> void {
-                    data_type* r = shared_state->get_result();
-                    if (r != nullptr)
+            return hpx::async<action_type>(get_part_id(idx))
+                .then(hpx::launch::sync,
+                    [this](hpx::future<server::vector_part<T>>&& f)
+                    -> data_type
                     {
-                        using spinlock_pool =
-                            hpx::util::spinlock_pool<std::uint64_t>;
-
-                        std::lock_guard<hpx::util::detail::spinlock> l(
-                            spinlock_pool::spinlock_for(transferred_bytes_));
-
-                        *transferred_bytes_ += r->size() * sizeof(T);
-                    }
-                });
-            }
-            return f;
+                        data_type result = f.get().extract();
+                        add_transferred_bytes(result.size() * sizeof(T));
+                        return result;
+                    });
             /// \endcond
         }
 
@@ -307,32 +343,34 @@ namespace phylanx { namespace util {
             using action_type =
                 typename server::distributed_vector_part<T>::fetch_part_action;
 
-            auto f = hpx::async<action_type>(get_part_id(idx), start, stop);
+            return hpx::async<action_type>(get_part_id(idx), start, stop)
+                .then(hpx::launch::sync,
+                    [this](hpx::future<server::vector_part<T>>&& f)
+                    -> data_type
+                    {
+                        data_type result = f.get().extract();
+                        add_transferred_bytes(result.size() * sizeof(T));
+                        return result;
+                    });
+            /// \endcond
+        }
 
-            // keep track of number of transferred bytes, if needed
+    private:
+        /// \cond NOINTERNAL
+        // keep track of number of transferred bytes, if needed
+        void add_transferred_bytes(std::size_t bytes) const
+        {
             if (transferred_bytes_ != nullptr)
             {
-                auto shared_state = hpx::traits::detail::get_shared_state(f);
-                shared_state->set_on_completed([this, shared_state]() -> void {
-                    data_type* r = shared_state->get_result();
-                    if (r != nullptr)
-                    {
-                        using spinlock_pool =
-                            hpx::util::spinlock_pool<std::uint64_t>;
+                using spinlock_pool = hpx::util::spinlock_pool<std::uint64_t>;
 
-                        std::lock_guard<hpx::util::detail::spinlock> l(
-                            spinlock_pool::spinlock_for(transferred_bytes_));
+                std::lock_guard<hpx::util::detail::spinlock> l(
+                    spinlock_pool::spinlock_for(transferred_bytes_));
 
-                        *transferred_bytes_ += r->size() * sizeof(T);
-                    }
-                });
+                *transferred_bytes_ += bytes;
             }
-            return f;
-            /// \endcond
         }
 
-    private:
-        /// \cond NOINTERNAL
         template <typename Arg>
         hpx::id_type create_and_register_server(Arg&& value)
         {
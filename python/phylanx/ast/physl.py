@@ -608,6 +608,19 @@ class PhySL:
 
         return result
 
+    def async_call(self, *args, **kwargs):
+        """Invoke this Phylanx function asynchronously, pass along the given
+           arguments. Returns a concurrent.futures.Future that becomes ready
+           once the evaluation has finished. The arguments are copied, they
+           may be modified while the evaluation is running."""
+
+        self._ensure_global_state()
+        self._ensure_is_compiled()
+
+        return phylanx.execution_tree.async_eval(
+            PhySL.compiler_state, self.file_name,
+            self.wrapped_function.__name__, *args, **kwargs)
+
     def tree(self):
         """Return the tree data for this object"""
 
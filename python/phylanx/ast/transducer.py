@@ -9,6 +9,7 @@ import re
 import ast
 import inspect
 import types
+from concurrent import futures
 import phylanx
 from .physl import PhySL
 from .openscop import OpenSCoP
@@ -194,6 +195,29 @@ def Phylanx(__phylanx_arg=None, **kwargs):
 
             return result
 
+        def async_call(self, *args, **kwargs):
+            """Invoke this decorator asynchronously using the given arguments,
+               returns a concurrent.futures.Future"""
+
+            # just invoke original function if decorator should be disabled
+            if self.disable_decorator:
+                result = futures.Future()
+                try:
+                    result.set_result(
+                        self.decorated_function(*args, **kwargs))
+                except Exception as e:
+                    result.set_exception(e)
+                return result
+
+            if self.backend == 'OpenSCoP':
+                raise NotImplementedError(
+                    "OpenSCoP kernels are not yet callable.")
+
+            mapped_args = tuple(map(self.map_decorated, args))
+            kwitems = kwargs.items()
+            mapped_kwargs = {k: self.map_decorated(v) for k, v in kwitems}
+            return self.backend.async_call(*mapped_args, **mapped_kwargs)
+
         def generate_ast(self):
             return generate_phylanx_ast(self.__src__)
 
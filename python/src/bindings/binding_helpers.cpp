@@ -7,6 +7,8 @@
 
 #include <phylanx/phylanx.hpp>
 
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/run_as.hpp>
 #include <hpx/iostream.hpp>
 
 #include <bindings/binding_helpers.hpp>
@@ -18,9 +20,12 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iterator>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -95,82 +100,320 @@ namespace phylanx { namespace bindings
             });
     }
 
-    pybind11::object expression_evaluator(
-        compiler_state& state, std::string const& file_name,
-        std::string const& xexpr_str, pybind11::args args,
-        pybind11::kwargs kwargs)
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
     {
-        pybind11::gil_scoped_release release;       // release GIL
+        // compile the given expression, return the function to invoke
+        phylanx::execution_tree::compiler::function compile_evaluator(
+            compiler_state& state, std::string const& file_name,
+            std::string const& xexpr_str)
+        {
+            std::lock_guard<hpx::lcos::local::mutex> l(state.mtx_);
 
-        using phylanx::execution_tree::primitive_argument_type;
+            auto const& code_x = phylanx::execution_tree::compile(file_name,
+                xexpr_str, xexpr_str, state.eval_snippets, state.eval_env);
 
-        return hpx::threads::run_as_hpx_thread(
-            [&]() -> pybind11::object
+            if (state.enable_measurements)
             {
-                // Make sure None is printed as "None"
-                phylanx::util::none_wrapper wrap_cout(hpx::cout);
-                phylanx::util::none_wrapper wrap_debug(hpx::consolestream);
+                auto const& funcs = code_x.functions();
+                if (!funcs.empty())
+                {
+                    state.primitive_instances.push_back(
+                        phylanx::util::enable_measurements(
+                            funcs.front().name_));
+                }
+            }
 
-                auto const& code_x =
-                    phylanx::execution_tree::compile(file_name, xexpr_str,
-                        xexpr_str, state.eval_snippets, state.eval_env);
+            return code_x.run(state.eval_ctx);
+        }
 
-                if (state.enable_measurements)
+        // convert all (keyword) arguments while the GIL is held
+        template <typename Cast>
+        void convert_arguments(pybind11::args const& args,
+            pybind11::kwargs const& kwargs,
+            phylanx::execution_tree::primitive_arguments_type& fargs,
+            std::map<std::string,
+                phylanx::execution_tree::primitive_argument_type>& fkwargs,
+            Cast&& cast)
+        {
+            fargs.reserve(args.size());
+            for (auto const& item : args)
+            {
+                fargs.emplace_back(cast(item));
+            }
+
+            if (kwargs.size() != 0)
+            {
+                fkwargs = kwargs.cast<std::map<std::string,
+                    phylanx::execution_tree::primitive_argument_type>>();
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Return the numpy array passed as an argument whose data is
+        // referenced by the given result, if any. Returning that array
+        // avoids copying the referenced data.
+        template <typename T>
+        pybind11::object referenced_argument(
+            pybind11::args const& args, ir::node_data<T> const& value)
+        {
+            using result_type =
+                typename pybind11::detail::casted_type<T>::type;
+
+            std::size_t const dims = value.num_dimensions();
+            if (!value.is_ref() || dims == 0)
+            {
+                return pybind11::object();
+            }
+
+            void const* data = nullptr;
+            switch (dims)
+            {
+            case 1:
+                data = value.vector().data();
+                break;
+
+            case 2:
+                data = value.matrix().data();
+                break;
+
+            case 3:
+                data = value.tensor().data();
+                break;
+
+            case 4:
+                data = value.quatern().data();
+                break;
+
+            default:
+                return pybind11::object();
+            }
+
+            auto const shape = value.dimensions();
+            for (auto const& item : args)
+            {
+                if (!pybind11::isinstance<pybind11::array_t<result_type>>(
+                        item))
                 {
-                    auto const& funcs = code_x.functions();
-                    if (!funcs.empty())
-                    {
-                        state.primitive_instances.push_back(
-                            phylanx::util::enable_measurements(
-                                funcs.front().name_));
-                    }
+                    continue;
+                }
+
+                auto buf = pybind11::reinterpret_borrow<pybind11::array>(item);
+                if (buf.data() != data || std::size_t(buf.ndim()) != dims)
+                {
+                    continue;
                 }
 
-                auto x = code_x.run(state.eval_ctx);
+                bool same_shape = true;
+                for (std::size_t i = 0; i != dims; ++i)
+                {
+                    same_shape = same_shape &&
+                        std::size_t(buf.shape(i)) == shape[i];
+                }
+                if (same_shape)
+                {
+                    return pybind11::reinterpret_borrow<pybind11::object>(
+                        item);
+                }
+            }
+            return pybind11::object();
+        }
+
+        pybind11::object referenced_argument(pybind11::args const& args,
+            execution_tree::primitive_argument_type const& result)
+        {
+            if (auto const* v =
+                    util::get_if<ir::node_data<double>>(&result))
+            {
+                return referenced_argument(args, *v);
+            }
+            if (auto const* v =
+                    util::get_if<ir::node_data<std::int64_t>>(&result))
+            {
+                return referenced_argument(args, *v);
+            }
+            if (auto const* v =
+                    util::get_if<ir::node_data<std::uint8_t>>(&result))
+            {
+                return referenced_argument(args, *v);
+            }
+            return pybind11::object();
+        }
+    }
+
+    pybind11::object expression_evaluator(
+        compiler_state& state, std::string const& file_name,
+        std::string const& xexpr_str, pybind11::args args,
+        pybind11::kwargs kwargs)
+    {
+        using phylanx::execution_tree::primitive_argument_type;
+
+        // Convert all arguments while the GIL is still held by the caller.
+        // The arguments are alive until the evaluation has finished, numpy
+        // arrays can be referenced directly.
+        phylanx::execution_tree::primitive_arguments_type fargs;
+        std::map<std::string, primitive_argument_type> fkwargs;
+        detail::convert_arguments(args, kwargs, fargs, fkwargs,
+            [](pybind11::handle item) {
+                return pybind11::detail::cast_argument_ref(item);
+            });
+
+        bool const has_kwargs = kwargs.size() != 0;
 
-                phylanx::execution_tree::primitive_arguments_type fargs;
-                fargs.reserve(args.size() + kwargs.size());
+        primitive_argument_type result;
 
-                std::map<std::string, primitive_argument_type> fkwargs;
+        {
+            // the evaluation itself does not touch any Python objects, this
+            // allows for other Python threads to run concurrently
+            pybind11::gil_scoped_release release;       // release GIL
 
+            result = hpx::threads::run_as_hpx_thread(
+                [&]() -> primitive_argument_type
                 {
-                    pybind11::gil_scoped_acquire acquire;
-                    for (auto const& item : args)
-                    {
-                        fargs.emplace_back(item.cast<primitive_argument_type>());
-                    }
+                    // Make sure None is printed as "None"
+                    phylanx::util::none_wrapper wrap_cout(hpx::cout);
+                    phylanx::util::none_wrapper wrap_debug(hpx::consolestream);
 
-                    if (kwargs)
+                    auto x = detail::compile_evaluator(state, file_name, xexpr_str);
+
+                    // potentially handle keyword arguments
+                    if (!has_kwargs)
                     {
-                        fkwargs = kwargs.cast<
-                            std::map<std::string, primitive_argument_type>>();
+                        return x(std::move(fargs), state.eval_ctx);
                     }
-                }
+                    return x(std::move(fargs), std::move(fkwargs),
+                        state.eval_ctx);
+                });
+        }
 
-                // potentially handle keyword arguments
-                if (kwargs.size() == 0)
-                {
-                    primitive_argument_type&& result =
-                        x(std::move(fargs), state.eval_ctx);
+        // a result referencing an argument is returned without copying it
+        pybind11::object referenced = detail::referenced_argument(args, result);
+        if (referenced)
+        {
+            return referenced;
+        }
+
+        // convert the result using the re-acquired GIL
+        return pybind11::reinterpret_steal<pybind11::object>(
+            pybind11::detail::make_caster<primitive_argument_type>::cast(
+                std::move(result), pybind11::return_value_policy::move,
+                pybind11::handle()));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Make the given (Python) future ready with the result of the given
+        // evaluation, this must not be called on an HPX thread
+        void resolve_future(pybind11::object&& py_future,
+            hpx::future<execution_tree::primitive_argument_type>&& f)
+        {
+            using phylanx::execution_tree::primitive_argument_type;
+
+            pybind11::gil_scoped_acquire acquire;
 
-                    pybind11::gil_scoped_acquire acquire;
-                    return pybind11::reinterpret_steal<pybind11::object>(
+            // make sure the Python object is released while the GIL is held
+            pybind11::object future = std::move(py_future);
+            try
+            {
+                future.attr("set_result")(
+                    pybind11::reinterpret_steal<pybind11::object>(
                         pybind11::detail::make_caster<
-                            primitive_argument_type>::cast(std::move(result),
+                            primitive_argument_type>::cast(f.get(),
                             pybind11::return_value_policy::move,
-                            pybind11::handle()));
-                }
+                            pybind11::handle())));
+            }
+            catch (pybind11::error_already_set const& e)
+            {
+                future.attr("set_exception")(e.value());
+            }
+            catch (std::exception const& e)
+            {
+                future.attr("set_exception")(
+                    pybind11::reinterpret_borrow<pybind11::object>(
+                        PyExc_RuntimeError)(e.what()));
+            }
+            catch (...)
+            {
+                future.attr("set_exception")(
+                    pybind11::reinterpret_borrow<pybind11::object>(
+                        PyExc_RuntimeError)("unknown exception"));
+            }
+        }
+    }
 
-                primitive_argument_type&& result =
-                    x(std::move(fargs), std::move(fkwargs), state.eval_ctx);
+    pybind11::object expression_evaluator_async(
+        compiler_state& state, std::string const& file_name,
+        std::string const& xexpr_str, pybind11::args args,
+        pybind11::kwargs kwargs)
+    {
+        using phylanx::execution_tree::primitive_argument_type;
 
-                pybind11::gil_scoped_acquire acquire;
-                return pybind11::reinterpret_steal<pybind11::object>(
-                    pybind11::detail::make_caster<
-                        primitive_argument_type>::cast(std::move(result),
-                        pybind11::return_value_policy::move,
-                        pybind11::handle()));
+        // The arguments are copied as the caller may modify them while the
+        // evaluation is running.
+        phylanx::execution_tree::primitive_arguments_type fargs;
+        std::map<std::string, primitive_argument_type> fkwargs;
+        detail::convert_arguments(args, kwargs, fargs, fkwargs,
+            [](pybind11::handle item) {
+                return item.cast<primitive_argument_type>();
             });
+
+        bool const has_kwargs = kwargs.size() != 0;
+
+        // the returned future is made ready once the evaluation has finished
+        pybind11::object result =
+            pybind11::module::import("concurrent.futures").attr("Future")();
+        auto py_future = std::make_shared<pybind11::object>(result);
+
+        {
+            pybind11::gil_scoped_release release;       // release GIL
+
+            hpx::threads::run_as_hpx_thread(
+                [&]() -> void
+                {
+                    auto x = detail::compile_evaluator(
+                        state, file_name, xexpr_str);
+
+                    hpx::future<primitive_argument_type> f = hpx::async(
+                        [x = std::move(x), fargs = std::move(fargs),
+                            fkwargs = std::move(fkwargs), has_kwargs,
+                            ctx = state.eval_ctx]() mutable
+                        -> primitive_argument_type
+                        {
+                            // Make sure None is printed as "None"
+                            phylanx::util::none_wrapper wrap_cout(hpx::cout);
+                            phylanx::util::none_wrapper wrap_debug(
+                                hpx::consolestream);
+
+                            if (!has_kwargs)
+                            {
+                                return x(std::move(fargs), std::move(ctx));
+                            }
+                            return x(std::move(fargs), std::move(fkwargs),
+                                std::move(ctx));
+                        });
+
+                    // the Python future is resolved on a separate OS thread,
+                    // acquiring the GIL must not block an HPX worker thread
+                    f.then(hpx::launch::sync,
+                        [py_future](
+                            hpx::future<primitive_argument_type>&& f) mutable
+                        {
+                            hpx::threads::run_as_os_thread(
+                                [py_future = std::move(py_future),
+                                    f = std::move(f)]() mutable
+                                {
+                                    detail::resolve_future(
+                                        std::move(*py_future), std::move(f));
+                                });
+                        });
+                });
+        }
+
+        return result;
     }
 
     ///////////////////////////////////////////////////////////////////////////
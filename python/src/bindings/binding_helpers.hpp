@@ -14,6 +14,7 @@
 #include <pybind11/pybind11.h>
 
 #include <hpx/include/run_as.hpp>
+#include <hpx/synchronization/mutex.hpp>
 
 #include <cstdint>
 #include <exception>
@@ -52,6 +53,9 @@ namespace phylanx { namespace bindings
         bool enable_measurements;
         std::vector<std::string> primitive_instances;
 
+        // serialize compilation requests issued by concurrent Python threads
+        hpx::lcos::local::mutex mtx_;
+
         static pybind11::object import_phylanx()
         {
 #if defined(_DEBUG)
@@ -218,6 +222,13 @@ namespace phylanx { namespace bindings
         std::string const& xexpr_str, pybind11::args args,
         pybind11::kwargs kwargs);
 
+    // evaluate compiled expression asynchronously, returns a
+    // concurrent.futures.Future
+    pybind11::object expression_evaluator_async(
+        compiler_state& state, std::string const& file_name,
+        std::string const& xexpr_str, pybind11::args args,
+        pybind11::kwargs kwargs);
+
     // extract pre-compiled code for given function name
     phylanx::execution_tree::primitive code_for(
         phylanx::bindings::compiler_state& state,
@@ -54,6 +54,11 @@ void phylanx::bindings::bind_execution_tree(pybind11::module m)
         },
         "compile and evaluate a numerical expression in PhySL");
 
+    execution_tree.def("async_eval",
+        phylanx::bindings::expression_evaluator_async,
+        "compile and asynchronously evaluate a numerical expression in "
+        "PhySL, returns a concurrent.futures.Future");
+
     // expose functionalities needed for accessing performance data
     execution_tree.def("enable_measurements",
         phylanx::bindings::enable_measurements,
@@ -137,18 +142,14 @@ void phylanx::bindings::bind_execution_tree(pybind11::module m)
                 [](phylanx::execution_tree::variable const& var,
                     pybind11::args args)
                 {
-                    pybind11::gil_scoped_release release;       // release GIL
-                    return hpx::threads::run_as_hpx_thread(
-                            [&]() { return var.eval(std::move(args)); });
+                    return var.eval(std::move(args));
                 },
                 "evaluate execution tree")
             .def(
                 "__call__",
                 [](phylanx::execution_tree::variable const& var,
                     pybind11::args args) {
-                    pybind11::gil_scoped_release release;       // release GIL
-                    return hpx::threads::run_as_hpx_thread(
-                        [&]() { return var.eval(std::move(args)); });
+                    return var.eval(std::move(args));
                 },
                 "evaluate execution tree")
             .def_property(
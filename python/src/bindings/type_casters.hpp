@@ -171,6 +171,27 @@ namespace pybind11 { namespace detail
         return false;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    struct casted_type
+    {
+        using type = T;
+    };
+
+    template <>
+    struct casted_type<std::uint8_t>
+    {
+        using type = bool;
+    };
+
+    // The numpy dtype corresponding to the given element type, boolean data
+    // is stored as std::uint8_t and exposed as numpy bool without conversion
+    template <typename T>
+    pybind11::dtype numpy_dtype()
+    {
+        return pybind11::dtype::of<typename casted_type<T>::type>();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Casts a Blaze type to numpy array.  If given a base, the numpy array
     // references the src data, otherwise it'll make a copy.
@@ -179,7 +200,8 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::DynamicVector<T, TF> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{{src.size()}, {sizeof(T)}, src.data(), base};
+        array a{numpy_dtype<T>(), {src.size()}, {sizeof(T)}, src.data(),
+            base};
 
         if (!writeable)
         {
@@ -194,7 +216,8 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::CustomVector<T, AF, PF, TF, RT> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{{src.size()}, {sizeof(T)}, src.data(), base};
+        array a{numpy_dtype<T>(), {src.size()}, {sizeof(T)}, src.data(),
+            base};
 
         if (!writeable)
         {
@@ -208,7 +231,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::DynamicMatrix<T, false> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.rows(), src.columns()},            // sizes
             {sizeof(T) * src.spacing(), sizeof(T)}, // strides
             src.data(), base};
@@ -226,7 +249,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::DynamicMatrix<T, true> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.rows(), src.columns()},            // sizes
             {sizeof(T), sizeof(T) * src.spacing()}, // strides
             src.data(), base};
@@ -243,7 +266,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::CustomMatrix<T, AF, PF, false, RT> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.rows(), src.columns()},            // sizes
             {sizeof(T) * src.spacing(), sizeof(T)}, // strides
             src.data(), base};
@@ -260,7 +283,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::CustomMatrix<T, AF, PF, true, RT> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.rows(), src.columns()},            // sizes
             {sizeof(T), sizeof(T) * src.spacing()}, // strides
             src.data(), base};
@@ -278,7 +301,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::DynamicTensor<T> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.pages(), src.rows(), src.columns()},       // sizes
             {   sizeof(T) * src.spacing() * src.rows(),     // strides
                 sizeof(T) * src.spacing(),
@@ -297,7 +320,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::CustomTensor<T, AF, PF, RT> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.pages(), src.rows(), src.columns()},       // sizes
             {   sizeof(T) * src.spacing() * src.rows(),     // strides
                 sizeof(T) * src.spacing(),
@@ -317,7 +340,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::DynamicArray<4, T> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.quats(), src.pages(), src.rows(), src.columns()},    // sizes
             {   sizeof(T) * src.spacing() * src.rows() * src.pages(), // strides
                 sizeof(T) * src.spacing() * src.rows(),
@@ -338,7 +361,7 @@ namespace pybind11 { namespace detail
     handle blaze_array_cast(blaze::CustomArray<4, T, AF, PF, RT> const& src,
         handle base = handle(), bool writeable = true)
     {
-        array a{
+        array a{numpy_dtype<T>(),
             {src.quats(), src.pages(), src.rows(), src.columns()},    // sizes
             {   sizeof(T) * src.spacing() * src.rows() * src.pages(), // strides
                 sizeof(T) * src.spacing() * src.rows(),
@@ -380,19 +403,6 @@ namespace pybind11 { namespace detail
         return blaze_ref_array(*src, base);
     }
 
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename T>
-    struct casted_type
-    {
-        using type = T;
-    };
-
-    template <>
-    struct casted_type<std::uint8_t>
-    {
-        using type = bool;
-    };
-
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
     struct is_scalar_instance
@@ -463,6 +473,76 @@ namespace pybind11 { namespace detail
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Creates a node_data instance that references the data of the given
+    // numpy array (custom storage) instead of copying it. This is possible
+    // only if the array holds elements of exactly the required type and if
+    // its memory layout is compatible with the aligned and padded custom
+    // Blaze types: the array has to be C-contiguous, its data has to be
+    // properly aligned, and the size of its innermost dimension has to be a
+    // multiple of the SIMD width (i.e. no padding is needed). The caller is
+    // responsible for keeping the array alive while the node_data is in use.
+    template <typename T>
+    bool load_node_data_ref(handle src, phylanx::ir::node_data<T>& value)
+    {
+        using result_type = typename casted_type<T>::type;
+        using node_data_type = phylanx::ir::node_data<T>;
+
+        if (!isinstance<array_t<result_type>>(src))
+        {
+            return false;
+        }
+
+        auto buf = reinterpret_borrow<array>(src);
+
+        auto const dims = buf.ndim();
+        if (dims == 0 || dims > 4 || buf.size() == 0 ||
+            !(buf.flags() & array::c_style))
+        {
+            return false;
+        }
+
+        // PhySL never modifies data it holds references to
+        T* data = const_cast<T*>(static_cast<T const*>(buf.data()));
+
+        std::size_t const columns = buf.shape(dims - 1);
+        if (columns % blaze::SIMDTrait<T>::size != 0 ||
+            reinterpret_cast<std::uintptr_t>(data) %
+                    blaze::AlignmentOf<T>::value != 0)
+        {
+            return false;
+        }
+
+        switch (dims)
+        {
+        case 1:
+            value = node_data_type{
+                typename node_data_type::custom_storage1d_type(
+                    data, columns, columns)};
+            break;
+
+        case 2:
+            value = node_data_type{
+                typename node_data_type::custom_storage2d_type(
+                    data, buf.shape(0), columns, columns)};
+            break;
+
+        case 3:
+            value = node_data_type{
+                typename node_data_type::custom_storage3d_type(
+                    data, buf.shape(0), buf.shape(1), columns, columns)};
+            break;
+
+        case 4:
+            value = node_data_type{
+                typename node_data_type::custom_storage4d_type(data,
+                    buf.shape(0), buf.shape(1), buf.shape(2), columns,
+                    columns)};
+            break;
+        }
+        return true;
+    }
+
     template <typename T>
     class type_caster<phylanx::ir::node_data<T>>
     {
@@ -690,8 +770,6 @@ namespace pybind11 { namespace detail
         template <typename Type>
         static handle cast_impl_automatic(Type* src)
         {
-            using T_ = typename casted_type<T>::type;
-
             switch (src->index())
             {
             // blaze::DynamicVector<T>
@@ -713,22 +791,22 @@ namespace pybind11 { namespace detail
             // custom types require a copy (done by vector_copy/matrix_copy)
             // blaze::CustomVector<T>
             case phylanx::ir::node_data<T>::custom_storage1d:
-                return blaze_encapsulate(new blaze::DynamicVector<T_>(
+                return blaze_encapsulate(new blaze::DynamicVector<T>(
                     src->vector_copy()));
 
             // blaze::CustomMatrix<T>
             case phylanx::ir::node_data<T>::custom_storage2d:
-                return blaze_encapsulate(new blaze::DynamicMatrix<T_>(
+                return blaze_encapsulate(new blaze::DynamicMatrix<T>(
                     src->matrix_copy()));
 
             // blaze::CustomTensor<T>
             case phylanx::ir::node_data<T>::custom_storage3d:
-                return blaze_encapsulate(new blaze::DynamicTensor<T_>(
+                return blaze_encapsulate(new blaze::DynamicTensor<T>(
                     src->tensor_copy()));
 
             // blaze::CustomArray<4, T>
             case phylanx::ir::node_data<T>::custom_storage4d:
-                return blaze_encapsulate(new blaze::DynamicArray<4, T_>(
+                return blaze_encapsulate(new blaze::DynamicArray<4, T>(
                     src->quatern_copy()));
 
             default:
@@ -741,49 +819,47 @@ namespace pybind11 { namespace detail
         template <typename Type>
         static handle cast_impl_move(Type* src)
         {
-            using T_ = typename casted_type<T>::type;
-
             switch (src->index())
             {
             // blaze::DynamicVector<T>
             case phylanx::ir::node_data<T>::storage1d:
-                return blaze_encapsulate(new blaze::DynamicVector<T_>(
+                return blaze_encapsulate(new blaze::DynamicVector<T>(
                     std::move(src->vector_non_ref())));
 
             // blaze::DynamicMatrix<T>
             case phylanx::ir::node_data<T>::storage2d:
-                return blaze_encapsulate(new blaze::DynamicMatrix<T_>(
+                return blaze_encapsulate(new blaze::DynamicMatrix<T>(
                     std::move(src->matrix_non_ref())));
 
             // blaze::DynamicTensor<T>
             case phylanx::ir::node_data<T>::storage3d:
-                return blaze_encapsulate(new blaze::DynamicTensor<T_>(
+                return blaze_encapsulate(new blaze::DynamicTensor<T>(
                     std::move(src->tensor_non_ref())));
 
             // blaze::DynamicArray<4, T>
             case phylanx::ir::node_data<T>::storage4d:
-                return blaze_encapsulate(new blaze::DynamicArray<4, T_>(
+                return blaze_encapsulate(new blaze::DynamicArray<4, T>(
                     std::move(src->quatern_non_ref())));
 
             // custom types require a copy (done by vector_copy/matrix_copy)
             // blaze::CustomVector<T>
             case phylanx::ir::node_data<T>::custom_storage1d:
-                return blaze_encapsulate(new blaze::DynamicVector<T_>(
+                return blaze_encapsulate(new blaze::DynamicVector<T>(
                     src->vector_copy()));
 
             // blaze::CustomMatrix<T>
             case phylanx::ir::node_data<T>::custom_storage2d:
-                return blaze_encapsulate(new blaze::DynamicMatrix<T_>(
+                return blaze_encapsulate(new blaze::DynamicMatrix<T>(
                     src->matrix_copy()));
 
             // blaze::CustomTensor<T>
             case phylanx::ir::node_data<T>::custom_storage3d:
-                return blaze_encapsulate(new blaze::DynamicTensor<T_>(
+                return blaze_encapsulate(new blaze::DynamicTensor<T>(
                     src->tensor_copy()));
 
             // blaze::CustomArray<4, T>
             case phylanx::ir::node_data<T>::custom_storage4d:
-                return blaze_encapsulate(new blaze::DynamicArray<4, T_>(
+                return blaze_encapsulate(new blaze::DynamicArray<4, T>(
                     src->quatern_copy()));
 
             default:
@@ -796,8 +872,6 @@ namespace pybind11 { namespace detail
         template <typename Type>
         static handle cast_impl_copy(Type* src)
         {
-            using T_ = typename casted_type<T>::type;
-
             switch (src->index())
             {
             // blaze::DynamicVector<T>
@@ -818,22 +892,22 @@ namespace pybind11 { namespace detail
 
             // blaze::CustomVector<T>
             case phylanx::ir::node_data<T>::custom_storage1d:
-                return blaze_encapsulate(new blaze::DynamicVector<T_>(
+                return blaze_encapsulate(new blaze::DynamicVector<T>(
                     src->vector_copy()));
 
             // blaze::CustomMatrix<T>
             case phylanx::ir::node_data<T>::custom_storage2d:
-                return blaze_encapsulate(new blaze::DynamicMatrix<T_>(
+                return blaze_encapsulate(new blaze::DynamicMatrix<T>(
                     src->matrix_copy()));
 
             // blaze::CustomTensor<T>
             case phylanx::ir::node_data<T>::custom_storage3d:
-                return blaze_encapsulate(new blaze::DynamicTensor<T_>(
+                return blaze_encapsulate(new blaze::DynamicTensor<T>(
                     src->tensor_copy()));
 
             // blaze::CustomArray<4, T>
             case phylanx::ir::node_data<T>::custom_storage4d:
-                return blaze_encapsulate(new blaze::DynamicArray<4, T_>(
+                return blaze_encapsulate(new blaze::DynamicArray<4, T>(
                     src->quatern_copy()));
 
             default:
@@ -846,8 +920,6 @@ namespace pybind11 { namespace detail
         template <typename Type>
         static handle cast_impl_automatic_reference(Type* src)
         {
-            using T_ = typename casted_type<T>::type;
-
             switch (src->index())
             {
             // blaze::DynamicVector<T>
@@ -869,22 +941,22 @@ namespace pybind11 { namespace detail
             // custom types require a copy (done by vector_copy/matrix_copy)
             // blaze::CustomVector<T>
             case phylanx::ir::node_data<T>::custom_storage1d:
-                return blaze_encapsulate(new blaze::DynamicVector<T_>(
+                return blaze_encapsulate(new blaze::DynamicVector<T>(
                     src->vector_copy()));
 
             // blaze::CustomMatrix<T>
             case phylanx::ir::node_data<T>::custom_storage2d:
-                return blaze_encapsulate(new blaze::DynamicMatrix<T_>(
+                return blaze_encapsulate(new blaze::DynamicMatrix<T>(
                     src->matrix_copy()));
 
             // blaze::CustomTensor<T>
             case phylanx::ir::node_data<T>::custom_storage3d:
-                return blaze_encapsulate(new blaze::DynamicTensor<T_>(
+                return blaze_encapsulate(new blaze::DynamicTensor<T>(
                     src->tensor_copy()));
 
-            // blaze::CustomArray<T4, >
+            // blaze::CustomArray<4, T>
             case phylanx::ir::node_data<T>::custom_storage4d:
-                return blaze_encapsulate(new blaze::DynamicArray<4, T_>(
+                return blaze_encapsulate(new blaze::DynamicArray<4, T>(
                     src->quatern_copy()));
 
             default:
@@ -1205,6 +1277,12 @@ namespace pybind11 { namespace detail
             switch(src->index())
             {
             case 1:                     // wrapped_args_type
+                if (policy == return_value_policy::move)
+                {
+                    // hand the elements (and their data) over to Python
+                    return list_caster_type::cast(
+                        std::move(src->args()), policy, parent);
+                }
                 return list_caster_type::cast(src->args(), policy, parent);
 
             case 2:                     // arg_pair_type
@@ -1481,6 +1559,37 @@ namespace pybind11 { namespace detail
             return true;
         return load_alternative(src, convert, type_list<Ts...>{});
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Converts the given object into a primitive_argument_type. Suitable
+    // numpy arrays are referenced instead of being copied (see
+    // load_node_data_ref), which requires for the object to outlive the
+    // returned value.
+    inline phylanx::execution_tree::primitive_argument_type cast_argument_ref(
+        handle src)
+    {
+        using phylanx::execution_tree::primitive_argument_type;
+
+        phylanx::ir::node_data<double> d;
+        if (load_node_data_ref(src, d))
+        {
+            return primitive_argument_type{std::move(d)};
+        }
+
+        phylanx::ir::node_data<std::int64_t> i;
+        if (load_node_data_ref(src, i))
+        {
+            return primitive_argument_type{std::move(i)};
+        }
+
+        phylanx::ir::node_data<std::uint8_t> b;
+        if (load_node_data_ref(src, b))
+        {
+            return primitive_argument_type{std::move(b)};
+        }
+
+        return src.cast<primitive_argument_type>();
+    }
 }}
 
 #endif
@@ -281,32 +281,37 @@ namespace phylanx { namespace execution_tree
     ///////////////////////////////////////////////////////////////////////////
     pybind11::object variable::eval(pybind11::args args) const
     {
+        // Convert all arguments while the GIL is still held by the caller.
+        // The arguments are alive until the evaluation has finished, numpy
+        // arrays can be referenced directly.
         phylanx::execution_tree::primitive_arguments_type keep_alive;
         keep_alive.reserve(args.size());
-        phylanx::execution_tree::primitive_arguments_type fargs;
-        fargs.reserve(args.size());
-
+        for (auto const& item : args)
         {
-            pybind11::gil_scoped_acquire acquire;
-            for (auto const& item : args)
-            {
-                using phylanx::execution_tree::primitive_argument_type;
-
-                primitive_argument_type value =
-                    item.cast<primitive_argument_type>();
-
-                keep_alive.emplace_back(std::move(value));
-                fargs.emplace_back(extract_ref_value(keep_alive.back()));
-            }
+            keep_alive.emplace_back(pybind11::detail::cast_argument_ref(item));
         }
 
-        static std::string varname("variable::eval");
-        primitive_argument_type result = value_operand_sync(
-            primitive_argument_type{value_}, std::move(fargs),
-            varname, state().codename_);
+        primitive_argument_type result;
 
-        // re-acquire GIL
-        pybind11::gil_scoped_acquire acquire;
+        {
+            pybind11::gil_scoped_release release;       // release GIL
+
+            result = hpx::threads::run_as_hpx_thread(
+                [&]() -> primitive_argument_type
+                {
+                    phylanx::execution_tree::primitive_arguments_type fargs;
+                    fargs.reserve(keep_alive.size());
+                    for (auto const& arg : keep_alive)
+                    {
+                        fargs.emplace_back(extract_ref_value(arg));
+                    }
+
+                    static std::string varname("variable::eval");
+                    return value_operand_sync(
+                        primitive_argument_type{value_}, std::move(fargs),
+                        varname, state().codename_);
+                });
+        }
 
         // access dtype of result, if necessary
         if (!dtype_.is_none())
@@ -7,6 +7,7 @@
 #include <phylanx/ast/detail/is_function_call.hpp>
 #include <phylanx/util/variant.hpp>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -91,5 +92,25 @@ namespace phylanx { namespace ast { namespace detail
     {
         return visit(function_arguments_helper(), op);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct function_argument_count_helper
+    {
+        template <typename Ast>
+        std::size_t operator()(Ast const& ast) const
+        {
+            return function_argument_count(ast);
+        }
+    };
+
+    std::size_t function_argument_count(primary_expr const& pe)
+    {
+        return visit(function_argument_count_helper(), pe);
+    }
+
+    std::size_t function_argument_count(operand const& op)
+    {
+        return visit(function_argument_count_helper(), op);
+    }
 }}}
 
@@ -7,9 +7,11 @@
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/ast/parser/expression.hpp>
+#include <phylanx/ast/parser/recursive_descent.hpp>
 #include <phylanx/ast/parser/skipper.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
 
 #include <boost/spirit/include/qi.hpp>
 
@@ -215,47 +217,81 @@ namespace phylanx { namespace ast
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    std::vector<ast::expression> generate_ast(std::string const& input)
+    namespace detail
     {
-        ir::reset_enable_counts_on_exit on_exit;
+        parser_type configured_parser()
+        {
+            static parser_type const type =
+                hpx::get_config_entry("phylanx.parser", "spirit") ==
+                    "recursive_descent" ?
+                parser_type::recursive_descent :
+                parser_type::spirit;
+            return type;
+        }
 
-        using iterator = std::string::const_iterator;
+        std::vector<ast::expression> generate_ast_spirit(
+            std::string const& input)
+        {
+            using iterator = std::string::const_iterator;
 
-        iterator first = input.begin();
-        iterator last = input.end();
+            iterator first = input.begin();
+            iterator last = input.end();
 
-        std::vector<std::string::const_iterator> iters;
-        std::stringstream strm;
-        ast::parser::error_handler<iterator> error_handler(
-            first, last, strm, iters);
+            std::vector<std::string::const_iterator> iters;
+            std::stringstream strm;
+            ast::parser::error_handler<iterator> error_handler(
+                first, last, strm, iters);
 
-        ast::parser::expression<iterator> expr(error_handler);
-        ast::parser::skipper<iterator> skipper;
+            ast::parser::expression<iterator> expr(error_handler);
+            ast::parser::skipper<iterator> skipper;
 
-        std::vector<ast::expression> asts;
+            std::vector<ast::expression> asts;
 
-        if (!boost::spirit::qi::phrase_parse(first, last, *expr, skipper,
-                boost::spirit::qi::skip_flag::postskip, asts))
-        {
-            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "phylanx::ast::generate_ast", strm.str());
-        }
+            if (!boost::spirit::qi::phrase_parse(first, last, *expr, skipper,
+                    boost::spirit::qi::skip_flag::postskip, asts))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::ast::generate_ast", strm.str());
+            }
 
-        if (first != last)
-        {
-            error_handler("Error! ", "Incomplete parse:", first);
+            if (first != last)
+            {
+                error_handler("Error! ", "Incomplete parse:", first);
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::ast::generate_ast", strm.str());
+            }
 
-            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "phylanx::ast::generate_ast", strm.str());
+            // replace compile-tags with line/column information
+            for (auto& ast : asts)
+            {
+                detail::replace_compile_ids(ast, iters, input);
+            }
+
+            return asts;
         }
+    }
 
-        // replace compile-tags with line/column information
-        for (auto& ast : asts)
+    std::vector<ast::expression> generate_ast(std::string const& input)
+    {
+        return generate_ast(input, parser_type::configured);
+    }
+
+    std::vector<ast::expression> generate_ast(
+        std::string const& input, parser_type type)
+    {
+        ir::reset_enable_counts_on_exit on_exit;
+
+        if (type == parser_type::configured)
         {
-            detail::replace_compile_ids(ast, iters, input);
+            type = detail::configured_parser();
         }
 
-        return asts;
+        if (type == parser_type::recursive_descent)
+        {
+            return parser::parse_recursive_descent(input);
+        }
+        return detail::generate_ast_spirit(input);
     }
 }}
 
@@ -0,0 +1,1046 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/generate_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/parser/error_handler.hpp>
+#include <phylanx/ast/parser/recursive_descent.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The parser below mirrors the Spirit grammar in expression_def.hpp rule by
+// rule. This includes the order in which the alternatives of primary_expr are
+// tried, which parts of the grammar report errors (the expectation points of
+// the grammar), and the positions the grammar uses to annotate the generated
+// AST nodes:
+//
+//  - identifiers (and function names) are annotated with the position of
+//    their first character,
+//  - literals and lists are annotated with the position the enclosing
+//    unary_expr started at (this is before any preceding whitespace).
+//
+// Instead of collecting iterators and converting those into line/column
+// information afterwards, the positions are converted while parsing using a
+// table of line starts.
+namespace phylanx { namespace ast { namespace parser
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        inline bool is_digit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        inline bool is_alpha(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        inline bool is_space(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+                c == '\v' || c == '\f';
+        }
+
+        inline bool is_hex_digit(char c, unsigned& val)
+        {
+            if (is_digit(c))
+            {
+                val = unsigned(c - '0');
+                return true;
+            }
+            if (c >= 'a' && c <= 'f')
+            {
+                val = unsigned(c - 'a' + 10);
+                return true;
+            }
+            if (c >= 'A' && c <= 'F')
+            {
+                val = unsigned(c - 'A' + 10);
+                return true;
+            }
+            return false;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The element types the grammar tries for array literals, in order
+        enum class array_kind
+        {
+            empty,
+            boolean,
+            int64,
+            real
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class recursive_descent_parser
+        {
+        public:
+            explicit recursive_descent_parser(std::string const& input)
+              : input_(input)
+              , begin_(input.data())
+              , end_(input.data() + input.size())
+              , has_unresolved_ids_(false)
+            {
+                line_starts_.push_back(0);
+                for (char const* p = begin_; p != end_; ++p)
+                {
+                    if (*p == '\r' || *p == '\n')
+                    {
+                        line_starts_.push_back(std::size_t(p - begin_) + 1);
+                    }
+                }
+            }
+
+            std::vector<ast::expression> parse()
+            {
+                std::vector<ast::expression> result;
+
+                char const* p = begin_;
+                while (true)
+                {
+                    ast::expression expr;
+                    if (!parse_expression(p, expr))
+                    {
+                        break;
+                    }
+                    result.emplace_back(std::move(expr));
+                }
+
+                p = skip(p);
+                if (p != end_)
+                {
+                    report_error("Error! ", "Incomplete parse:", p);
+                }
+
+                // identifiers carrying an explicit id but no column refer to
+                // an annotation slot, those are resolved the same way the
+                // Spirit based parser does it
+                if (has_unresolved_ids_)
+                {
+                    std::vector<std::string::const_iterator> iters;
+                    iters.reserve(annotations_.size());
+                    for (std::size_t offset : annotations_)
+                    {
+                        iters.push_back(
+                            input_.begin() + std::ptrdiff_t(offset));
+                    }
+                    for (auto& expr : result)
+                    {
+                        ast::detail::replace_compile_ids(expr, iters, input_);
+                    }
+                }
+
+                return result;
+            }
+
+        private:
+            ///////////////////////////////////////////////////////////////////
+            [[noreturn]] void report_error(
+                char const* message, char const* what, char const* pos) const
+            {
+                using iterator = std::string::const_iterator;
+
+                std::vector<iterator> iters;
+                std::stringstream strm;
+                error_handler<iterator> handler(
+                    input_.begin(), input_.end(), strm, iters);
+
+                handler(message, what, input_.begin() + (pos - begin_));
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::ast::generate_ast", strm.str());
+            }
+
+            [[noreturn]] void expected(char const* what, char const* pos) const
+            {
+                report_error("Error! Expecting ", what, pos);
+            }
+
+            // Record an annotation at the given position and return the
+            // corresponding tag (line/column)
+            tagged annotate(char const* pos)
+            {
+                std::size_t const offset = std::size_t(pos - begin_);
+                annotations_.push_back(offset);
+
+                auto it = std::upper_bound(
+                    line_starts_.begin(), line_starts_.end(), offset);
+
+                return tagged(std::int64_t(it - line_starts_.begin()),
+                    std::int64_t(offset - *(it - 1) + 1));
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // skip whitespace and comments (see skipper.hpp)
+            char const* skip_to_eol(char const* p) const
+            {
+                while (p != end_ && *p != '\r' && *p != '\n')
+                {
+                    ++p;
+                }
+                return p;
+            }
+
+            char const* skip(char const* p) const
+            {
+                while (p != end_)
+                {
+                    if (is_space(*p))
+                    {
+                        ++p;
+                    }
+                    else if (*p == '/' && p + 1 != end_ && p[1] == '*')
+                    {
+                        char const* q = p + 2;
+                        while (q != end_ && !(*q == '*' && q + 1 != end_ &&
+                                   q[1] == '/'))
+                        {
+                            ++q;
+                        }
+                        if (q == end_)
+                        {
+                            break;      // unterminated comment
+                        }
+                        p = q + 2;
+                    }
+                    else if (*p == '/' && p + 1 != end_ && p[1] == '/')
+                    {
+                        p = skip_to_eol(p + 2);
+                    }
+                    else if (*p == '#')
+                    {
+                        p = skip_to_eol(p + 1);
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+                return p;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Numeric literals, the conventions of Spirit's numeric parsers
+            // are followed closely (optional signs, nan/inf, leading and
+            // trailing dots, dangling exponent markers)
+            bool parse_int64(char const*& p, std::int64_t& val) const
+            {
+                char const* q = p;
+                bool negative = false;
+                if (q != end_ && (*q == '+' || *q == '-'))
+                {
+                    negative = *q++ == '-';
+                }
+                if (q == end_ || !is_digit(*q))
+                {
+                    return false;
+                }
+
+                std::int64_t result = 0;
+                for (/**/; q != end_ && is_digit(*q); ++q)
+                {
+                    int const digit = *q - '0';
+                    if (negative)
+                    {
+                        if (result < (std::numeric_limits<std::int64_t>::min() +
+                                         digit) / 10)
+                        {
+                            return false;
+                        }
+                        result = result * 10 - digit;
+                    }
+                    else
+                    {
+                        if (result > (std::numeric_limits<std::int64_t>::max() -
+                                         digit) / 10)
+                        {
+                            return false;
+                        }
+                        result = result * 10 + digit;
+                    }
+                }
+
+                val = result;
+                p = q;
+                return true;
+            }
+
+            static bool match_nocase(
+                char const*& p, char const* end, char const* str)
+            {
+                char const* q = p;
+                for (/**/; *str != '\0'; ++str, ++q)
+                {
+                    if (q == end || (*q != *str && *q != *str - 'a' + 'A'))
+                    {
+                        return false;
+                    }
+                }
+                p = q;
+                return true;
+            }
+
+            // a strict double requires a decimal point or an exponent
+            bool parse_double(char const*& p, double& val, bool strict)
+            {
+                char const* q = p;
+                bool negative = false;
+                if (q != end_ && (*q == '+' || *q == '-'))
+                {
+                    negative = *q++ == '-';
+                }
+
+                char const* digits = q;
+                while (q != end_ && is_digit(*q))
+                {
+                    ++q;
+                }
+                bool const got_number = q != digits;
+
+                if (!got_number)
+                {
+                    if (match_nocase(q, end_, "nan"))
+                    {
+                        // skip optional trailing (...) part
+                        if (q != end_ && *q == '(')
+                        {
+                            char const* r = std::find(q, end_, ')');
+                            if (r == end_)
+                            {
+                                return false;
+                            }
+                            q = r + 1;
+                        }
+                        val = negative ?
+                            -std::numeric_limits<double>::quiet_NaN() :
+                            std::numeric_limits<double>::quiet_NaN();
+                        p = q;
+                        return true;
+                    }
+                    if (match_nocase(q, end_, "inf"))
+                    {
+                        match_nocase(q, end_, "inity");
+                        val = negative ? -std::numeric_limits<double>::infinity() :
+                                         std::numeric_limits<double>::infinity();
+                        p = q;
+                        return true;
+                    }
+                }
+
+                if (q != end_ && *q == '.')
+                {
+                    char const* frac = ++q;
+                    while (q != end_ && is_digit(*q))
+                    {
+                        ++q;
+                    }
+                    if (q == frac && !got_number)
+                    {
+                        return false;
+                    }
+                }
+                else if (!got_number ||
+                    (strict && (q == end_ || (*q != 'e' && *q != 'E'))))
+                {
+                    return false;
+                }
+
+                // an exponent marker not followed by a number is ignored
+                if (q != end_ && (*q == 'e' || *q == 'E'))
+                {
+                    char const* r = q + 1;
+                    if (r != end_ && (*r == '+' || *r == '-'))
+                    {
+                        ++r;
+                    }
+                    if (r != end_ && is_digit(*r))
+                    {
+                        while (r != end_ && is_digit(*r))
+                        {
+                            ++r;
+                        }
+                        q = r;
+                    }
+                }
+
+                number_buffer_.assign(p, q);
+                val = std::strtod(number_buffer_.c_str(), nullptr);
+                p = q;
+                return true;
+            }
+
+            bool parse_bool(char const*& p, std::uint8_t& val) const
+            {
+                std::size_t const size = std::size_t(end_ - p);
+                if (size >= 4 && std::strncmp(p, "true", 4) == 0)
+                {
+                    val = 1;
+                    p += 4;
+                    return true;
+                }
+                if (size >= 5 && std::strncmp(p, "false", 5) == 0)
+                {
+                    val = 0;
+                    p += 5;
+                    return true;
+                }
+                return false;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // array literals
+            bool parse_element(char const*& p, std::uint8_t& val, array_kind)
+            {
+                return parse_bool(p, val);
+            }
+
+            bool parse_element(char const*& p, std::int64_t& val, array_kind)
+            {
+                return parse_int64(p, val);
+            }
+
+            bool parse_element(char const*& p, double& val, array_kind)
+            {
+                return parse_double(p, val, false);
+            }
+
+            // innermost dimension: '[' >> -(element % ',') >> ']'
+            template <typename T>
+            bool parse_array(
+                char const*& p, std::vector<T>& result, array_kind kind)
+            {
+                char const* q = skip(p);
+                if (q == end_ || *q != '[')
+                {
+                    return false;
+                }
+                ++q;
+
+                if (kind != array_kind::empty)
+                {
+                    T val;
+                    char const* r = skip(q);
+                    if (parse_element(r, val, kind))
+                    {
+                        result.push_back(val);
+                        q = r;
+                        while (true)
+                        {
+                            r = skip(q);
+                            if (r == end_ || *r != ',')
+                            {
+                                break;
+                            }
+                            r = skip(r + 1);
+                            if (!parse_element(r, val, kind))
+                            {
+                                break;
+                            }
+                            result.push_back(val);
+                            q = r;
+                        }
+                    }
+                }
+
+                q = skip(q);
+                if (q == end_ || *q != ']')
+                {
+                    if (kind == array_kind::real)
+                    {
+                        expected("']'", q);
+                    }
+                    return false;
+                }
+
+                p = q + 1;
+                return true;
+            }
+
+            // outer dimensions: '[' >> (inner % ',') >> ']'
+            template <typename T>
+            bool parse_array(char const*& p,
+                std::vector<std::vector<T>>& result, array_kind kind)
+            {
+                char const* q = skip(p);
+                if (q == end_ || *q != '[')
+                {
+                    return false;
+                }
+                ++q;
+
+                std::vector<T> inner;
+                if (!parse_array(q, inner, kind))
+                {
+                    return false;
+                }
+                result.emplace_back(std::move(inner));
+
+                while (true)
+                {
+                    char const* r = skip(q);
+                    if (r == end_ || *r != ',')
+                    {
+                        break;
+                    }
+                    ++r;
+
+                    std::vector<T> next;
+                    if (!parse_array(r, next, kind))
+                    {
+                        break;
+                    }
+                    result.emplace_back(std::move(next));
+                    q = r;
+                }
+
+                q = skip(q);
+                if (q == end_ || *q != ']')
+                {
+                    if (kind == array_kind::real)
+                    {
+                        expected("']'", q);
+                    }
+                    return false;
+                }
+
+                p = q + 1;
+                return true;
+            }
+
+            template <typename T>
+            bool parse_array_literal(
+                char const*& p, array_kind kind, ast::primary_expr& result)
+            {
+                {
+                    std::vector<std::vector<std::vector<std::vector<T>>>> val;
+                    if (parse_array(p, val, kind))
+                    {
+                        result = ast::primary_expr(std::move(val));
+                        return true;
+                    }
+                }
+                {
+                    std::vector<std::vector<std::vector<T>>> val;
+                    if (parse_array(p, val, kind))
+                    {
+                        result = ast::primary_expr(std::move(val));
+                        return true;
+                    }
+                }
+                {
+                    std::vector<std::vector<T>> val;
+                    if (parse_array(p, val, kind))
+                    {
+                        result = ast::primary_expr(std::move(val));
+                        return true;
+                    }
+                }
+
+                std::vector<T> val;
+                if (parse_array(p, val, kind))
+                {
+                    result = ast::primary_expr(std::move(val));
+                    return true;
+                }
+                return false;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // string: '"' > *(unesc_char | "\\x" >> hex | (char_ - '"')) > '"'
+            bool parse_string(char const*& p, std::string& result) const
+            {
+                char const* q = p + 1;
+                while (q != end_ && *q != '"')
+                {
+                    if (*q == '\\' && q + 1 != end_)
+                    {
+                        char c = '\0';
+                        switch (q[1])
+                        {
+                        case 'a': c = '\a'; break;
+                        case 'b': c = '\b'; break;
+                        case 'f': c = '\f'; break;
+                        case 'n': c = '\n'; break;
+                        case 'r': c = '\r'; break;
+                        case 't': c = '\t'; break;
+                        case 'v': c = '\v'; break;
+                        case '\\': c = '\\'; break;
+                        case '\'': c = '\''; break;
+                        case '"': c = '"'; break;
+
+                        case 'x':
+                            {
+                                unsigned digit = 0;
+                                if (q + 2 != end_ && is_hex_digit(q[2], digit))
+                                {
+                                    unsigned val = digit;
+                                    q += 3;
+                                    if (q != end_ && is_hex_digit(*q, digit))
+                                    {
+                                        val = val * 16 + digit;
+                                        ++q;
+                                    }
+                                    result.push_back(char(val));
+                                    continue;
+                                }
+                            }
+                            break;
+
+                        default:
+                            break;
+                        }
+
+                        if (c != '\0')
+                        {
+                            result.push_back(c);
+                            q += 2;
+                            continue;
+                        }
+                    }
+                    result.push_back(*q++);
+                }
+
+                if (q == end_)
+                {
+                    expected("'\"'", q);
+                }
+
+                p = q + 1;
+                return true;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // identifier: name >> -('$' > long_long) >> -('$' > long_long),
+            // note that the grammar leaves the input positioned after any
+            // whitespace following the identifier
+            void parse_identifier(char const*& p, ast::identifier& result)
+            {
+                char const* q = p;
+                while (q != end_ && (is_alpha(*q) || is_digit(*q) || *q == '_'))
+                {
+                    ++q;
+                }
+                result.name.assign(p, q);
+
+                std::int64_t tag[2] = {-1, -1};
+                for (std::int64_t& part : tag)
+                {
+                    q = skip(q);
+                    if (q == end_ || *q != '$')
+                    {
+                        break;
+                    }
+                    q = skip(q + 1);
+                    if (!parse_int64(q, part))
+                    {
+                        expected("<long_long>", q);
+                    }
+                }
+
+                if (tag[0] < 0 && tag[1] == -1)
+                {
+                    tagged const t = annotate(p);
+                    result.id = t.id;
+                    result.col = t.col;
+                }
+                else
+                {
+                    result.id = tag[0];
+                    result.col = tag[1];
+                    if (tag[0] >= 0 && tag[1] == -1)
+                    {
+                        has_unresolved_ids_ = true;
+                    }
+                }
+
+                p = skip(q);
+            }
+
+            // argument_list: -(expr % ',')
+            void parse_argument_list(
+                char const*& p, std::vector<ast::expression>& result)
+            {
+                ast::expression expr;
+                if (parse_expression(p, expr))
+                {
+                    result.emplace_back(std::move(expr));
+                    while (true)
+                    {
+                        char const* q = skip(p);
+                        if (q == end_ || *q != ',')
+                        {
+                            break;
+                        }
+                        ++q;
+
+                        ast::expression next;
+                        if (!parse_expression(q, next))
+                        {
+                            break;
+                        }
+                        result.emplace_back(std::move(next));
+                        p = q;
+                    }
+                }
+
+                p = skip(p);
+                if (p == end_ || *p != ')')
+                {
+                    expected("')'", p);
+                }
+                ++p;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // primary_expr, the alternatives are tried in the same sequence
+            // as the grammar does, the flag 'needs_tag' is set for nodes that
+            // will be annotated by the enclosing unary_expr
+            bool parse_primary(char const*& p, ast::primary_expr& result,
+                bool& needs_tag)
+            {
+                needs_tag = true;
+
+                char const* q = skip(p);
+                if (q == end_)
+                {
+                    return false;
+                }
+
+                char const c = *q;
+
+                // strict_double
+                if (is_digit(c) || c == '.' || c == '+' || c == '-' ||
+                    c == 'n' || c == 'N' || c == 'i' || c == 'I')
+                {
+                    double val = 0.0;
+                    if (parse_double(q, val, true))
+                    {
+                        result = ast::primary_expr(val);
+                        p = q;
+                        return true;
+                    }
+                }
+
+                // function_call | identifier
+                if (is_alpha(c) || c == '_')
+                {
+                    needs_tag = false;
+
+                    ast::identifier name;
+                    char const* r = q;
+                    parse_identifier(r, name);
+
+                    // attribute: '{' > *(char_ - '}') > '}'
+                    std::string attribute;
+                    char const* s = r;
+                    if (s != end_ && *s == '{')
+                    {
+                        char const* close = std::find(s + 1, end_, '}');
+                        if (close == end_)
+                        {
+                            expected("'}'", close);
+                        }
+                        attribute.assign(s + 1, close);
+                        s = skip(close + 1);
+                    }
+
+                    if (s != end_ && *s == '(')
+                    {
+                        ++s;
+                        std::vector<ast::expression> args;
+                        parse_argument_list(s, args);
+
+                        result = ast::primary_expr(ast::function_call(
+                            std::move(name), std::move(attribute),
+                            std::move(args)));
+                        p = s;
+                        return true;
+                    }
+
+                    // not a function call, the grammar parses (and
+                    // annotates) the identifier a second time
+                    ast::identifier ident;
+                    parse_identifier(q, ident);
+
+                    result = ast::primary_expr(std::move(ident));
+                    p = q;
+                    return true;
+                }
+
+                // list: '\'' >> '(' > argument_list > ')'
+                if (c == '\'')
+                {
+                    char const* r = skip(q + 1);
+                    if (r == end_ || *r != '(')
+                    {
+                        return false;
+                    }
+                    ++r;
+
+                    std::vector<ast::expression> args;
+                    parse_argument_list(r, args);
+
+                    result = ast::primary_expr(std::move(args));
+                    p = r;
+                    return true;
+                }
+
+                // long_long
+                if (is_digit(c) || c == '+' || c == '-')
+                {
+                    std::int64_t val = 0;
+                    if (parse_int64(q, val))
+                    {
+                        result = ast::primary_expr(val);
+                        p = q;
+                        return true;
+                    }
+                    return false;
+                }
+
+                // string
+                if (c == '"')
+                {
+                    std::string val;
+                    parse_string(q, val);
+
+                    result = ast::primary_expr(std::move(val));
+                    p = q;
+                    return true;
+                }
+
+                // array literals, tried as empty, boolean, integer, and
+                // floating point arrays
+                if (c == '[')
+                {
+                    if (parse_array_literal<double>(
+                            q, array_kind::empty, result) ||
+                        parse_array_literal<std::uint8_t>(
+                            q, array_kind::boolean, result) ||
+                        parse_array_literal<std::int64_t>(
+                            q, array_kind::int64, result) ||
+                        parse_array_literal<double>(
+                            q, array_kind::real, result))
+                    {
+                        p = q;
+                        return true;
+                    }
+                    return false;
+                }
+
+                // '(' > expr > ')'
+                if (c == '(')
+                {
+                    needs_tag = false;
+
+                    ++q;
+                    ast::expression expr;
+                    if (!parse_expression(q, expr))
+                    {
+                        expected("<expr>", q);
+                    }
+
+                    q = skip(q);
+                    if (q == end_ || *q != ')')
+                    {
+                        expected("')'", q);
+                    }
+
+                    result = ast::primary_expr(std::move(expr));
+                    p = q + 1;
+                    return true;
+                }
+
+                return false;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // unary_expr: primary_expr | (unary_op > unary_expr)
+            bool parse_unary(char const*& p, ast::operand& result)
+            {
+                char const* const start = p;
+
+                bool needs_tag = false;
+                ast::primary_expr primary;
+                if (parse_primary(p, primary, needs_tag))
+                {
+                    if (needs_tag)
+                    {
+                        tagged const t = annotate(start);
+                        primary.id = t.id;
+                        primary.col = t.col;
+                    }
+                    result = ast::operand(std::move(primary));
+                    return true;
+                }
+
+                char const* q = skip(p);
+                if (q == end_)
+                {
+                    return false;
+                }
+
+                ast::optoken op = ast::optoken::op_unknown;
+                switch (*q)
+                {
+                case '+': op = ast::optoken::op_positive; break;
+                case '-': op = ast::optoken::op_negative; break;
+                case '!': op = ast::optoken::op_not; break;
+                default:
+                    return false;
+                }
+                ++q;
+
+                ast::operand operand;
+                if (!parse_unary(q, operand))
+                {
+                    expected("<unary_expr>", q);
+                }
+
+                result = ast::operand(ast::unary_expr(op, std::move(operand)));
+                p = q;
+                return true;
+            }
+
+            // binary_op, matches the longest operator
+            char const* parse_binary_op(char const* p, ast::optoken& op) const
+            {
+                if (p == end_)
+                {
+                    return nullptr;
+                }
+
+                bool const has_next = p + 1 != end_;
+                switch (*p)
+                {
+                case '|':
+                    if (has_next && p[1] == '|')
+                    {
+                        op = ast::optoken::op_logical_or;
+                        return p + 2;
+                    }
+                    break;
+
+                case '&':
+                    if (has_next && p[1] == '&')
+                    {
+                        op = ast::optoken::op_logical_and;
+                        return p + 2;
+                    }
+                    break;
+
+                case '=':
+                    if (has_next && p[1] == '=')
+                    {
+                        op = ast::optoken::op_equal;
+                        return p + 2;
+                    }
+                    break;
+
+                case '!':
+                    if (has_next && p[1] == '=')
+                    {
+                        op = ast::optoken::op_not_equal;
+                        return p + 2;
+                    }
+                    break;
+
+                case '<':
+                    if (has_next && p[1] == '=')
+                    {
+                        op = ast::optoken::op_less_equal;
+                        return p + 2;
+                    }
+                    op = ast::optoken::op_less;
+                    return p + 1;
+
+                case '>':
+                    if (has_next && p[1] == '=')
+                    {
+                        op = ast::optoken::op_greater_equal;
+                        return p + 2;
+                    }
+                    op = ast::optoken::op_greater;
+                    return p + 1;
+
+                case '+': op = ast::optoken::op_plus; return p + 1;
+                case '-': op = ast::optoken::op_minus; return p + 1;
+                case '*': op = ast::optoken::op_times; return p + 1;
+                case '/': op = ast::optoken::op_divide; return p + 1;
+                case '%': op = ast::optoken::op_mod; return p + 1;
+
+                default:
+                    break;
+                }
+                return nullptr;
+            }
+
+            // expr: unary_expr >> *(binary_op > unary_expr)
+            bool parse_expression(char const*& p, ast::expression& result)
+            {
+                ast::operand first;
+                if (!parse_unary(p, first))
+                {
+                    return false;
+                }
+
+                std::vector<ast::operation> rest;
+                while (true)
+                {
+                    ast::optoken op = ast::optoken::op_unknown;
+                    char const* q = parse_binary_op(skip(p), op);
+                    if (q == nullptr)
+                    {
+                        break;
+                    }
+
+                    ast::operand operand;
+                    if (!parse_unary(q, operand))
+                    {
+                        expected("<unary_expr>", q);
+                    }
+                    rest.emplace_back(op, std::move(operand));
+                    p = q;
+                }
+
+                result = ast::expression(std::move(first), std::move(rest));
+                return true;
+            }
+
+        private:
+            std::string const& input_;
+            char const* const begin_;
+            char const* const end_;
+
+            std::vector<std::size_t> line_starts_;
+            std::vector<std::size_t> annotations_;
+            bool has_unresolved_ids_;
+
+            std::string number_buffer_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<ast::expression> parse_recursive_descent(
+        std::string const& input)
+    {
+        return recursive_descent_parser(input).parse();
+    }
+}}}
@@ -8,11 +8,13 @@
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/dead_code_elimination.hpp>
 #include <phylanx/execution_tree/compiler_component.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 
 #include <hpx/modules/format.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
 
 #include <algorithm>
 #include <atomic>
@@ -57,6 +59,43 @@ namespace phylanx { namespace execution_tree
             return compiler::compile(
                 name, expr, snippets, env, patterns, default_locality);
         }
+
+        bool dead_code_elimination_enabled()
+        {
+            static bool const enable = hpx::get_config_entry(
+                "phylanx.dead_code_elimination", "1") != "0";
+            return enable;
+        }
+
+        // Dead define() and store() statements are removed before compiling
+        // unless disabled by setting phylanx.dead_code_elimination=0. The
+        // expressions are copied into 'storage' only if the pass is enabled.
+        std::vector<ast::expression> const& eliminate_dead_code(
+            std::vector<ast::expression> const& exprs,
+            compiler::expression_pattern_list const& patterns,
+            std::vector<ast::expression>& storage)
+        {
+            if (!dead_code_elimination_enabled())
+            {
+                return exprs;
+            }
+
+            storage = exprs;
+            compiler::eliminate_dead_code(storage, patterns);
+            return storage;
+        }
+
+        std::vector<ast::expression> const& eliminate_dead_code(
+            std::vector<ast::expression> const& exprs,
+            std::vector<ast::expression>& storage)
+        {
+            if (!dead_code_elimination_enabled())
+            {
+                return exprs;
+            }
+            return eliminate_dead_code(
+                exprs, compiler::generate_patterns(), storage);
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -68,7 +107,9 @@ namespace phylanx { namespace execution_tree
     {
         compiler::entry_point entry_point(func_name, name);
 
-        for (auto const& expr : exprs)
+        std::vector<ast::expression> storage;
+        for (auto const& expr :
+            detail::eliminate_dead_code(exprs, patterns, storage))
         {
             // always keep objects alive that are generated by the compiler
             entry_point.add_entry_point(detail::compile(
@@ -86,7 +127,8 @@ namespace phylanx { namespace execution_tree
     {
         compiler::entry_point entry_point(func_name, name);
 
-        for (auto const& expr : exprs)
+        std::vector<ast::expression> storage;
+        for (auto const& expr : detail::eliminate_dead_code(exprs, storage))
         {
             // always keep objects alive that are generated by the compiler
             entry_point.add_entry_point(
@@ -142,7 +184,8 @@ namespace phylanx { namespace execution_tree
 
         compiler::entry_point entry_point(func_name, name);
 
-        for (auto const& expr : exprs)
+        std::vector<ast::expression> storage;
+        for (auto const& expr : detail::eliminate_dead_code(exprs, storage))
         {
             // always keep objects alive that are generated by the compiler
             entry_point.add_entry_point(
@@ -27,6 +27,9 @@
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/thread_support/unlock_guard.hpp>
 
 #include <boost/fusion/include/std_pair.hpp>
 #include <boost/spirit/include/qi_attr.hpp>
@@ -36,12 +39,15 @@
 #include <boost/spirit/include/qi_sequence.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <limits>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -141,7 +147,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
         // parse an __arg(_1, _2) construct
         bool parse_argument_value(expression_pattern_list const& patterns,
             ast::expression const& expr, std::string& argname,
-            std::string& value)
+            ast::expression& value)
         {
             using placeholder_map_type =
                 std::multimap<std::string, ast::expression>;
@@ -177,11 +183,51 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             }
 
             argname = std::move(names.second);
-            value = to_string(p->second, true);
+            value = p->second;
+
+            return true;
+        }
+
+        bool parse_argument_value(expression_pattern_list const& patterns,
+            ast::expression const& expr, std::string& argname,
+            std::string& value)
+        {
+            ast::expression value_expr;
+            if (!parse_argument_value(patterns, expr, argname, value_expr))
+            {
+                return false;
+            }
 
+            value = to_string(value_expr, true);
             return true;
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Return the (memoized) AST of '<name>(__1_args)', which is used to
+        // extract the arguments of a pattern
+        ast::expression const& arguments_match_ast(std::string const& name)
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            static mutex_type mtx;
+            static std::map<std::string, ast::expression> asts;
+
+            std::unique_lock<mutex_type> l(mtx);
+
+            auto it = asts.find(name);
+            if (it == asts.end())
+            {
+                ast::expression expr;
+                {
+                    hpx::util::unlock_guard<std::unique_lock<mutex_type>> ul(l);
+                    expr = ast::generate_ast(
+                        hpx::util::format("{}(__1_args)", name))[0];
+                }
+                it = asts.emplace(name, std::move(expr)).first;
+            }
+            return it->second;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         bool extract_arguments(std::string const& name,
             expression_pattern_list const& patterns,
@@ -192,9 +238,8 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             using placeholder_map_type =
                 std::multimap<std::string, ast::expression>;
 
-            std::string match = hpx::util::format("{}(__1_args)", name);
             placeholder_map_type placeholders;
-            auto result = ast::match_ast(ast::generate_ast(match)[0], expr,
+            auto result = ast::match_ast(arguments_match_ast(name), expr,
                 ast::detail::on_placeholder_match{placeholders});
             if (!result)
                 return true;    // could be operator
@@ -301,6 +346,45 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             return pattern;
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Precompute the data used for dispatching expressions to the given
+        // pattern
+        expression_pattern precompile_pattern(expression_pattern&& p)
+        {
+            if (ast::detail::is_function_call(p.pattern_ast_))
+            {
+                p.is_function_call_ = true;
+
+                auto args = ast::detail::function_arguments(p.pattern_ast_);
+                p.num_fixed_args_ = args.size();
+                for (std::size_t i = 0; i != args.size(); ++i)
+                {
+                    if (ast::detail::is_placeholder_ellipses(args[i]))
+                    {
+                        p.has_variadics_ = true;
+                        p.num_fixed_args_ = i;
+                        break;
+                    }
+                }
+            }
+
+            // parse default values only once
+            p.default_asts_.reserve(p.defaults_.size());
+            for (auto const& value : p.defaults_)
+            {
+                if (value.empty())
+                {
+                    p.default_asts_.emplace_back();
+                }
+                else
+                {
+                    p.default_asts_.push_back(ast::generate_ast(value)[0]);
+                }
+            }
+
+            return std::move(p);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         void insert_pattern(expression_pattern_list& result,
             std::string pattern, match_pattern_type const& p,
@@ -332,11 +416,14 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             // reconstruct the pattern, if needed (leaving out default values)
             if (defaults.empty())
             {
+                expression_pattern ep{std::move(pattern), std::move(exprs[0]),
+                    p.create_primitive_, std::move(args), std::move(defaults)};
+                ep.is_pure_ = p.is_pure_;
+                ep.instance_creator_ = p.create_instance_;
+
                 result.insert(expression_pattern_list::value_type(
                     p.primitive_type_ + suffix,
-                    expression_pattern{std::move(pattern), std::move(exprs[0]),
-                        p.create_primitive_, std::move(args),
-                        std::move(defaults)}));
+                    precompile_pattern(std::move(ep))));
             }
             else
             {
@@ -349,11 +436,15 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                             args.size() - (i - 1));
                     exprs = ast::generate_ast(resulting_pattern);
 
+                    expression_pattern ep{std::move(resulting_pattern),
+                        std::move(exprs[0]), p.create_primitive_, args,
+                        defaults};
+                    ep.is_pure_ = p.is_pure_;
+                    ep.instance_creator_ = p.create_instance_;
+
                     result.insert(expression_pattern_list::value_type(
                         p.primitive_type_ + suffix,
-                        expression_pattern{std::move(resulting_pattern),
-                            std::move(exprs[0]), p.create_primitive_, args,
-                            defaults}));
+                        precompile_pattern(std::move(ep))));
                 }
             }
         }
@@ -397,6 +488,138 @@ namespace phylanx { namespace execution_tree { namespace compiler {
         return patterns;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail {
+        // Pure expressions with literal arguments are evaluated at compile
+        // time unless disabled by setting phylanx.constant_folding=0
+        bool enable_constant_folding()
+        {
+            static bool const enable =
+                hpx::get_config_entry("phylanx.constant_folding", "1") != "0";
+            return enable;
+        }
+
+        // Arrays with more elements than phylanx.constant_folding.max_size
+        // (default: 4096) are not created at compile time, they would be kept
+        // alive for as long as the compiled code exists
+        std::size_t constant_folding_max_size()
+        {
+            static std::size_t const max_size = std::stoul(
+                hpx::get_config_entry(
+                    "phylanx.constant_folding.max_size", "4096"));
+            return max_size;
+        }
+
+        // Estimate the number of elements of an array an expression with the
+        // given literal argument may create. Besides arrays, integers and
+        // lists of integers are taken into account as those may specify the
+        // shape of a newly created array (e.g. constant, full, or eye). This
+        // also keeps expressions involving large integer literals unfolded.
+        double literal_size(primitive_argument_type const& arg)
+        {
+            if (is_list_operand_strict(arg))
+            {
+                double size = 1.0;
+                for (auto const& elem : util::get<ir::range>(arg))
+                {
+                    size *= (std::max)(literal_size(elem), 1.0);
+                }
+                return size;
+            }
+
+            if (is_integer_operand_strict(arg) &&
+                extract_numeric_value_dimension(arg) == 0)
+            {
+                return std::abs(
+                    double(extract_scalar_integer_value_strict(arg)));
+            }
+
+            if (is_numeric_operand_strict(arg))
+            {
+                return double(extract_numeric_value_size(arg));
+            }
+            return 1.0;
+        }
+
+        // Return whether the given argument is known at compile time
+        bool is_constant_value(primitive_argument_type const& arg)
+        {
+            if (is_primitive_operand(arg) || is_dictionary_operand(arg))
+            {
+                return false;
+            }
+
+            if (is_list_operand_strict(arg))
+            {
+                for (auto const& elem : util::get<ir::range>(arg))
+                {
+                    if (!is_constant_value(elem))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Identical pure subexpressions share a single primitive instance if
+        // enabled by setting phylanx.cse=1
+        bool enable_cse()
+        {
+            static bool const enable =
+                hpx::get_config_entry("phylanx.cse", "0") != "0";
+            return enable;
+        }
+
+        hpx::naming::gid_type cse_key(primitive const& p)
+        {
+            return hpx::naming::detail::get_stripped_gid(p.get_id().get_gid());
+        }
+
+        // Structural signature of a scalar literal, empty for all other
+        // values (those are never shared)
+        std::string literal_signature(primitive_argument_type const& arg)
+        {
+            if (!valid(arg))
+            {
+                return is_implicit_nil(arg) ? "nil()" : "nil";
+            }
+
+            if (auto const* b =
+                    util::get_if<ir::node_data<std::uint8_t>>(&arg))
+            {
+                if (b->num_dimensions() == 0)
+                {
+                    return "b" + std::to_string(int(b->scalar()));
+                }
+            }
+            else if (auto const* i =
+                         util::get_if<ir::node_data<std::int64_t>>(&arg))
+            {
+                if (i->num_dimensions() == 0)
+                {
+                    return "i" + std::to_string(i->scalar());
+                }
+            }
+            else if (auto const* d =
+                         util::get_if<ir::node_data<double>>(&arg))
+            {
+                if (d->num_dimensions() == 0)
+                {
+                    // use the exact (hexadecimal) representation
+                    char buffer[64];
+                    std::snprintf(buffer, sizeof(buffer), "%a", d->scalar());
+                    return std::string("d") + buffer;
+                }
+            }
+            else if (auto const* str = util::get_if<std::string>(&arg))
+            {
+                return "s" + std::to_string(str->size()) + ":" + *str;
+            }
+            return std::string();
+        }
+    }    // namespace detail
+
     ///////////////////////////////////////////////////////////////////////////
     struct compiler_helper
     {
@@ -1194,8 +1417,24 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                     snippets_.compile_id_ - 1,
                     get_locality_id(default_locality_));
 
-                return (*cf)(
+                function f = (*cf)(
                     std::list<function>{}, std::move(name_parts), name_);
+
+                // accesses to the same variable are structurally identical
+                if (detail::enable_cse() && at != nullptr &&
+                    at->target_name_ == "access-variable")
+                {
+                    primitive const* var =
+                        util::get_if<primitive>(&at->f_.get().arg_);
+                    if (var != nullptr)
+                    {
+                        auto const key = detail::cse_key(*var);
+                        add_common_subexpression_node(f,
+                            "v" + std::to_string(key.get_msb()) + ":" +
+                                std::to_string(key.get_lsb()));
+                    }
+                }
+                return f;
             }
 
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
@@ -1353,11 +1592,9 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                         continue;    // skip arguments that have no default value
                     }
 
-                    ast::expression default_expr =
-                        ast::generate_ast(it->second.defaults_[default_arg])[0];
-
-                    fargs[base + pos] = compile(name_, default_expr, snippets_,
-                        env, patterns_, locality)
+                    fargs[base + pos] = compile(name_,
+                        it->second.default_asts_[default_arg], snippets_, env,
+                        patterns_, locality)
                                             .arg_;
                     args_valid[pos] = true;
                 }
@@ -1375,7 +1612,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                 {
                     // named argument
                     std::string argname;
-                    std::string value;
+                    ast::expression value;
 
                     if (detail::parse_argument_value(
                             patterns_, argexpr, argname, value))
@@ -1399,10 +1636,9 @@ namespace phylanx { namespace execution_tree { namespace compiler {
 
                         // place the keyword argument into the argument slot
                         // it belongs
-                        fargs[base + pos] =
-                            compile(name_, ast::generate_ast(value)[0],
-                                snippets_, env, patterns_, locality)
-                                .arg_;
+                        fargs[base + pos] = compile(name_, value, snippets_,
+                            env, patterns_, locality)
+                                                .arg_;
                         args_valid[pos] = true;
 
                         count = base + pos + 1;
@@ -1519,6 +1755,158 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                     name_, id));
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // common subexpression elimination
+
+        // Structural signature of an invocation of the given built-in
+        // function, empty if the expression can't be shared: the function
+        // has to be pure and all of its arguments have to be scalar literals,
+        // variable accesses, or (recursively) pure expressions.
+        std::string common_subexpression_signature(compiled_function const& cf,
+            std::string const& name, primitive_arguments_type const& fargs)
+        {
+            if (cf.target<builtin_function>() == nullptr)
+            {
+                return std::string();
+            }
+
+            auto it = patterns_.find(name);
+            if (it == patterns_.end() || !it->second.is_pure_)
+            {
+                return std::string();
+            }
+
+            auto const& nodes = snippets_.common_subexpressions_.nodes_;
+
+            std::string signature = name + "(";
+            for (auto const& arg : fargs)
+            {
+                std::string argsig;
+                if (primitive const* p = util::get_if<primitive>(&arg))
+                {
+                    auto node = nodes.find(detail::cse_key(*p));
+                    if (node != nodes.end())
+                    {
+                        argsig = node->second.signature_;
+                    }
+                }
+                else
+                {
+                    argsig = detail::literal_signature(arg);
+                }
+
+                if (argsig.empty())
+                {
+                    return std::string();
+                }
+
+                signature += argsig;
+                signature += ',';
+            }
+            signature += ')';
+
+            return signature;
+        }
+
+        // Count the references to shared nodes, enable memoization for nodes
+        // that are referenced more than once
+        void add_common_subexpression_references(
+            primitive_arguments_type const& fargs)
+        {
+            auto& nodes = snippets_.common_subexpressions_.nodes_;
+            for (auto const& arg : fargs)
+            {
+                primitive const* p = util::get_if<primitive>(&arg);
+                if (p == nullptr)
+                {
+                    continue;
+                }
+
+                auto node = nodes.find(detail::cse_key(*p));
+                if (node != nodes.end() && ++node->second.references_ == 2)
+                {
+                    p->enable_memoization();
+                }
+            }
+        }
+
+        void add_common_subexpression_node(
+            function const& f, std::string const& signature)
+        {
+            if (primitive const* p = util::get_if<primitive>(&f.arg_))
+            {
+                snippets_.common_subexpressions_.nodes_[detail::cse_key(*p)] =
+                    common_subexpressions::node_info{signature, 0};
+            }
+        }
+
+        void add_common_subexpression(
+            function const& f, std::string&& signature)
+        {
+            add_common_subexpression_node(f, signature);
+            snippets_.common_subexpressions_.expressions_.emplace(
+                std::move(signature), f);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // constant folding
+
+        // Evaluate an invocation of a pure built-in function whose arguments
+        // are all literals at compile time. The evaluation uses a local
+        // instance of the primitive which is not registered with AGAS. Any
+        // error is deferred to runtime by compiling the expression as usual.
+        bool fold_constant_expression(compiled_function const& cf,
+            std::string const& name, primitive_name_parts const& name_parts,
+            primitive_arguments_type const& fargs, function& result)
+        {
+            if (cf.target<builtin_function>() == nullptr)
+            {
+                return false;
+            }
+
+            auto it = patterns_.find(name);
+            if (it == patterns_.end() || !it->second.is_pure_ ||
+                it->second.instance_creator_ == nullptr)
+            {
+                return false;
+            }
+
+            double const max_size = double(detail::constant_folding_max_size());
+            for (auto const& arg : fargs)
+            {
+                if (!detail::is_constant_value(arg) ||
+                    detail::literal_size(arg) > max_size)
+                {
+                    return false;
+                }
+            }
+
+            try
+            {
+                auto p = (*it->second.instance_creator_)(
+                    primitive_arguments_type(fargs),
+                    compose_primitive_name(name_parts), name_);
+
+                primitive_argument_type value = extract_copy_value(
+                    p->eval(primitive_arguments_type{}, eval_context{}).get());
+
+                if (is_primitive_operand(value) ||
+                    detail::literal_size(value) > max_size)
+                {
+                    return false;
+                }
+
+                result = primitive_literal_value{}(std::move(value));
+                return true;
+            }
+            catch (...)
+            {
+                // report the error at runtime
+            }
+            return false;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
         function handle_placeholders(placeholder_map_type& placeholders,
             std::string const& name, ast::tagged id)
         {
@@ -1533,6 +1921,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             if (compiled_function* cf = env_.find(name))
             {
                 std::list<function> args;
+                std::string signature;
 
                 // we represent function calls with empty argument lists as
                 // a function call with a single nil argument to be able to
@@ -1555,6 +1944,36 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                     handle_function_call_argument(
                         name, fargs, argexprs, default_locality_, id);
 
+                    if (detail::enable_constant_folding())
+                    {
+                        function folded;
+                        if (fold_constant_expression(
+                                *cf, name, name_parts, fargs, folded))
+                        {
+                            return folded;
+                        }
+                    }
+
+                    if (detail::enable_cse())
+                    {
+                        // reuse the instance created for an identical pure
+                        // expression, if any
+                        signature =
+                            common_subexpression_signature(*cf, name, fargs);
+                        if (!signature.empty())
+                        {
+                            auto const& expressions =
+                                snippets_.common_subexpressions_.expressions_;
+                            auto it = expressions.find(signature);
+                            if (it != expressions.end())
+                            {
+                                return it->second;
+                            }
+                        }
+
+                        add_common_subexpression_references(fargs);
+                    }
+
                     for (auto&& arg : std::move(fargs))
                     {
                         args.emplace_back(std::move(arg));
@@ -1562,7 +1981,14 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                 }
 
                 // create primitive with given arguments
-                return (*cf)(std::move(args), std::move(name_parts), name_);
+                function f =
+                    (*cf)(std::move(args), std::move(name_parts), name_);
+
+                if (!signature.empty())
+                {
+                    add_common_subexpression(f, std::move(signature));
+                }
+                return f;
             }
 
             // otherwise the match was not complete, bail out
@@ -1671,10 +2097,20 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                     //     }
                     // }
 
-                    // handle all non-special functions
+                    // handle all non-special functions, consider only
+                    // patterns that accept the given number of arguments
+                    std::size_t num_args =
+                        ast::detail::function_argument_count(expr);
+
                     while (
                         cit != patterns_.end() && (*cit).first == function_name)
                     {
+                        if (!cit->second.matches_arity(num_args))
+                        {
+                            ++cit;
+                            continue;    // pattern can't match
+                        }
+
                         placeholder_map_type placeholders;
                         if (!ast::match_ast(expr, cit->second.pattern_ast_,
                                 ast::detail::on_placeholder_match{
@@ -1698,6 +2134,12 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                 // this should handle all remaining constructs (non-function calls)
                 for (auto const& pattern : patterns_)
                 {
+                    // function call patterns can't match other expressions
+                    if (pattern.second.is_function_call_)
+                    {
+                        continue;
+                    }
+
                     placeholder_map_type placeholders;
                     if (!ast::match_ast(expr, pattern.second.pattern_ast_,
                             ast::detail::on_placeholder_match{placeholders}))
@@ -0,0 +1,374 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/traverse.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/dead_code_elimination.hpp>
+#include <phylanx/util/variant.hpp>
+
+#include <hpx/include/util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::atomic<std::int64_t> dead_code_eliminated_count(0);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Return the function call the given statement consists of, if any
+        ast::function_call const* get_function_call(ast::expression const& expr)
+        {
+            if (!expr.rest.empty())
+            {
+                return nullptr;
+            }
+
+            auto const* pe = util::get_if<
+                util::recursive_wrapper<ast::primary_expr>>(&expr.first.get());
+            if (pe == nullptr)
+            {
+                return nullptr;
+            }
+
+            auto const* fc = util::get_if<
+                util::recursive_wrapper<ast::function_call>>(&pe->get().get());
+            return fc != nullptr ? &fc->get() : nullptr;
+        }
+
+        // Return the function call if the given statement is a define(x, ...)
+        // or a store(x, ...) for a plain variable x
+        ast::function_call const* get_variable_access(
+            ast::expression const& expr, char const* func, std::string& name)
+        {
+            ast::function_call const* fc = get_function_call(expr);
+            if (fc == nullptr || fc->function_name.name != func ||
+                fc->args.size() < 2 || !ast::detail::is_identifier(fc->args[0]))
+            {
+                return nullptr;
+            }
+
+            name = ast::detail::identifier_name(fc->args[0]);
+            return fc;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Count the number of references of each identifier
+        struct count_references
+        {
+            template <typename Ast>
+            bool operator()(Ast const&) const
+            {
+                return true;
+            }
+
+            bool operator()(ast::identifier const& id) const
+            {
+                ++references_[id.name];
+                return true;
+            }
+
+            std::map<std::string, std::size_t>& references_;
+        };
+
+        // Find references to the given identifier
+        struct find_reference
+        {
+            template <typename Ast>
+            bool operator()(Ast const&) const
+            {
+                return !found_;
+            }
+
+            bool operator()(ast::identifier const& id) const
+            {
+                if (id.name == name_)
+                {
+                    found_ = true;
+                }
+                return !found_;
+            }
+
+            std::string const& name_;
+            bool& found_;
+        };
+
+        // Verify that an expression invokes known primitives only. Pure
+        // expressions invoke side-effect free primitives only, all other
+        // expressions may additionally define and modify variables.
+        struct verify_calls
+        {
+            template <typename Ast>
+            bool operator()(Ast const&) const
+            {
+                return result_;
+            }
+
+            bool operator()(ast::expression const& expr) const
+            {
+                for (auto const& op : expr.rest)
+                {
+                    // assignment operators are not supported by PhySL
+                    if (ast::precedence_of(op.operator_) <= 2)
+                    {
+                        result_ = false;
+                    }
+                }
+                return result_;
+            }
+
+            bool operator()(ast::function_call const& fc) const
+            {
+                std::string const& name = fc.function_name.name;
+
+                // creating a lambda does not evaluate its body, the lambda
+                // itself can be invoked only by user-defined functions
+                if (name == "lambda")
+                {
+                    return false;
+                }
+
+                if (!pure_ &&
+                    (name == "block" || name == "define" || name == "store" ||
+                        name == "if" || name == "while"))
+                {
+                    return result_;
+                }
+
+                auto it = patterns_.find(name);
+                if (it == patterns_.end() || !it->second.is_pure_)
+                {
+                    result_ = false;
+                }
+                return result_;
+            }
+
+            expression_pattern_list const& patterns_;
+            bool pure_;
+            bool& result_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        class dead_code_elimination
+        {
+        public:
+            explicit dead_code_elimination(
+                    expression_pattern_list const& patterns)
+              : patterns_(patterns)
+            {}
+
+            void count_references(std::vector<ast::expression> const& exprs)
+            {
+                references_.clear();
+                ast::traverse(exprs, detail::count_references{references_});
+            }
+
+            std::size_t eliminate(ast::expression& expr) const
+            {
+                std::size_t removed = eliminate(expr.first);
+                for (auto& op : expr.rest)
+                {
+                    removed += eliminate(op.operand_);
+                }
+                return removed;
+            }
+
+        private:
+            std::size_t eliminate(ast::operand& op) const
+            {
+                if (auto* pe = util::get_if<
+                        util::recursive_wrapper<ast::primary_expr>>(&op.get()))
+                {
+                    return eliminate(pe->get());
+                }
+
+                if (auto* ue = util::get_if<
+                        util::recursive_wrapper<ast::unary_expr>>(&op.get()))
+                {
+                    return eliminate(ue->get().operand_);
+                }
+                return 0;
+            }
+
+            std::size_t eliminate(ast::primary_expr& pe) const
+            {
+                if (auto* expr = util::get_if<
+                        util::recursive_wrapper<ast::expression>>(&pe.get()))
+                {
+                    return eliminate(expr->get());
+                }
+
+                if (auto* fc = util::get_if<
+                        util::recursive_wrapper<ast::function_call>>(&pe.get()))
+                {
+                    return eliminate(fc->get());
+                }
+
+                if (auto* l = util::get_if<util::recursive_wrapper<
+                        std::vector<ast::expression>>>(&pe.get()))
+                {
+                    std::size_t removed = 0;
+                    for (auto& expr : l->get())
+                    {
+                        removed += eliminate(expr);
+                    }
+                    return removed;
+                }
+                return 0;
+            }
+
+            std::size_t eliminate(ast::function_call& fc) const
+            {
+                std::size_t removed = 0;
+                for (auto& arg : fc.args)
+                {
+                    removed += eliminate(arg);
+                }
+
+                if (fc.function_name.name == "block")
+                {
+                    removed += eliminate_statements(fc.args);
+                }
+                return removed;
+            }
+
+            // the last statement of a block determines its value and has to
+            // be kept
+            std::size_t eliminate_statements(
+                std::vector<ast::expression>& stmts) const
+            {
+                std::size_t removed = 0;
+                for (std::size_t i = 0; i + 1 < stmts.size(); /**/)
+                {
+                    if (is_unused_define(stmts[i]) || is_dead_store(stmts, i))
+                    {
+                        stmts.erase(stmts.begin() + i);
+                        ++removed;
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                return removed;
+            }
+
+            // define(x, ...) is dead if x is not referenced anywhere else
+            bool is_unused_define(ast::expression const& stmt) const
+            {
+                std::string name;
+                auto const* fc = get_variable_access(stmt, "define", name);
+                if (fc == nullptr)
+                {
+                    return false;
+                }
+
+                auto it = references_.find(name);
+                if (it == references_.end() || it->second != 1)
+                {
+                    return false;
+                }
+
+                // the body of a function definition is not evaluated
+                return fc->args.size() > 2 || verify_calls(fc->args[1], true);
+            }
+
+            // store(x, ...) is dead if it is followed by another store(x, ...)
+            // without x being read (or possibly read) in between
+            bool is_dead_store(
+                std::vector<ast::expression> const& stmts, std::size_t i) const
+            {
+                std::string name;
+                auto const* fc = get_variable_access(stmts[i], "store", name);
+                if (fc == nullptr || fc->args.size() != 2 ||
+                    !verify_calls(fc->args[1], true))
+                {
+                    return false;
+                }
+
+                for (std::size_t j = i + 1; j != stmts.size(); ++j)
+                {
+                    std::string next_name;
+                    auto const* next =
+                        get_variable_access(stmts[j], "store", next_name);
+                    if (next != nullptr && next->args.size() == 2 &&
+                        next_name == name)
+                    {
+                        return !references(next->args[1], name) &&
+                            verify_calls(next->args[1], false);
+                    }
+
+                    if (references(stmts[j], name) ||
+                        !verify_calls(stmts[j], false))
+                    {
+                        return false;
+                    }
+                }
+                return false;
+            }
+
+            bool verify_calls(ast::expression const& expr, bool pure) const
+            {
+                bool result = true;
+                ast::traverse(
+                    expr, detail::verify_calls{patterns_, pure, result});
+                return result;
+            }
+
+            static bool references(
+                ast::expression const& expr, std::string const& name)
+            {
+                bool found = false;
+                ast::traverse(expr, find_reference{name, found});
+                return found;
+            }
+
+            expression_pattern_list const& patterns_;
+            std::map<std::string, std::size_t> references_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t eliminate_dead_code(std::vector<ast::expression>& exprs,
+        expression_pattern_list const& patterns)
+    {
+        detail::dead_code_elimination dce(patterns);
+
+        // removing statements may turn other statements into dead code
+        std::size_t removed = 0;
+        std::size_t removed_now = 0;
+        do
+        {
+            dce.count_references(exprs);
+
+            removed_now = 0;
+            for (auto& expr : exprs)
+            {
+                removed_now += dce.eliminate(expr);
+            }
+            removed += removed_now;
+
+        } while (removed_now != 0);
+
+        detail::dead_code_eliminated_count += removed;
+        return removed;
+    }
+
+    std::int64_t dead_code_eliminated_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::dead_code_eliminated_count, reset);
+    }
+}}}
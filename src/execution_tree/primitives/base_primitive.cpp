@@ -13,6 +13,7 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/generate_error_message.hpp>
 #include <phylanx/util/repr_manip.hpp>
@@ -21,15 +22,21 @@
 #include <hpx/include/actions.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/include/serialization.hpp>
 #include <hpx/include/sync.hpp>
+#include <hpx/include/util.hpp>
 #include <hpx/modules/logging.hpp>
 #include <hpx/async_base/launch_policy.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iosfwd>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
@@ -127,6 +134,46 @@ namespace phylanx { namespace execution_tree
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // number of evaluations dispatched directly to a local component
+        // and through an action
+        static std::atomic<std::int64_t> local_eval_count(0);
+        static std::atomic<std::int64_t> action_eval_count(0);
+
+        // Evaluations of local components bypass the action machinery unless
+        // disabled by setting phylanx.local_eval=0
+        bool enable_local_eval()
+        {
+            static bool const enable =
+                hpx::get_config_entry("phylanx.local_eval", "1") != "0";
+            return enable;
+        }
+
+        template <typename F>
+        hpx::future<primitive_argument_type> local_eval(
+            primitives::primitive_component const& comp, F&& f)
+        {
+            ++local_eval_count;
+
+            hpx::launch policy = comp.select_eval_policy(hpx::launch::async);
+            if (policy == hpx::launch::sync)
+            {
+                try
+                {
+                    return f();
+                }
+                catch (...)
+                {
+                    return hpx::make_exceptional_future<
+                        primitive_argument_type>(std::current_exception());
+                }
+            }
+            return hpx::async(policy, std::forward<F>(f));
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive::primitive(hpx::future<hpx::id_type>&& fid,
             std::string const& name, bool register_with_agas)
@@ -134,13 +181,111 @@ namespace phylanx { namespace execution_tree
     {
         if (register_with_agas && !name.empty())
         {
-            this->base_type::register_as(name).get();
+            if (requires_agas_registration(name) || !register_locally(name))
+            {
+                this->base_type::register_as(name).get();
+            }
+        }
+    }
+
+    bool primitive::register_locally(std::string const& name) const
+    {
+        hpx::id_type const& id = this->base_type::get_id();
+        if (hpx::naming::get_locality_id_from_id(id) != hpx::get_locality_id())
+        {
+            return false;
+        }
+
+        hpx::error_code ec(hpx::lightweight);
+        auto comp = hpx::get_ptr<primitives::primitive_component>(
+            hpx::launch::sync, id, ec);
+        if (ec || !comp)
+        {
+            return false;
+        }
+
+        register_local_primitive(name, id, comp.get());
+
+        // the pinned component can be used for local evaluations right away
+        if (detail::enable_local_eval())
+        {
+            std::atomic_store(&local_component_, std::move(comp));
+        }
+        return true;
+    }
+
+    primitive::primitive(primitive const& rhs)
+      : base_type(rhs)
+      , local_component_(std::atomic_load(&rhs.local_component_))
+    {
+    }
+
+    primitive& primitive::operator=(primitive const& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->base_type::operator=(rhs);
+            std::atomic_store(&local_component_,
+                std::atomic_load(&rhs.local_component_));
+        }
+        return *this;
+    }
+
+    std::int64_t primitive::local_eval_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(detail::local_eval_count, reset);
+    }
+
+    std::int64_t primitive::action_eval_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::action_eval_count, reset);
+    }
+
+    std::shared_ptr<primitives::primitive_component>
+    primitive::local_component() const
+    {
+        auto comp = std::atomic_load(&local_component_);
+        if (comp || !detail::enable_local_eval())
+        {
+            return comp;
+        }
+
+        hpx::id_type const& id = this->base_type::get_id();
+        if (hpx::naming::get_locality_id_from_id(id) != hpx::get_locality_id())
+        {
+            return comp;
+        }
+
+        // pin the component, this keeps it alive and in place for as long as
+        // the pointer is held
+        hpx::error_code ec(hpx::lightweight);
+        comp = hpx::get_ptr<primitives::primitive_component>(
+            hpx::launch::sync, id, ec);
+        if (!ec && comp)
+        {
+            std::atomic_store(&local_component_, comp);
         }
+        return comp;
     }
 
     hpx::future<primitive_argument_type> primitive::eval(
         primitive_arguments_type const& params, eval_context ctx) const
     {
+        if (auto comp = local_component())
+        {
+            primitives::primitive_component const& c = *comp;
+            hpx::future<primitive_argument_type> f = detail::local_eval(c,
+                [comp = std::move(comp), params, ctx = std::move(ctx)]()
+                    mutable
+                {
+                    return comp->eval(params, std::move(ctx));
+                });
+            return detail::lazy_trace("eval", *this, std::move(f));
+        }
+
+        ++detail::action_eval_count;
+
         using action_type = primitives::primitive_component::eval_action;
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::unwrap_result(this->base_type::get_id()), params,
@@ -150,6 +295,20 @@ namespace phylanx { namespace execution_tree
     hpx::future<primitive_argument_type> primitive::eval(
         primitive_arguments_type&& params, eval_context ctx) const
     {
+        if (auto comp = local_component())
+        {
+            primitives::primitive_component const& c = *comp;
+            hpx::future<primitive_argument_type> f = detail::local_eval(c,
+                [comp = std::move(comp), params = std::move(params),
+                    ctx = std::move(ctx)]() mutable
+                {
+                    return comp->eval(params, std::move(ctx));
+                });
+            return detail::lazy_trace("eval", *this, std::move(f));
+        }
+
+        ++detail::action_eval_count;
+
         using action_type = primitives::primitive_component::eval_action;
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::unwrap_result(this->base_type::get_id()), std::move(params),
@@ -160,6 +319,20 @@ namespace phylanx { namespace execution_tree
     hpx::future<primitive_argument_type> primitive::eval(
         primitive_argument_type && param, eval_context ctx) const
     {
+        if (auto comp = local_component())
+        {
+            primitives::primitive_component const& c = *comp;
+            hpx::future<primitive_argument_type> f = detail::local_eval(c,
+                [comp = std::move(comp), param = std::move(param),
+                    ctx = std::move(ctx)]() mutable
+                {
+                    return comp->eval_single(std::move(param), std::move(ctx));
+                });
+            return detail::lazy_trace("eval", *this, std::move(f));
+        }
+
+        ++detail::action_eval_count;
+
         using action_type = primitives::primitive_component::eval_single_action;
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::unwrap_result(this->base_type::get_id()), std::move(param),
@@ -176,6 +349,16 @@ namespace phylanx { namespace execution_tree
     primitive_argument_type primitive::eval(hpx::launch::sync_policy,
         primitive_arguments_type const& params, eval_context ctx) const
     {
+        if (auto comp = local_component())
+        {
+            // the arguments can be referenced as we wait for the result
+            hpx::future<primitive_argument_type> f = detail::local_eval(
+                *comp, [&]() { return comp->eval(params, std::move(ctx)); });
+            return detail::trace("eval", *this, f.get());
+        }
+
+        ++detail::action_eval_count;
+
         using action_type = primitives::primitive_component::eval_action;
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::launch::sync, hpx::unwrap_result(this->base_type::get_id()),
@@ -185,6 +368,16 @@ namespace phylanx { namespace execution_tree
     primitive_argument_type primitive::eval(hpx::launch::sync_policy,
         primitive_arguments_type&& params, eval_context ctx) const
     {
+        if (auto comp = local_component())
+        {
+            // the arguments can be referenced as we wait for the result
+            hpx::future<primitive_argument_type> f = detail::local_eval(
+                *comp, [&]() { return comp->eval(params, std::move(ctx)); });
+            return detail::trace("eval", *this, f.get());
+        }
+
+        ++detail::action_eval_count;
+
         using action_type = primitives::primitive_component::eval_action;
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::launch::sync, hpx::unwrap_result(this->base_type::get_id()),
@@ -195,6 +388,18 @@ namespace phylanx { namespace execution_tree
     primitive_argument_type primitive::eval(hpx::launch::sync_policy,
         primitive_argument_type && param, eval_context ctx) const
     {
+        if (auto comp = local_component())
+        {
+            // the argument can be referenced as we wait for the result
+            hpx::future<primitive_argument_type> f =
+                detail::local_eval(*comp, [&]() {
+                    return comp->eval_single(std::move(param), std::move(ctx));
+                });
+            return detail::trace("eval", *this, f.get());
+        }
+
+        ++detail::action_eval_count;
+
         using action_type = primitives::primitive_component::eval_single_action;
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::launch::sync, hpx::unwrap_result(this->base_type::get_id()),
@@ -205,8 +410,18 @@ namespace phylanx { namespace execution_tree
     primitive_argument_type primitive::eval(hpx::launch::sync_policy,
         eval_context ctx) const
     {
-        using action_type = primitives::primitive_component::eval_action;
         static primitive_arguments_type params;
+        if (auto comp = local_component())
+        {
+            // the arguments can be referenced as we wait for the result
+            hpx::future<primitive_argument_type> f = detail::local_eval(
+                *comp, [&]() { return comp->eval(params, std::move(ctx)); });
+            return detail::trace("eval", *this, f.get());
+        }
+
+        ++detail::action_eval_count;
+
+        using action_type = primitives::primitive_component::eval_action;
         hpx::future<primitive_argument_type> f = hpx::sync<action_type>(
             this->base_type::get_id(), std::move(params), std::move(ctx));
         return detail::trace("eval", *this, f.get());
@@ -317,6 +532,16 @@ namespace phylanx { namespace execution_tree
                 this->base_type::get_id(), std::move(params), std::move(ctx)));
     }
 
+    bool primitive::enable_memoization() const
+    {
+        if (auto comp = local_component())
+        {
+            comp->enable_memoization();
+            return true;
+        }
+        return false;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // traverse expression-tree topology and generate Newick representation
     namespace detail
@@ -13,6 +13,8 @@
 #include <hpx/allocator_support/internal_allocator.hpp>
 #include <hpx/include/serialization.hpp>
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -24,6 +26,22 @@ namespace phylanx { namespace execution_tree
     ///////////////////////////////////////////////////////////////////////////
     hpx::util::internal_allocator<variable_frame> eval_context::alloc_;
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::atomic<std::size_t> variable_generation(0);
+    }
+
+    std::size_t variable_generation() noexcept
+    {
+        return detail::variable_generation.load(std::memory_order_acquire);
+    }
+
+    void next_variable_generation() noexcept
+    {
+        detail::variable_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     void topology::serialize(hpx::serialization::output_archive& ar, unsigned)
     {
@@ -7,6 +7,7 @@
 #include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
 
 #include <hpx/include/actions.hpp>
 #include <hpx/include/components.hpp>
@@ -106,6 +107,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return (*it).second(std::move(args), name, codename);
     }
 
+    primitive_component::~primitive_component()
+    {
+        if (primitive_ && !primitive_->name_.empty())
+        {
+            unregister_local_primitive(primitive_->name_, this);
+        }
+    }
+
     // eval_action
     hpx::future<primitive_argument_type> primitive_component::eval(
         primitive_arguments_type const& params,
@@ -193,6 +202,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_->enable_measurements();
     }
 
+    void primitive_component::enable_memoization()
+    {
+        primitive_->enable_memoization();
+    }
+
     hpx::launch primitive_component::select_direct_execution(
         primitive_component::eval_action, hpx::launch policy,
         hpx::naming::address_type lva)
@@ -215,6 +229,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ->select_direct_eval_policy_thres(policy);
 #else
         return this_->primitive_->select_direct_eval_execution(policy);
+#endif
+    }
+
+    hpx::launch primitive_component::select_eval_policy(
+        hpx::launch policy) const
+    {
+#if defined(PHYLANX_HAVE_TASK_INLINING_POLICY) && defined(HPX_HAVE_APEX)
+        return primitive_->select_direct_eval_policy_thres(policy);
+#else
+        return primitive_->select_direct_eval_execution(policy);
 #endif
     }
 }}}
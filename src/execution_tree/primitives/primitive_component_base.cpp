@@ -15,10 +15,15 @@
 #include <hpx/include/util.hpp>
 #include <hpx/modules/naming.hpp>
 #include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/synchronization/spinlock.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -98,10 +103,123 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::forward<T>(t));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::atomic<std::int64_t> memoized_eval_count(0);
+    }
+
+    std::int64_t primitive_component_base::memoized_eval_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::memoized_eval_count, reset);
+    }
+
+    // The result of the most recent evaluation of a memoized primitive. It is
+    // valid for the variable frame, the evaluation mode, and the variable
+    // generation it was computed for.
+    struct primitive_component_base::memoized_result
+    {
+        using mutex_type = hpx::lcos::local::spinlock;
+        using promise_type =
+            hpx::lcos::local::promise<primitive_argument_type>;
+
+        // Return true if the result for the given context is (or is being)
+        // computed already. Otherwise, the calling evaluation becomes
+        // responsible for computing the result and is handed the promise to
+        // make it available to others.
+        bool lookup(eval_context const& ctx,
+            hpx::shared_future<primitive_argument_type>& result,
+            std::shared_ptr<promise_type>& p)
+        {
+            std::size_t const generation = variable_generation();
+
+            std::lock_guard<mutex_type> l(mtx_);
+            if (result_.valid() && generation_ == generation &&
+                mode_ == ctx.mode_ && frame_.lock() == ctx.frame())
+            {
+                ++detail::memoized_eval_count;
+                result = result_;
+                return true;
+            }
+
+            p = std::make_shared<promise_type>();
+            result_ = p->get_shared_future();
+            generation_ = generation;
+            mode_ = ctx.mode_;
+            frame_ = ctx.frame();
+
+            result = result_;
+            return false;
+        }
+
+        mutex_type mtx_;
+        hpx::shared_future<primitive_argument_type> result_;
+        std::size_t generation_ = 0;
+        eval_mode mode_ = eval_default;
+        std::weak_ptr<variable_frame> frame_;
+    };
+
+    void primitive_component_base::enable_memoization()
+    {
+        if (!memoized_)
+        {
+            memoized_ = std::make_shared<memoized_result>();
+        }
+    }
+
+    namespace detail
+    {
+        // Hand out references to the memoized value, it is owned by the
+        // shared state
+        hpx::future<primitive_argument_type> memoized_value(
+            hpx::shared_future<primitive_argument_type> const& result)
+        {
+            return result.then(hpx::launch::sync,
+                [](hpx::shared_future<primitive_argument_type> const& f)
+                -> primitive_argument_type
+                {
+                    primitive_argument_type const& val = f.get();
+                    if (is_primitive_operand(val))
+                    {
+                        return val;
+                    }
+                    return extract_ref_value(val);
+                });
+        }
+
+        void set_memoized_value(
+            std::shared_ptr<hpx::lcos::local::promise<primitive_argument_type>>
+                p,
+            hpx::future<primitive_argument_type>&& f)
+        {
+            f.then(hpx::launch::sync,
+                [p = std::move(p)](hpx::future<primitive_argument_type>&& f)
+                {
+                    try
+                    {
+                        p->set_value(f.get());
+                    }
+                    catch (...)
+                    {
+                        p->set_exception(std::current_exception());
+                    }
+                });
+        }
+    }
+
     hpx::future<primitive_argument_type> primitive_component_base::do_eval(
         primitive_arguments_type const& params,
         eval_context ctx) const
     {
+        // a memoized primitive is evaluated only if no valid result exists
+        hpx::shared_future<primitive_argument_type> memoized;
+        std::shared_ptr<memoized_result::promise_type> p;
+        if (memoized_ && memoized_->lookup(ctx, memoized, p))
+        {
+            return detail::memoized_value(memoized);
+        }
+
 #if defined(HPX_HAVE_APEX)
         hpx::util::annotate_function annotate(eval_name_.c_str());
 #endif
@@ -128,12 +246,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
             state->set_on_completed(keep_alive(std::move(timer)));
         }
 
+        if (p)
+        {
+            detail::set_memoized_value(std::move(p), std::move(f));
+            return detail::memoized_value(memoized);
+        }
         return f;
     }
 
     hpx::future<primitive_argument_type> primitive_component_base::do_eval(
         primitive_argument_type&& param, eval_context ctx) const
     {
+        // a memoized primitive is evaluated only if no valid result exists
+        hpx::shared_future<primitive_argument_type> memoized;
+        std::shared_ptr<memoized_result::promise_type> p;
+        if (memoized_ && memoized_->lookup(ctx, memoized, p))
+        {
+            return detail::memoized_value(memoized);
+        }
+
 #if defined(HPX_HAVE_APEX)
         hpx::util::annotate_function annotate(eval_name_.c_str());
 #endif
@@ -160,6 +291,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             state->set_on_completed(keep_alive(std::move(timer)));
         }
 
+        if (p)
+        {
+            detail::set_memoized_value(std::move(p), std::move(f));
+            return detail::memoized_value(memoized);
+        }
         return f;
     }
 
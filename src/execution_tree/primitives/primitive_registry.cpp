@@ -0,0 +1,185 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
+
+#include <hpx/include/agas.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct local_primitive_entry
+        {
+            hpx::id_type id_;
+            primitives::primitive_component const* component_;
+        };
+
+        struct local_primitive_registry
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            mutex_type mtx_;
+            std::map<std::string, local_primitive_entry> entries_;
+        };
+
+        local_primitive_registry& get_local_primitive_registry()
+        {
+            static local_primitive_registry registry;
+            return registry;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        bool register_defined_entities_only()
+        {
+            static bool const defined_only =
+                hpx::get_config_entry("phylanx.agas_registration", "all") ==
+                "defined";
+            return defined_only;
+        }
+
+        // simple wildcard matching, '*' matches any sequence of characters
+        bool match_primitive_name(
+            std::string const& pattern, std::string const& name)
+        {
+            std::size_t p = 0, n = 0;
+            std::size_t star = std::string::npos, mark = 0;
+
+            while (n != name.size())
+            {
+                if (p != pattern.size() && pattern[p] == '*')
+                {
+                    star = p++;
+                    mark = n;
+                }
+                else if (p != pattern.size() && pattern[p] == name[n])
+                {
+                    ++p;
+                    ++n;
+                }
+                else if (star != std::string::npos)
+                {
+                    p = star + 1;
+                    n = ++mark;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            while (p != pattern.size() && pattern[p] == '*')
+            {
+                ++p;
+            }
+            return p == pattern.size();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool requires_agas_registration(std::string const& name)
+    {
+        if (!detail::register_defined_entities_only())
+        {
+            return true;
+        }
+
+        // names not generated by the compiler are always registered
+        compiler::primitive_name_parts parts;
+        if (!compiler::parse_primitive_name(name, parts))
+        {
+            return true;
+        }
+
+        return parts.primitive == "variable" ||
+            parts.primitive == "global_variable" ||
+            parts.primitive == "function" ||
+            parts.primitive == "define-variable" ||
+            parts.primitive == "define-global-variable";
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void register_local_primitive(std::string const& name,
+        hpx::id_type const& id, primitives::primitive_component const* p)
+    {
+        // the registry must not keep the component alive
+        hpx::id_type unmanaged_id(id.get_gid(), hpx::id_type::unmanaged);
+
+        auto& registry = detail::get_local_primitive_registry();
+
+        std::lock_guard<detail::local_primitive_registry::mutex_type> l(
+            registry.mtx_);
+        registry.entries_[name] =
+            detail::local_primitive_entry{std::move(unmanaged_id), p};
+    }
+
+    void unregister_local_primitive(
+        std::string const& name, primitives::primitive_component const* p)
+    {
+        auto& registry = detail::get_local_primitive_registry();
+
+        std::lock_guard<detail::local_primitive_registry::mutex_type> l(
+            registry.mtx_);
+
+        auto it = registry.entries_.find(name);
+        if (it != registry.entries_.end() && it->second.component_ == p)
+        {
+            registry.entries_.erase(it);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::id_type resolve_primitive_name(std::string const& name)
+    {
+        {
+            auto& registry = detail::get_local_primitive_registry();
+
+            std::lock_guard<detail::local_primitive_registry::mutex_type> l(
+                registry.mtx_);
+
+            auto it = registry.entries_.find(name);
+            if (it != registry.entries_.end())
+            {
+                return it->second.id_;
+            }
+        }
+
+        return hpx::agas::resolve_name(hpx::launch::sync, name);
+    }
+
+    std::map<std::string, hpx::id_type> find_primitives(
+        std::string const& pattern)
+    {
+        std::map<std::string, hpx::id_type> result =
+            hpx::agas::find_symbols(hpx::launch::sync, pattern);
+
+        auto& registry = detail::get_local_primitive_registry();
+
+        std::lock_guard<detail::local_primitive_registry::mutex_type> l(
+            registry.mtx_);
+
+        for (auto const& entry : registry.entries_)
+        {
+            if (detail::match_primitive_name(pattern, entry.first))
+            {
+                result.emplace(entry.first, entry.second.id_);
+            }
+        }
+        return result;
+    }
+}}
@@ -277,6 +277,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             bound_value_ = extract_ref_value(operands_[0], name_, codename_);
         }
 
+        // invalidate all memoized evaluation results
+        next_variable_generation();
+
         return true;
     }
 
@@ -343,9 +346,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 
     ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Advance the variable generation once the new value has been stored,
+        // otherwise a concurrent evaluation could memoize a result computed
+        // from the old value for the new generation.
+        struct next_variable_generation_on_exit
+        {
+            ~next_variable_generation_on_exit()
+            {
+                next_variable_generation();
+            }
+        };
+    }
+
     void variable::store(primitive_arguments_type&& data,
         primitive_arguments_type&& params, eval_context ctx)
     {
+        // invalidate all memoized evaluation results
+        detail::next_variable_generation_on_exit on_exit;
+
         // data[0] is the new value to store in this variable
         // data[1] and optionally data[2]/data[3] are interpreted as slicing
         // arguments
@@ -410,6 +430,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
     void variable::store(primitive_argument_type&& data,
         primitive_arguments_type&& params, eval_context ctx)
     {
+        // invalidate all memoized evaluation results
+        detail::next_variable_generation_on_exit on_exit;
+
         // data is the new value to store in this variable
         if (!valid(data))
         {
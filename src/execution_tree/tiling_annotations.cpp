@@ -10,9 +10,12 @@
 
 #include <hpx/assert.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
 #include <hpx/modules/format.hpp>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -269,5 +272,44 @@ namespace phylanx { namespace execution_tree
         spans_[1] = spans[1];
         spans_[2] = spans[2];
     }
+
+    ////////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::atomic<std::int64_t> retile_plans_computed(0);
+        static std::atomic<std::int64_t> retile_plans_reused(0);
+
+        void count_retile_plan(bool reused)
+        {
+            if (reused)
+            {
+                ++retile_plans_reused;
+            }
+            else
+            {
+                ++retile_plans_computed;
+            }
+        }
+
+        std::size_t retile_plan_cache_capacity()
+        {
+            static std::size_t const capacity = std::stoul(
+                hpx::get_config_entry(
+                    "phylanx.retile.plan_cache_size", "16"));
+            return capacity;
+        }
+    }
+
+    std::int64_t retile_plans_computed(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::retile_plans_computed, reset);
+    }
+
+    std::int64_t retile_plans_reused(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::retile_plans_reused, reset);
+    }
 }}
 
@@ -6,9 +6,15 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compiler/dead_code_elimination.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/compression.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
 
 #include <hpx/include/agas.hpp>
 #include <hpx/include/components.hpp>
@@ -129,7 +135,7 @@ namespace phylanx { namespace performance_counters {
             // Structure of primitives in symbolic namespace:
             // /phylanx$<locality_id>/<primitive>$<sequence-nr>[$<instance>]/
             //      <compile_id>$<tag>
-            auto entries = hpx::agas::find_symbols(hpx::launch::sync,
+            auto entries = phylanx::execution_tree::find_primitives(
                 hpx::util::format("/phylanx${}/{}$*", hpx::get_locality_id(),
                     detail::extract_primitive_type(info_)));
 
@@ -295,7 +301,7 @@ namespace phylanx { namespace performance_counters {
             // Structure of primitives in symbolic namespace:
             // /phylanx$<locality_id>/<primitive>$<sequence-nr>[$<instance>]/
             //      <compile_id>$<tag>
-            auto entries = hpx::agas::find_symbols(hpx::launch::sync,
+            auto entries = phylanx::execution_tree::find_primitives(
                 hpx::util::format("/phylanx${}/{}$*", hpx::get_locality_id(),
                     detail::extract_primitive_type(info_)));
 
@@ -452,7 +458,7 @@ namespace phylanx { namespace performance_counters {
             // Structure of primitives in symbolic namespace:
             // /phylanx$<locality_id>/<primitive>$<sequence-nr>[$<instance>]/
             //      <compile_id>$<tag>
-            auto entries = hpx::agas::find_symbols(hpx::launch::sync,
+            auto entries = phylanx::execution_tree::find_primitives(
                 hpx::util::format("/phylanx${}/{}$*", hpx::get_locality_id(),
                     detail::extract_primitive_type(info_)));
 
@@ -584,6 +590,66 @@ namespace phylanx { namespace performance_counters {
             "returns the current value of the move-assignment count of "
             "any node_data<double>");
 
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/eval/count/local",
+            &execution_tree::primitive::local_eval_count,
+            "returns the number of primitive evaluations that were "
+            "dispatched directly to a local component");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/eval/count/action",
+            &execution_tree::primitive::action_eval_count,
+            "returns the number of primitive evaluations that were "
+            "dispatched through an action");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/eval/count/memoized",
+            &execution_tree::primitives::primitive_component_base::
+                memoized_eval_count,
+            "returns the number of primitive evaluations that were "
+            "satisfied by a memoized result of a shared subexpression");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compiler/count/dead_code",
+            &execution_tree::compiler::dead_code_eliminated_count,
+            "returns the number of define() and store() statements removed "
+            "by the compiler as dead code");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compression/bytes/uncompressed",
+            &util::compression_bytes_uncompressed,
+            "returns the number of bytes of all compressed tiles sent "
+            "between localities (before compression)");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/compression/bytes/compressed",
+            &util::compression_bytes_compressed,
+            "returns the number of bytes of all compressed tiles sent "
+            "between localities (after compression)");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/distributed_matrix/count/prefetch_hits",
+            &util::prefetch_cache_hits,
+            "returns the number of fetched matrix parts that were satisfied "
+            "by a part prefetched earlier");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/distributed_matrix/count/prefetch_misses",
+            &util::prefetch_cache_misses,
+            "returns the number of fetched matrix parts that were not "
+            "prefetched earlier");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/retile/count/plans_computed",
+            &execution_tree::retile_plans_computed,
+            "returns the number of redistribution plans computed by retile_d");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/retile/count/plans_reused",
+            &execution_tree::retile_plans_reused,
+            "returns the number of retile_d invocations that reused a cached "
+            "redistribution plan");
+
         // Iterate and register a time and count performance counter per each
         // primitive
         namespace et = phylanx::execution_tree;
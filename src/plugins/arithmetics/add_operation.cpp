@@ -55,7 +55,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The sum of all addends.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
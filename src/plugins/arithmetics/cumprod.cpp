@@ -41,7 +41,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             Returns:
 
-            Return the cumulative product of the elements along a given axis.)"
+            Return the cumulative product of the elements along a given axis.)",
+            false,    // supports dtype
+            true      // pure
         }
     };
 
@@ -38,7 +38,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             Returns:
 
-            Return the cumulative sum of the elements along a given axis.)"
+            Return the cumulative sum of the elements along a given axis.)",
+            false,    // supports dtype
+            true      // pure
         }
     };
 
@@ -85,7 +85,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The result of dividing all arguments.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
@@ -43,7 +43,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             "Returns:\n"                                                       \
             "\n"                                                               \
             "This function implements function `" name "` from Python's "      \
-            "math library."                                                    \
+            "math library.",                                                   \
+            false,    /* supports dtype */                                     \
+            true      /* pure */                                               \
     }                                                                          \
     /**/
 
@@ -43,7 +43,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             "\n"                                                               \
             "This function implements function `" name "` from Python's "      \
             "math library.",                                                   \
-            true                                                               \
+            true,    /* supports dtype */                                      \
+            true     /* pure */                                                \
     }                                                                          \
     /**/
 
@@ -58,7 +58,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The element-wise maximum of all input arrays.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
@@ -35,7 +35,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The remainder of the division.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
@@ -124,7 +124,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The product of all factors.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
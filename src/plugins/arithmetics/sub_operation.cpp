@@ -50,7 +50,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The difference of all arguments.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
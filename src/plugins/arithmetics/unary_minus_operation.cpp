@@ -40,7 +40,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The negated value arg.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
@@ -7,6 +7,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/locality_annotation.hpp>
 #include <phylanx/execution_tree/localities_annotation.hpp>
 #include <phylanx/execution_tree/meta_annotation.hpp>
@@ -15,10 +16,10 @@
 #include <phylanx/execution_tree/tiling_annotations.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/dist_matrixops/all_gather.hpp>
+#include <phylanx/util/collectives.hpp>
 #include <phylanx/util/distributed_matrix.hpp>
 #include <phylanx/util/generate_error_message.hpp>
 
-
 #include <hpx/assert.hpp>
 #include <hpx/errors/throw_exception.hpp>
 #include <hpx/include/lcos.hpp>
@@ -26,8 +27,6 @@
 #include <hpx/include/util.hpp>
 #include <hpx/modules/collectives.hpp>
 
-
-#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -40,9 +39,11 @@
 namespace phylanx { namespace dist_matrixops { namespace primitives
 {
     ///////////////////////////////////////////////////////////////////////////
-    execution_tree::match_pattern_type const all_gather::match_data =
+    std::vector<execution_tree::match_pattern_type> const
+        all_gather::match_data =
     {
-        hpx::make_tuple("all_gather_d", std::vector<std::string>{R"(
+        execution_tree::match_pattern_type{"all_gather_d",
+            std::vector<std::string>{R"(
                 all_gather_d(
                     _1_local_result
                 )
@@ -58,221 +59,170 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
 
                 A future holding a 2-D array with all values send
                     by all participating localities.)"
-            )
+            },
+
+        execution_tree::match_pattern_type{"gather_d",
+            std::vector<std::string>{R"(
+                gather_d(
+                    _1_local_result,
+                    __arg(_2_root, 0)
+                )
+            )"},
+            &create_gather,
+            &execution_tree::create_primitive<all_gather>, R"(
+            local_result, root
+            Args:
+
+                local_result (array) : a distributed array. A vector or matrix.
+                root (int, optional) : the locality the array is gathered
+                    on, defaults to zero.
+
+            Returns:
+
+                A future holding a 2-D array with all values send by all
+                    participating localities on the root locality, all
+                    other localities return their local_result unchanged.)"
+            }
     };
 
     ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        bool extract_gather_to_root(std::string const& name)
+        {
+            execution_tree::compiler::primitive_name_parts name_parts;
+            if (execution_tree::compiler::parse_primitive_name(
+                    name, name_parts))
+            {
+                return name_parts.primitive == "gather_d";
+            }
+            return name == "gather_d";
+        }
+    }
+
     all_gather::all_gather(
         execution_tree::primitive_arguments_type&& operands,
         std::string const& name, std::string const& codename)
       : primitive_component_base(std::move(operands), name, codename)
+      , gather_to_root_(detail::extract_gather_to_root(name))
     {}
 
     ///////////////////////////////////////////////////////////////////////////
-    namespace detail
+    template <typename T>
+    execution_tree::primitive_argument_type all_gather::all_gather2d(
+        ir::node_data<T>&& arr,
+        execution_tree::localities_information&& locs, std::int64_t root,
+        execution_tree::primitive_argument_type::annotation_ptr&& ann) const
     {
-        template <typename T>
-        execution_tree::primitive_argument_type concatenate2d_axis0(
-            execution_tree::primitive_arguments_type&& args,
-            std::string const& name, std::string const& codename)
-        {
-            std::size_t args_size = args.size();
-            std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> prevdim =
-                extract_numeric_value_dimensions(args[0], name, codename);
-            std::size_t total_rows = 0;
-            for (std::size_t i = 0; i != args_size; ++i)
-            {
-                if (extract_numeric_value_dimension(args[i],
-                    name, codename) != 2)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "dist_matrixops::primitives::all_gather::"
-                        "detail::concatenate2d_axis0",
-                        util::generate_error_message(
-                            "all the input arrays must have "
-                            "the same number of dimensions", name, codename));
-                }
+        using namespace execution_tree;
 
-                std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> dim =
-                    extract_numeric_value_dimensions(args[i], name, codename);
+        std::uint32_t const loc_id = locs.locality_.locality_id_;
+        std::uint32_t const num_localities = locs.locality_.num_localities_;
 
-                if (i != 0 && prevdim[1] != dim[1])
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "dist_matrixops::primitives::"
-                        "all_gather::detail::concatenate2d_axis0",
-                        util::generate_error_message(
-                            "all the input array dimensions except for "
-                            "the concatenation axis must match exactly ",
-                            name, codename));
-                }
+        if (root >= std::int64_t(num_localities))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "all_gather::all_gather2d",
+                generate_error_message(
+                    "the root locality is out of the range of the "
+                    "participating localities"));
+        }
 
-                total_rows += dim[0];
-                prevdim = dim;
-            }
-            blaze::DynamicMatrix<T> result(total_rows, prevdim[1]);
-            std::size_t step = 0;
-            for (auto&& arg : args)
-            {
-                auto&& val =
-                    execution_tree::extract_node_data<T>(std::move(arg));
-                std::size_t num_rows = val.dimension(0);
-                auto m = val.matrix();
-                blaze::submatrix(
-                    result, step, 0, num_rows, prevdim[1]) = m;
-                step += num_rows;
+        // row and column dimensions of the whole array
+        std::size_t const rows_dim = locs.rows(name_, codename_);
+        std::size_t const cols_dim = locs.columns(name_, codename_);
 
+        for (auto const& tile : locs.tiles_)
+        {
+            if (tile.spans_[0].stop_ > std::int64_t(rows_dim) ||
+                tile.spans_[1].stop_ > std::int64_t(cols_dim))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "all_gather::all_gather2d",
+                    generate_error_message(
+                        "the tiles of the array exceed its dimensions"));
             }
-            return execution_tree::primitive_argument_type{
-                ir::node_data<T>{std::move(result)}};
         }
 
-        template <typename T>
-        execution_tree::primitive_argument_type concatenate2d_axis1(
-            execution_tree::primitive_arguments_type&& args,
-            std::string const& name, std::string const& codename)
-        {
-            std::size_t args_size = args.size();
+        bool const receive = root == -1 || root == std::int64_t(loc_id);
 
-            std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> prevdim =
-                extract_numeric_value_dimensions(args[0], name, codename);
+        // the local tile is exposed to all other localities until they have
+        // received it
+        std::string const gather_name =
+            util::generate_collective_name(
+                "all_gather_" + locs.annotation_.name_);
+        util::distributed_matrix<T> m_data(
+            gather_name, arr.matrix(), num_localities, loc_id);
 
-            std::size_t total_cols = 0;
-            for (std::size_t i = 0; i != args_size; ++i)
+        blaze::DynamicMatrix<T> result;
+        if (receive)
+        {
+            // the tiling information describes where each tile goes, thus
+            // all tiles are received directly into their final position
+            result.resize(rows_dim, cols_dim, false);
+
+            std::vector<hpx::future<void>> fetches;
+            fetches.reserve(num_localities);
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
             {
-                if (extract_numeric_value_dimension(args[i],
-                    name, codename) != 2)
+                tiling_information const& tile = locs.tiles_[loc];
+                std::size_t const row_start = tile.spans_[0].start_;
+                std::size_t const col_start = tile.spans_[1].start_;
+                std::size_t const rows = tile.spans_[0].size();
+                std::size_t const cols = tile.spans_[1].size();
+
+                if (rows == 0 || cols == 0)
                 {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "dist_matrixops::primitives::"
-                        "all_gather::detail::concatenate2d_axis1",
-                        util::generate_error_message(
-                            "all the input arrays must have "
-                            "the same number of dimensions", name, codename));
+                    continue;
                 }
 
-                std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> dim =
-                    extract_numeric_value_dimensions(args[i], name, codename);
+                auto target =
+                    blaze::submatrix(result, row_start, col_start, rows, cols);
 
-                if (i != 0 && prevdim[0] != dim[0])
+                if (loc == loc_id)
                 {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "dist_matrixops::primitives::"
-                        "all_gather::detail::concatenate2d_axis1",
-                        util::generate_error_message(
-                            "all the input array dimensions except for"
-                            "the concatenation axis must match exactly",
-                            name, codename));
+                    target = arr.matrix();
+                    continue;
                 }
 
-                total_cols += dim[1];
-                prevdim = dim;
-            }
-
-            blaze::DynamicMatrix<T> result(prevdim[0], total_cols);
-
-            std::size_t step = 0;
-            for (auto&& arg : args)
-            {
-                auto&& val =
-                    execution_tree::extract_node_data<T>(std::move(arg));
-                std::size_t num_cols = val.dimension(1);
-                auto m = val.matrix();
-                blaze::submatrix(
-                    result, 0, step, prevdim[0], num_cols) = m;
-                step += num_cols;
+                fetches.push_back(
+                    m_data.fetch(loc, 0, 0, rows, cols, target));
             }
 
-            return execution_tree::primitive_argument_type{
-                ir::node_data<T>{std::move(result)}};
-        }
-
-        template <typename T>
-        execution_tree::primitive_argument_type concatenate2d(
-            execution_tree::primitive_arguments_type&& args, std::int64_t axis,
-            std::string const& name, std::string const& codename)
-        {
-            switch (axis)
+            // all fetches have to complete before result (their target) can
+            // be released, even if one of them failed
+            for (auto& f : hpx::when_all(std::move(fetches)).get())
             {
-            case 0:
-                return detail::concatenate2d_axis0<T>(
-                    std::move(args), name, codename);
-            case 1:
-                return detail::concatenate2d_axis1<T>(
-                    std::move(args), name, codename);
-            default:
-                break;
+                f.get();    // rethrow exceptions
             }
-            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "dist_matrixops::primitives::"
-                "all_gather::detail::concatenate2d",
-                util::generate_error_message(
-                    "axis is out of bounds of dimension", name, codename));
         }
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    template <typename T>
-    execution_tree::primitive_argument_type all_gather::all_gather2d(
-        ir::node_data<T>&& arr,
-        execution_tree::localities_information&& locs) const
-    {
-        using namespace execution_tree;
 
-        blaze::DynamicMatrix<T> m = arr.matrix();
-        // use hpx::all_gather to get a vector of values
-        auto p = hpx::all_gather(
-            ("all_gather_" + locs.annotation_.name_).c_str(),
-            m, locs.locality_.num_localities_,
-            std::size_t(-1),
-            locs.locality_.locality_id_)
-                .get();
-
-        // row and column dimensions of the whole array
-        std::size_t rows_dim, cols_dim;
-        rows_dim = locs.rows(name_, codename_);
-        cols_dim = locs.columns(name_, codename_);
-
-        // check the tiling type is column-tiling or row-tiling
-        std::int64_t axis; // along with the array will be joined
-        if (m.rows() == rows_dim)
-        {
-            // column-tiling
-            axis = 1;
-        }
-        else if (m.columns() == cols_dim)
-        {
-            // row-tiling
-            axis = 0;
-        }
-        else
+        // keep the local tile alive until all localities have received it
+        if (num_localities > 1)
         {
-            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "all_gather::detail::all_gather2d",
-                generate_error_message(
-                    "invalid tiling_type. The tiling_type can"
-                    "be `row` or `column`"));
+            hpx::lcos::barrier b(
+                "barrier_" + gather_name, num_localities, loc_id);
+            b.wait();
         }
 
-        primitive_arguments_type ops;
-        ops.reserve(p.size());
-        for (auto && op : p)
+        if (!receive)
         {
-            ops.push_back(
-                primitive_argument_type{ir::node_data<T>{std::move(op)}});
+            return primitive_argument_type(std::move(arr), std::move(ann));
         }
 
-        return detail::concatenate2d<T>(std::move(ops), axis, name_, codename_);
+        return primitive_argument_type{ir::node_data<T>{std::move(result)}};
     }
 
     ///////////////////////////////////////////////////////////////////////////
     execution_tree::primitive_argument_type all_gather::all_gather2d(
-        execution_tree::primitive_argument_type&& arr) const
+        execution_tree::primitive_argument_type&& arr,
+        std::int64_t root) const
     {
         using namespace execution_tree;
 
         execution_tree::localities_information locs =
             extract_localities_information(arr, name_, codename_);
+        auto ann = arr.annotation();
 
         std::size_t ndim = locs.num_dimensions();
 
@@ -288,22 +238,22 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         case node_data_type_bool:
             return all_gather2d(
                 extract_boolean_value_strict(std::move(arr), name_, codename_),
-                std::move(locs));
+                std::move(locs), root, std::move(ann));
 
         case node_data_type_int64:
             return all_gather2d(
                 extract_integer_value_strict(std::move(arr), name_, codename_),
-                std::move(locs));
+                std::move(locs), root, std::move(ann));
 
         case node_data_type_unknown:
             return all_gather2d(
                 extract_numeric_value(std::move(arr), name_, codename_),
-                std::move(locs));
+                std::move(locs), root, std::move(ann));
 
         case node_data_type_double:
             return all_gather2d(
                 extract_numeric_value_strict(std::move(arr), name_, codename_),
-                std::move(locs));
+                std::move(locs), root, std::move(ann));
 
         default:
             break;
@@ -323,13 +273,13 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_arguments_type const& args,
         execution_tree::eval_context ctx) const
     {
-        if (operands.empty() || operands.size() > 1)
+        if (operands.empty() || operands.size() > (gather_to_root_ ? 2 : 1))
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "all_gather::eval",
-                generate_error_message(
-                    "the all_gather primitive requires"
-                    "1 operands"));
+                generate_error_message(gather_to_root_ ?
+                    "the gather primitive requires one or two operands" :
+                    "the all_gather primitive requires 1 operands"));
         }
 
         if (!valid(operands[0]))
@@ -350,12 +300,26 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                     {
                         using namespace execution_tree;
 
+                        std::int64_t root = -1;
+                        if (this_->gather_to_root_)
+                        {
+                            root = 0;
+                            if (args.size() > 1 && valid(args[1]))
+                            {
+                                root =
+                                    extract_scalar_nonneg_integer_value_strict(
+                                        std::move(args[1]), this_->name_,
+                                        this_->codename_);
+                            }
+                        }
+
                         switch (extract_numeric_value_dimension(
-                            std::move(args[0]), this_->name_, this_->codename_))
+                            args[0], this_->name_, this_->codename_))
                         {
 
                             case 2:
-                                return this_->all_gather2d(std::move(args[0]));
+                                return this_->all_gather2d(
+                                    std::move(args[0]), root);
 
                             default:
                                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
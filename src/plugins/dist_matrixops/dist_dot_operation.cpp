@@ -31,14 +31,22 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     execution_tree::match_pattern_type const dist_dot_operation::match_data =
     {
         execution_tree::match_pattern_type{
-            "dot_d", std::vector<std::string>{"dot_d(_1, _2)"},
+            "dot_d", std::vector<std::string>{
+                "dot_d(_1, _2, __arg(_3_tiling_type, nil))"},
             &create_dist_dot_operation,
             &execution_tree::create_primitive<dist_dot_operation>,
-            R"(a, b
+            R"(a, b, tiling_type
             Args:
 
                 a (array) : a scalar, vector, matrix or a tensor
                 b (array) : a scalar, vector, matrix or a tensor
+                tiling_type (string, optional) : if the localities compute
+                    partial results that have to be added up, the result is
+                    by default available on all localities. If this is set
+                    to `row` or `column` the partial results are combined
+                    using a reduce-scatter instead and each locality keeps
+                    only its tile of the result, tiled along the given
+                    dimension (both are equivalent for vector results).
 
             Returns:
 
@@ -105,7 +113,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
 
     execution_tree::primitive_argument_type dist_dot_operation::dot1d(
         execution_tree::primitive_argument_type&& lhs,
-        execution_tree::primitive_argument_type&& rhs) const
+        execution_tree::primitive_argument_type&& rhs,
+        std::string const& tiling_type) const
     {
         using namespace execution_tree;
 
@@ -126,20 +135,20 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return dot1d(
                 extract_boolean_value(std::move(lhs), name_, codename_),
                 extract_boolean_value(std::move(rhs), name_, codename_),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         case node_data_type_int64:
             return dot1d(
                 extract_integer_value(std::move(lhs), name_, codename_),
                 extract_integer_value(std::move(rhs), name_, codename_),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         case node_data_type_unknown: HPX_FALLTHROUGH;
         case node_data_type_double:
             return dot1d(
                 extract_numeric_value(std::move(lhs), name_, codename_),
                 extract_numeric_value(std::move(rhs), name_, codename_),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         default:
             break;
@@ -154,7 +163,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
 
     execution_tree::primitive_argument_type dist_dot_operation::dot2d(
         execution_tree::primitive_argument_type&& lhs,
-        execution_tree::primitive_argument_type&& rhs) const
+        execution_tree::primitive_argument_type&& rhs,
+        std::string const& tiling_type) const
     {
         using namespace execution_tree;
 
@@ -175,20 +185,20 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return dot2d(
                 extract_boolean_value(std::move(lhs), name_, codename_),
                 extract_boolean_value(std::move(rhs), name_, codename_),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         case node_data_type_int64:
             return dot2d(
                 extract_integer_value(std::move(lhs), name_, codename_),
                 extract_integer_value(std::move(rhs), name_, codename_),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         case node_data_type_unknown: HPX_FALLTHROUGH;
         case node_data_type_double:
             return dot2d(
                 extract_numeric_value(std::move(lhs), name_, codename_),
                 extract_numeric_value(std::move(rhs), name_, codename_),
-                std::move(lhs_localities), rhs_localities);
+                std::move(lhs_localities), rhs_localities, tiling_type);
 
         default:
             break;
@@ -253,7 +263,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     ////////////////////////////////////////////////////////////////////////////
     execution_tree::primitive_argument_type dist_dot_operation::dot_nd(
         execution_tree::primitive_argument_type&& lhs,
-        execution_tree::primitive_argument_type&& rhs) const
+        execution_tree::primitive_argument_type&& rhs,
+        std::string const& tiling_type) const
     {
         using namespace execution_tree;
 
@@ -263,10 +274,10 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return dot0d(std::move(lhs), std::move(rhs));
 
         case 1:
-            return dot1d(std::move(lhs), std::move(rhs));
+            return dot1d(std::move(lhs), std::move(rhs), tiling_type);
 
         case 2:
-            return dot2d(std::move(lhs), std::move(rhs));
+            return dot2d(std::move(lhs), std::move(rhs), tiling_type);
 
         case 3:
             return dot3d(std::move(lhs), std::move(rhs));
@@ -287,13 +298,13 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     {
         using namespace execution_tree;
 
-        if (operands.size() != 2)
+        if (operands.size() != 2 && operands.size() != 3)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "dist_dot_operation::eval",
                 generate_error_message(
-                    "the dist_dot_operation primitive requires exactly "
-                        "two operands"));
+                    "the dist_dot_operation primitive requires two or three "
+                        "operands"));
         }
 
         if (!valid(operands[0]) || !valid(operands[1]))
@@ -306,17 +317,40 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         }
 
         auto f = value_operand(operands[0], args, name_, codename_, ctx);
+        auto g = value_operand(operands[1], args, name_, codename_, ctx);
+
+        hpx::future<primitive_argument_type> tiling_type =
+            operands.size() == 3 && valid(operands[2]) ?
+            value_operand(operands[2], args, name_, codename_, std::move(ctx)) :
+            hpx::make_ready_future(primitive_argument_type{});
 
         auto this_ = this->shared_from_this();
         return hpx::dataflow(hpx::launch::sync,
             [this_ = std::move(this_)](
                     hpx::future<primitive_argument_type>&& op1,
-                    hpx::future<primitive_argument_type>&& op2)
+                    hpx::future<primitive_argument_type>&& op2,
+                    hpx::future<primitive_argument_type>&& op3)
             -> primitive_argument_type
             {
-                return this_->dot_nd(op1.get(), op2.get());
+                // the tiling of the result is (optional) argument #3
+                std::string tiling_type;
+                primitive_argument_type arg3 = op3.get();
+                if (valid(arg3) && !is_explicit_nil(arg3))
+                {
+                    tiling_type = extract_string_value(
+                        std::move(arg3), this_->name_, this_->codename_);
+                    if (tiling_type != "row" && tiling_type != "column")
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dist_dot_operation::eval",
+                            this_->generate_error_message(
+                                "the tiling_type of the result must be "
+                                "either `row` or `column`"));
+                    }
+                }
+
+                return this_->dot_nd(op1.get(), op2.get(), tiling_type);
             },
-            std::move(f),
-            value_operand(operands[1], args, name_, codename_, std::move(ctx)));
+            std::move(f), std::move(g), std::move(tiling_type));
     }
 }}}
@@ -12,6 +12,7 @@
 #include <phylanx/plugins/dist_matrixops/dist_dot_operation_impl.hpp>
 
 #include <cstdint>
+#include <string>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace dist_matrixops { namespace primitives
@@ -25,12 +26,14 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     template execution_tree::primitive_argument_type dist_dot_operation::dot1d(
         ir::node_data<std::int64_t>&&, ir::node_data<std::int64_t>&&,
         execution_tree::localities_information&& lhs_localities,
-        execution_tree::localities_information const& rhs_localities) const;
+        execution_tree::localities_information const& rhs_localities,
+        std::string const& tiling_type) const;
 
     template execution_tree::primitive_argument_type dist_dot_operation::dot2d(
         ir::node_data<std::int64_t>&&, ir::node_data<std::int64_t>&&,
         execution_tree::localities_information&& lhs_localities,
-        execution_tree::localities_information const& rhs_localities) const;
+        execution_tree::localities_information const& rhs_localities,
+        std::string const& tiling_type) const;
 
     template execution_tree::primitive_argument_type dist_dot_operation::dot3d(
         ir::node_data<std::int64_t>&&, ir::node_data<std::int64_t>&&,
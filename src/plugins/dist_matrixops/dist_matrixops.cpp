@@ -12,7 +12,7 @@
 PHYLANX_REGISTER_PLUGIN_MODULE();
 
 PHYLANX_REGISTER_PLUGIN_FACTORY(all_gather_plugin,
-    phylanx::dist_matrixops::primitives::all_gather::match_data);
+    phylanx::dist_matrixops::primitives::all_gather::match_data[0]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_argmax_plugin,
     phylanx::dist_matrixops::primitives::dist_argmax::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_argmin_plugin,
@@ -33,5 +33,9 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(dist_random_plugin,
     phylanx::dist_matrixops::primitives::dist_random::match_data)
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_transpose_operation_plugin,
     phylanx::dist_matrixops::primitives::dist_transpose_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(gather_plugin,
+    phylanx::dist_matrixops::primitives::all_gather::match_data[1]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(retile_annotations_plugin,
     phylanx::dist_matrixops::primitives::retile_annotations::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(update_halo_plugin,
+    phylanx::dist_matrixops::primitives::update_halo::match_data);
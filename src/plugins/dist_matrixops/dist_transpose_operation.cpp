@@ -13,18 +13,24 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/common/transpose_operation_nd.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_transpose_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/tile_calculation_helper.hpp>
 #include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/util/collectives.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -38,16 +44,29 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     execution_tree::match_pattern_type const dist_transpose_operation::match_data =
     {
         hpx::make_tuple("transpose_d",
-            std::vector<std::string>{"transpose_d(_1)", "transpose_d(_1, _2)"},
+            std::vector<std::string>{R"(
+                transpose_d(
+                    _1,
+                    __arg(_2_axes, nil),
+                    __arg(_3_keep_tiling, false)
+                )
+            )"},
             &create_dist_transpose_operation,
             &execution_tree::create_primitive<dist_transpose_operation>, R"(
-            arg, axes
+            arg, axes, keep_tiling
             Args:
 
                 arg (arr) : an array
                 axes (optional, integer or a vector of integers) : By default,
                    reverse the dimensions, otherwise permute the axes according
                    to the values given.
+                keep_tiling (optional, bool) : By default, the tiles of a
+                   distributed matrix are transposed locally, which gives a
+                   result tiled in the transposed layout. If true, the blocks
+                   of the matrix are exchanged between the localities such
+                   that the result is tiled the same way as `arg` (same tiles
+                   for a square matrix, otherwise the same number of row or
+                   column tiles). Defaults to false.
 
             Returns:
 
@@ -60,8 +79,15 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             execution_tree::primitive_arguments_type&& operands,
             std::string const& name, std::string const& codename)
       : primitive_component_base(std::move(operands), name, codename)
+      , transferred_bytes_(0)
     {}
 
+    std::int64_t dist_transpose_operation::get_transferred_bytes(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(transferred_bytes_, reset);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     bool dist_transpose_operation::validate_axes(std::size_t a_dims,
         ir::node_data<std::int64_t>&& axes) const
@@ -185,11 +211,244 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Calculate the tiles of the transposed matrix such that it is tiled
+        // the same way as the original matrix
+        std::vector<std::array<execution_tree::tiling_span, 2>>
+        transposed_tiles(
+            std::vector<execution_tree::tiling_information> const& tiles,
+            std::int64_t rows, std::int64_t columns, std::string const& name,
+            std::string const& codename)
+        {
+            using execution_tree::tiling_span;
+
+            std::uint32_t const num_tiles =
+                static_cast<std::uint32_t>(tiles.size());
+            std::vector<std::array<tiling_span, 2>> result(num_tiles);
+
+            // the tiles of a square matrix are kept as they are
+            if (rows == columns)
+            {
+                for (std::uint32_t i = 0; i != num_tiles; ++i)
+                {
+                    result[i] = {tiles[i].spans_[0], tiles[i].spans_[1]};
+                }
+                return result;
+            }
+
+            bool row_tiling = true;
+            bool column_tiling = true;
+            for (auto const& tile : tiles)
+            {
+                if (tile.spans_[1].start_ != 0 ||
+                    tile.spans_[1].stop_ != columns)
+                {
+                    row_tiling = false;
+                }
+                if (tile.spans_[0].start_ != 0 || tile.spans_[0].stop_ != rows)
+                {
+                    column_tiling = false;
+                }
+            }
+
+            if (!row_tiling && !column_tiling)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_transpose_operation::transposed_tiles",
+                    util::generate_error_message(
+                        "keeping the tiling of a non-square matrix requires "
+                        "the matrix to be tiled along its rows or columns",
+                        name, codename));
+            }
+
+            for (std::uint32_t i = 0; i != num_tiles; ++i)
+            {
+                std::int64_t start;
+                std::size_t size;
+                if (row_tiling)
+                {
+                    std::tie(start, size) = tile_calculation::
+                        tile_calculation_1d(i, columns, num_tiles);
+                    result[i] = {tiling_span(start, start + std::int64_t(size)),
+                        tiling_span(0, rows)};
+                }
+                else
+                {
+                    std::tie(start, size) = tile_calculation::
+                        tile_calculation_1d(i, rows, num_tiles);
+                    result[i] = {tiling_span(0, columns),
+                        tiling_span(start, start + std::int64_t(size))};
+                }
+            }
+            return result;
+        }
+
+        // Transpose the source into the target at the given offset, the
+        // source is processed in blocks that fit into the cache
+        template <typename Source, typename T>
+        void blocked_transpose(Source const& source,
+            blaze::DynamicMatrix<T>& target, std::size_t row_offset,
+            std::size_t column_offset)
+        {
+            constexpr std::size_t block_size = 64;
+
+            for (std::size_t i = 0; i < source.rows(); i += block_size)
+            {
+                std::size_t const rows =
+                    (std::min)(block_size, source.rows() - i);
+                for (std::size_t j = 0; j < source.columns(); j += block_size)
+                {
+                    std::size_t const columns =
+                        (std::min)(block_size, source.columns() - j);
+                    blaze::submatrix(target, row_offset + j,
+                        column_offset + i, columns, rows) =
+                        blaze::trans(
+                            blaze::submatrix(source, i, j, rows, columns));
+                }
+            }
+        }
+    }
+
     template <typename T>
     execution_tree::primitive_argument_type
-    dist_transpose_operation::transpose2d(ir::node_data<T>&& arg,
+    dist_transpose_operation::transpose2d_keep_tiling(ir::node_data<T>&& arg,
         execution_tree::localities_information&& localities) const
     {
+        using namespace execution_tree;
+
+        std::uint32_t const loc_id = localities.locality_.locality_id_;
+        std::uint32_t const num_localities =
+            localities.locality_.num_localities_;
+
+        auto tiles = detail::transposed_tiles(localities.tiles_,
+            localities.rows(name_, codename_),
+            localities.columns(name_, codename_), name_, codename_);
+
+        tiling_span const row_span = tiles[loc_id][0];
+        tiling_span const column_span = tiles[loc_id][1];
+
+        // the tile of the result is the transpose of the part of the matrix
+        // with the rows given by its column span and vice versa
+        blaze::DynamicMatrix<T> result(row_span.size(), column_span.size());
+
+        std::string const exchange_name =
+            util::generate_collective_name(
+                "transpose_" + localities.annotation_.name_);
+        util::distributed_matrix<T> m_data(exchange_name, arg.matrix(),
+            num_localities, loc_id, &transferred_bytes_);
+
+        // request all remote blocks first, each of them is transposed into
+        // place as soon as it has arrived
+        std::vector<hpx::future<void>> blocks;
+        blocks.reserve(num_localities);
+
+        bool has_local_block = false;
+        tiling_span local_rows, local_columns;
+
+        for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+        {
+            tiling_information const& tile = localities.tiles_[loc];
+
+            tiling_span rows_part, columns_part;
+            if (!intersect(tile.spans_[0], column_span, rows_part) ||
+                !intersect(tile.spans_[1], row_span, columns_part))
+            {
+                continue;
+            }
+
+            if (loc == loc_id)
+            {
+                has_local_block = true;
+                local_rows = rows_part;
+                local_columns = columns_part;
+                continue;
+            }
+
+            std::int64_t const row_start =
+                rows_part.start_ - tile.spans_[0].start_;
+            std::int64_t const column_start =
+                columns_part.start_ - tile.spans_[1].start_;
+
+            std::size_t const row_offset =
+                columns_part.start_ - row_span.start_;
+            std::size_t const column_offset =
+                rows_part.start_ - column_span.start_;
+
+            blocks.push_back(m_data
+                    .fetch(loc, row_start, column_start,
+                        row_start + rows_part.size(),
+                        column_start + columns_part.size())
+                    .then([&result, row_offset, column_offset](
+                              hpx::future<blaze::DynamicMatrix<T>>&& f) {
+                        detail::blocked_transpose(
+                            f.get(), result, row_offset, column_offset);
+                    }));
+        }
+
+        // the local block is transposed while the remote blocks are in flight
+        if (has_local_block)
+        {
+            tiling_information const& tile = localities.tiles_[loc_id];
+            auto m = arg.matrix();
+
+            detail::blocked_transpose(
+                blaze::submatrix(m, local_rows.start_ - tile.spans_[0].start_,
+                    local_columns.start_ - tile.spans_[1].start_,
+                    local_rows.size(), local_columns.size()),
+                result, local_columns.start_ - row_span.start_,
+                local_rows.start_ - column_span.start_);
+        }
+
+        for (auto& f : hpx::when_all(std::move(blocks)).get())
+        {
+            f.get();    // rethrow exceptions
+        }
+
+        // keep the local tile alive until all localities have received their
+        // blocks
+        if (num_localities > 1)
+        {
+            hpx::lcos::barrier b(
+                "barrier_" + exchange_name, num_localities, loc_id);
+            b.wait();
+        }
+
+        // construct new tiling annotation
+        tiling_information_2d tile_info(
+            annotation{ir::range("tile",
+                ir::range("rows", row_span.start_, row_span.stop_),
+                ir::range("columns", column_span.start_, column_span.stop_))},
+            name_, codename_);
+
+        localities.annotation_.name_ += "_transposed";
+        ++localities.annotation_.generation_;
+
+        primitive_argument_type transposed{std::move(result)};
+
+        auto locality_ann = localities.locality_.as_annotation();
+        transposed.set_annotation(
+            localities_annotation(locality_ann,
+                tile_info.as_annotation(name_, codename_),
+                localities.annotation_, name_, codename_),
+            name_, codename_);
+
+        return transposed;
+    }
+
+    template <typename T>
+    execution_tree::primitive_argument_type
+    dist_transpose_operation::transpose2d(ir::node_data<T>&& arg,
+        execution_tree::localities_information&& localities,
+        bool keep_tiling) const
+    {
+        if (keep_tiling && localities.locality_.num_localities_ > 1)
+        {
+            return transpose2d_keep_tiling(
+                std::move(arg), std::move(localities));
+        }
+
         // perform actual operation
         arg = blaze::trans(arg.matrix());
 
@@ -206,7 +465,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
 
     execution_tree::primitive_argument_type
     dist_transpose_operation::transpose2d(
-        execution_tree::primitive_argument_type&& arg) const
+        execution_tree::primitive_argument_type&& arg, bool keep_tiling) const
     {
         using namespace execution_tree;
 
@@ -225,18 +484,18 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         case node_data_type_bool:
             return transpose2d(
                 extract_boolean_value_strict(std::move(arg), name_, codename_),
-                std::move(localities_info));
+                std::move(localities_info), keep_tiling);
 
         case node_data_type_int64:
             return transpose2d(
                 extract_integer_value_strict(std::move(arg), name_, codename_),
-                std::move(localities_info));
+                std::move(localities_info), keep_tiling);
 
         case node_data_type_unknown: HPX_FALLTHROUGH;
         case node_data_type_double:
             return transpose2d(
                 extract_numeric_value(std::move(arg), name_, codename_),
-                std::move(localities_info));
+                std::move(localities_info), keep_tiling);
 
         default:
             break;
@@ -252,7 +511,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     execution_tree::primitive_argument_type
     dist_transpose_operation::transpose2d(
         execution_tree::primitive_argument_type&& arg,
-        ir::node_data<std::int64_t>&& axes) const
+        ir::node_data<std::int64_t>&& axes, bool keep_tiling) const
     {
         using namespace execution_tree;
 
@@ -287,18 +546,18 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         case node_data_type_bool:
             return transpose2d(
                 extract_boolean_value_strict(std::move(arg), name_, codename_),
-                std::move(localities_info));
+                std::move(localities_info), keep_tiling);
 
         case node_data_type_int64:
             return transpose2d(
                 extract_integer_value_strict(std::move(arg), name_, codename_),
-                std::move(localities_info));
+                std::move(localities_info), keep_tiling);
 
         case node_data_type_unknown: HPX_FALLTHROUGH;
         case node_data_type_double:
             return transpose2d(
                 extract_numeric_value(std::move(arg), name_, codename_),
-                std::move(localities_info));
+                std::move(localities_info), keep_tiling);
 
         default:
             break;
@@ -500,13 +759,13 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_arguments_type const& args,
         execution_tree::eval_context ctx) const
     {
-        if (operands.size() != 1 && operands.size() != 2)
+        if (operands.empty() || operands.size() > 3)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "dist_transpose_operation::dist_transpose_operation",
                 generate_error_message(
                     "the dist_transpose_operation primitive requires"
-                        "exactly one or two operands"));
+                        "between one and three operands"));
         }
 
         if (!valid(operands[0]))
@@ -530,7 +789,14 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                 auto a_dims = extract_numeric_value_dimension(
                     args[0], this_->name_, this_->codename_);
 
-                if (args.size() == 2 && valid(args[1]))
+                bool keep_tiling = false;
+                if (args.size() == 3 && valid(args[2]))
+                {
+                    keep_tiling = extract_scalar_boolean_value(
+                        std::move(args[2]), this_->name_, this_->codename_);
+                }
+
+                if (args.size() >= 2 && valid(args[1]))
                 {
                     // converting a range axes to a vector
                     if (is_list_operand_strict(args[1]))
@@ -565,7 +831,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                         case 2:
                             return this_->transpose2d(std::move(args[0]),
                                 extract_integer_value_strict(std::move(args[1]),
-                                    this_->name_, this_->codename_));
+                                    this_->name_, this_->codename_),
+                                keep_tiling);
 
                         case 3:
                             return this_->transpose3d(std::move(args[0]),
@@ -601,7 +868,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                     return this_->transpose1d(std::move(args[0]));
 
                 case 2:
-                    return this_->transpose2d(std::move(args[0]));
+                    return this_->transpose2d(
+                        std::move(args[0]), keep_tiling);
 
                 case 3:
                     return this_->transpose3d(std::move(args[0]));
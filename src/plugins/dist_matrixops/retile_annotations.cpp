@@ -15,22 +15,28 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/dist_matrixops/retile_annotations.hpp>
 #include <phylanx/plugins/dist_matrixops/tile_calculation_helper.hpp>
+#include <phylanx/util/collectives.hpp>
 #include <phylanx/util/detail/range_dimension.hpp>
-#include <phylanx/util/distributed_matrix.hpp>
 #include <phylanx/util/distributed_tensor.hpp>
 #include <phylanx/util/distributed_vector.hpp>
 #include <phylanx/util/index_calculation_helper.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
 
 #include <hpx/assert.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/serialization/array.hpp>
+#include <hpx/synchronization/spinlock.hpp>
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -97,11 +103,124 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
       , transferred_bytes_(0)
     {}
 
+    namespace detail
+    {
+        // transferred_bytes_ is updated by the distributed_vector and
+        // distributed_tensor instances created for retiling and by the data
+        // exchange in retile2d, all of them use the lock associated with its
+        // address
+        hpx::util::detail::spinlock& transferred_bytes_lock(
+            std::int64_t const* transferred_bytes)
+        {
+            using spinlock_pool = hpx::util::spinlock_pool<std::uint64_t>;
+            return spinlock_pool::spinlock_for(transferred_bytes);
+        }
+    }
+
     std::int64_t retile_annotations::get_transferred_bytes(bool reset) const
     {
+        std::lock_guard<hpx::util::detail::spinlock> l(
+            detail::transferred_bytes_lock(&transferred_bytes_));
         return hpx::util::get_and_reset_value(transferred_bytes_, reset);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<retile_annotations::redistribution_plan_2d const>
+    retile_annotations::get_plan_2d(std::uint32_t loc_id,
+        std::vector<execution_tree::tiling_information> const& source,
+        std::vector<std::array<execution_tree::tiling_span, 2>> const&
+            destination) const
+    {
+        using namespace execution_tree;
+
+        std::size_t const num_localities = destination.size();
+
+        plan_key_type key;
+        key.reserve(8 * num_localities + 1);
+        key.push_back(loc_id);
+        for (std::size_t loc = 0; loc != num_localities; ++loc)
+        {
+            for (std::size_t i = 0; i != 2; ++i)
+            {
+                key.push_back(source[loc].spans_[i].start_);
+                key.push_back(source[loc].spans_[i].stop_);
+                key.push_back(destination[loc][i].start_);
+                key.push_back(destination[loc][i].stop_);
+            }
+        }
+
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+            auto it = plans_.find(key);
+            if (it != plans_.end())
+            {
+                execution_tree::detail::count_retile_plan(true);
+                return it->second;
+            }
+        }
+
+        // the part of the source tile on locality src that ends up in the
+        // destination tile on locality dest, relative to the given tile
+        auto intersect_tiles = [&](std::size_t src, std::size_t dest,
+                                   std::array<tiling_span, 2> const& tile,
+                                   redistribution_plan_2d::block& result) {
+            tiling_span rows, cols;
+            if (!intersect(source[src].spans_[0], destination[dest][0], rows) ||
+                !intersect(source[src].spans_[1], destination[dest][1], cols) ||
+                !rows.is_valid() || !cols.is_valid())
+            {
+                return false;
+            }
+            result = {rows.start_ - tile[0].start_,
+                cols.start_ - tile[1].start_, rows.size(), cols.size()};
+            return true;
+        };
+
+        auto plan = std::make_shared<redistribution_plan_2d>();
+        plan->send_.resize(num_localities, {0, 0, 0, 0});
+        plan->receive_.resize(num_localities, {0, 0, 0, 0});
+
+        std::array<tiling_span, 2> const local_tile = {
+            source[loc_id].spans_[0], source[loc_id].spans_[1]};
+
+        redistribution_plan_2d::block block;
+        for (std::size_t src = 0; src != num_localities; ++src)
+        {
+            for (std::size_t dest = 0; dest != num_localities; ++dest)
+            {
+                if (src == loc_id)
+                {
+                    intersect_tiles(src, dest, local_tile, plan->send_[dest]);
+                }
+                if (dest == loc_id)
+                {
+                    intersect_tiles(
+                        src, dest, destination[loc_id], plan->receive_[src]);
+                }
+                if (src != dest && intersect_tiles(src, dest, local_tile, block))
+                {
+                    plan->exchange_ = true;
+                }
+            }
+        }
+
+        execution_tree::detail::count_retile_plan(false);
+
+        std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+        auto result = plans_.emplace(std::move(key), std::move(plan));
+        if (result.second)
+        {
+            plans_order_.push_back(result.first);
+            if (plans_order_.size() >
+                execution_tree::detail::retile_plan_cache_capacity())
+            {
+                plans_.erase(plans_order_.front());
+                plans_order_.pop_front();
+            }
+        }
+        return result.first->second;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
@@ -543,32 +662,23 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             arr_localities.locality_.num_localities_;
         std::size_t rows_dim = arr_localities.rows(name_, codename_);
         std::size_t cols_dim = arr_localities.columns(name_, codename_);
-        tiling_information_2d tile_info(
-            arr_localities.tiles_[loc_id], name_, codename_);
-
-        std::int64_t cur_row_start = tile_info.spans_[0].start_;
-        std::int64_t cur_row_stop = tile_info.spans_[0].stop_;
-        std::int64_t cur_col_start = tile_info.spans_[1].start_;
-        std::int64_t cur_col_stop = tile_info.spans_[1].stop_;
 
         // updating the annotation_ part of localities annotation
         arr_localities.annotation_.name_ += "_retiled";
         ++arr_localities.annotation_.generation_;
 
-        // desired annotation information
-        std::int64_t des_row_start, des_row_stop, des_col_start, des_col_stop,
-            des_row_size, des_col_size;
+        // desired annotation information of all localities
+        std::vector<std::array<tiling_span, 2>> des_tiles(num_localities);
 
         if (tiling_type == "user")
         {
+            std::int64_t des_row_start, des_row_stop, des_col_start,
+                des_col_stop;
             std::tie(des_row_start, des_col_start, des_row_stop, des_col_stop) =
                 detail::tile_extraction_2d(
                     std::move(new_tiling), name_, codename_);
 
-            des_row_size = des_row_stop - des_row_start;
-            des_col_size = des_col_stop - des_col_start;
-
-            if (des_row_size <= 0 || des_col_size <= 0)
+            if (des_row_stop <= des_row_start || des_col_stop <= des_col_start)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dist_matrixops::primitives::retile_annotations::retile2d",
@@ -576,108 +686,132 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                         "the given start point of the new_tiling should be "
                         "smaller than its stop point on each dimension"));
             }
-        }
-        else    // tiling_type is one of "sym", "row" or "column"
-        {
-            std::tie(des_row_start, des_col_start, des_row_size, des_col_size) =
-                tile_calculation::tile_calculation_2d(
-                    loc_id, rows_dim, cols_dim, numtiles, tiling_type);
 
-            if (des_row_size != rows_dim &&
-                intersections[0] != 0)    // rows overlap
+            // all localities need to know the tiles of all other localities
+            // to agree on the data exchange
+            std::vector<std::array<std::int64_t, 4>> tiles =
+                hpx::all_gather(
+                    util::generate_collective_name(
+                        "retile_d_tiles_" + arr_localities.annotation_.name_)
+                        .c_str(),
+                    std::array<std::int64_t, 4>{des_row_start, des_row_stop,
+                        des_col_start, des_col_stop},
+                    num_localities, std::size_t(-1), loc_id)
+                    .get();
+
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
             {
-                std::tie(des_row_start, des_row_size) =
-                    tile_calculation::tile_calculation_overlap_1d(des_row_start,
-                        des_row_size, rows_dim, intersections[0]);
+                des_tiles[loc] = {tiling_span(tiles[loc][0], tiles[loc][1]),
+                    tiling_span(tiles[loc][2], tiles[loc][3])};
             }
-            if (des_col_size != cols_dim &&
-                intersections[1] != 0)    // columns overlap
+        }
+        else    // tiling_type is one of "sym", "row" or "column"
+        {
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
             {
-                std::tie(des_col_start, des_col_size) =
-                    tile_calculation::tile_calculation_overlap_1d(des_col_start,
-                        des_col_size, cols_dim, intersections[1]);
-            }
+                std::int64_t des_row_start, des_col_start, des_row_size,
+                    des_col_size;
+                std::tie(des_row_start, des_col_start, des_row_size,
+                    des_col_size) =
+                    tile_calculation::tile_calculation_2d(
+                        loc, rows_dim, cols_dim, numtiles, tiling_type);
+
+                if (des_row_size != rows_dim &&
+                    intersections[0] != 0)    // rows overlap
+                {
+                    std::tie(des_row_start, des_row_size) =
+                        tile_calculation::tile_calculation_overlap_1d(
+                            des_row_start, des_row_size, rows_dim,
+                            intersections[0]);
+                }
+                if (des_col_size != cols_dim &&
+                    intersections[1] != 0)    // columns overlap
+                {
+                    std::tie(des_col_start, des_col_size) =
+                        tile_calculation::tile_calculation_overlap_1d(
+                            des_col_start, des_col_size, cols_dim,
+                            intersections[1]);
+                }
 
-            des_row_stop = des_row_start + des_row_size;
-            des_col_stop = des_col_start + des_col_size;
+                des_tiles[loc] = {
+                    tiling_span(des_row_start, des_row_start + des_row_size),
+                    tiling_span(des_col_start, des_col_start + des_col_size)};
+            }
         }
 
+        // the plan is computed once for each pair of source and destination
+        // tilings and reused whenever the same retiling is performed again
+        auto plan = get_plan_2d(loc_id, arr_localities.tiles_, des_tiles);
 
         // updating the array
         auto m = arr.matrix();
-        blaze::DynamicMatrix<T> result(des_row_size, des_col_size);
-        util::distributed_matrix<T> m_data(arr_localities.annotation_.name_, m,
-            num_localities, loc_id, &transferred_bytes_);
+        blaze::DynamicMatrix<T> result(
+            des_tiles[loc_id][0].size(), des_tiles[loc_id][1].size());
 
-        // relative starts
-        std::int64_t rel_row_start = des_row_start - cur_row_start;
-        std::int64_t rel_col_start = des_col_start - cur_col_start;
-        if ((rel_row_start < 0 || des_row_stop > cur_row_stop) ||
-            (rel_col_start < 0 || des_col_stop > cur_col_stop))
+        if (plan->exchange_)
         {
-            // copying the local part
-            if ((des_row_start < cur_row_stop &&
-                    des_row_stop > cur_row_start) &&
-                (des_col_start < cur_col_stop && des_col_stop > cur_col_start))
+            // all blocks destined for a locality are sent in one message over
+            // a point-to-point channel, no data is routed through a third
+            // locality
+            util::detail::collective_channels<blaze::DynamicMatrix<T>>
+                channels("retile_d_" + arr_localities.annotation_.name_,
+                    num_localities, loc_id);
+
+            // messages are tagged with the sending locality
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
             {
-                auto row_indices = util::index_calculation_1d(
-                    des_row_start, des_row_stop, cur_row_start, cur_row_stop);
-                auto col_indices = util::index_calculation_1d(
-                    des_col_start, des_col_stop, cur_col_start, cur_col_stop);
-
-                blaze::submatrix(result, row_indices.projected_start_,
-                    col_indices.projected_start_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_) = blaze::submatrix(m,
-                    row_indices.local_start_, col_indices.local_start_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_);
+                auto const& b = plan->send_[loc];
+                if (loc != loc_id && b[2] != 0)
+                {
+                    channels.connect(loc);
+                    channels.send(loc,
+                        blaze::DynamicMatrix<T>(
+                            blaze::submatrix(m, b[0], b[1], b[2], b[3])),
+                        loc_id + 1);
+                }
             }
 
+            std::vector<hpx::future<blaze::DynamicMatrix<T>>> incoming(
+                num_localities);
             for (std::uint32_t loc = 0; loc != num_localities; ++loc)
             {
-                if (loc == loc_id)
+                auto const& b = plan->receive_[loc];
+                if (loc != loc_id && b[2] != 0)
                 {
-                    continue;
+                    incoming[loc] = channels.receive(loc + 1);
                 }
+            }
 
-                // the array span in locality loc
-                tiling_span loc_row_span = arr_localities.tiles_[loc].spans_[0];
-                tiling_span loc_col_span = arr_localities.tiles_[loc].spans_[1];
-
-                auto row_indices = util::retile_calculation_1d(
-                    loc_row_span, des_row_start, des_row_stop);
-                auto col_indices = util::retile_calculation_1d(
-                    loc_col_span, des_col_start, des_col_stop);
-                if (row_indices.intersection_size_ > 0 &&
-                    col_indices.intersection_size_ > 0)
+            std::size_t bytes = 0;
+            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+            {
+                if (incoming[loc].valid())
                 {
-                    // loc_span has the block of result that we need
-                    blaze::submatrix(result, row_indices.projected_start_,
-                        col_indices.projected_start_,
-                        row_indices.intersection_size_,
-                        col_indices.intersection_size_) =
-                        m_data
-                            .fetch(loc, row_indices.local_start_,
-                                col_indices.local_start_,
-                                row_indices.local_start_ +
-                                    row_indices.intersection_size_,
-                                col_indices.local_start_ +
-                                    col_indices.intersection_size_)
-                            .get();
+                    auto const& b = plan->receive_[loc];
+                    blaze::submatrix(result, b[0], b[1], b[2], b[3]) =
+                        incoming[loc].get();
+                    bytes += b[2] * b[3] * sizeof(T);
                 }
             }
+
+            std::lock_guard<hpx::util::detail::spinlock> l(
+                detail::transferred_bytes_lock(&transferred_bytes_));
+            transferred_bytes_ += bytes;
         }
-        else // the new array is a subset of the original array
+
+        // copying the local part
+        auto const& send = plan->send_[loc_id];
+        auto const& receive = plan->receive_[loc_id];
+        if (receive[2] != 0)
         {
-            result = blaze::submatrix(
-                m, rel_row_start, rel_col_start, des_row_size, des_col_size);
+            blaze::submatrix(
+                result, receive[0], receive[1], receive[2], receive[3]) =
+                blaze::submatrix(m, send[0], send[1], send[2], send[3]);
         }
 
         // updating the tile information
-        tile_info =
-            tiling_information_2d(tiling_span(des_row_start, des_row_stop),
-                tiling_span(des_col_start, des_col_stop));
+        tiling_information_2d tile_info(
+            des_tiles[loc_id][0], des_tiles[loc_id][1]);
 
         auto locality_ann = arr_localities.locality_.as_annotation();
         auto attached_annotation =
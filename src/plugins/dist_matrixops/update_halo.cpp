@@ -0,0 +1,440 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/update_halo.hpp>
+#include <phylanx/util/collectives.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
+#include <phylanx/util/distributed_vector.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::match_pattern_type const update_halo::match_data =
+    {
+        hpx::make_tuple("update_halo_d", std::vector<std::string>{R"(
+                update_halo_d(
+                    _1_a
+                )
+            )"},
+            &create_update_halo,
+            &execution_tree::create_primitive<update_halo>, R"(
+            a
+            Args:
+
+                a (array): a distributed array with overlapping tiles, e.g.
+                    as created by retile_d with an intersection. A vector or
+                    a matrix.
+
+            Returns:
+
+            The local tile of the array, where the overlapping parts (halos)
+            were replaced by the values held by the neighboring localities
+            owning those parts. The overlap between two neighboring tiles is
+            split in the middle, each of the tiles owns the half adjacent to
+            its interior. Only the halos are exchanged and the exchange is
+            performed asynchronously.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    update_halo::update_halo(
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , transferred_bytes_(0)
+    {}
+
+    std::int64_t update_halo::get_transferred_bytes(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(transferred_bytes_, reset);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Calculate the part of each tile its locality owns. The overlapping
+        // part of two neighboring spans is split in the middle.
+        std::vector<execution_tree::tiling_information> owned_tiles(
+            std::vector<execution_tree::tiling_information> const& tiles)
+        {
+            using execution_tree::tiling_span;
+
+            std::vector<execution_tree::tiling_information> result = tiles;
+            for (std::size_t i = 0; i != tiles.size(); ++i)
+            {
+                for (std::size_t d = 0; d != tiles[i].spans_.size(); ++d)
+                {
+                    tiling_span const& span = tiles[i].spans_[d];
+                    tiling_span& owned = result[i].spans_[d];
+
+                    for (std::size_t j = 0; j != tiles.size(); ++j)
+                    {
+                        tiling_span const& other = tiles[j].spans_[d];
+                        if (other.start_ < span.start_ &&
+                            span.start_ < other.stop_ &&
+                            other.stop_ < span.stop_)
+                        {
+                            // other overlaps with the beginning of span
+                            owned.start_ = (std::max)(owned.start_,
+                                span.start_ +
+                                    (other.stop_ - span.start_) / 2);
+                        }
+                        else if (span.start_ < other.start_ &&
+                            other.start_ < span.stop_ &&
+                            span.stop_ < other.stop_)
+                        {
+                            // other overlaps with the end of span
+                            owned.stop_ = (std::min)(owned.stop_,
+                                other.start_ +
+                                    (span.stop_ - other.start_) / 2);
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        // Calculate the part of the given tile owned by another locality
+        bool halo_part(execution_tree::tiling_information const& tile,
+            execution_tree::tiling_information const& owned,
+            std::vector<execution_tree::tiling_span>& part)
+        {
+            part.resize(tile.spans_.size());
+            for (std::size_t d = 0; d != tile.spans_.size(); ++d)
+            {
+                if (!execution_tree::intersect(
+                        tile.spans_[d], owned.spans_[d], part[d]) ||
+                    !part[d].is_valid())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<execution_tree::primitive_argument_type>
+    update_halo::update_halo1d(ir::node_data<T>&& arr,
+        execution_tree::localities_information&& arr_localities,
+        execution_tree::primitive_argument_type::annotation_ptr&& ann) const
+    {
+        using namespace execution_tree;
+
+        std::uint32_t const loc_id = arr_localities.locality_.locality_id_;
+        std::uint32_t const num_localities =
+            arr_localities.locality_.num_localities_;
+
+        // the halos are received directly into the returned tile, the
+        // neighbors concurrently fetch the parts of it this locality owns
+        if (arr.is_ref())
+        {
+            arr = blaze::DynamicVector<T>(arr.vector());
+        }
+        auto result = std::make_shared<ir::node_data<T>>(std::move(arr));
+        std::string halo_name =
+            util::generate_collective_name(
+                "update_halo_" + arr_localities.annotation_.name_);
+        auto v_data = std::make_shared<util::distributed_vector<T>>(
+            halo_name, result->vector(), num_localities, loc_id,
+            &transferred_bytes_);
+
+        auto owned = detail::owned_tiles(arr_localities.tiles_);
+        tiling_span const& local_span = arr_localities.tiles_[loc_id].spans_[0];
+
+        std::vector<hpx::future<void>> fetches;
+        std::vector<tiling_span> part;
+        for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+        {
+            if (loc == loc_id ||
+                !detail::halo_part(
+                    arr_localities.tiles_[loc_id], owned[loc], part))
+            {
+                continue;
+            }
+
+            std::int64_t start =
+                part[0].start_ - arr_localities.tiles_[loc].spans_[0].start_;
+            std::int64_t target = part[0].start_ - local_span.start_;
+
+            fetches.push_back(
+                v_data->fetch(loc, start, start + part[0].size())
+                    .then(hpx::launch::sync,
+                        [result, target](
+                            hpx::future<blaze::DynamicVector<T>>&& f) {
+                            auto&& data = f.get();
+                            auto v = result->vector();
+                            blaze::subvector(v, target, data.size()) = data;
+                        }));
+        }
+
+        // the neighbors may still be fetching from the local tile, which
+        // has to stay alive (and unchanged) until all of them are done
+        return hpx::when_all(std::move(fetches))
+            .then(hpx::launch::async,
+                [result = std::move(result), v_data = std::move(v_data),
+                    ann = std::move(ann), halo_name = std::move(halo_name),
+                    num_localities, loc_id](
+                    hpx::future<std::vector<hpx::future<void>>>&& f)
+                    -> primitive_argument_type {
+                    for (auto& fetch : f.get())
+                    {
+                        fetch.get();    // rethrow exceptions
+                    }
+
+                    hpx::lcos::barrier b(
+                        "barrier_" + halo_name, num_localities, loc_id);
+                    b.wait();
+
+                    return primitive_argument_type(std::move(*result), ann);
+                });
+    }
+
+    hpx::future<execution_tree::primitive_argument_type>
+    update_halo::update_halo1d(
+        execution_tree::primitive_argument_type&& arr) const
+    {
+        using namespace execution_tree;
+        localities_information arr_localities =
+            extract_localities_information(arr, name_, codename_);
+        auto ann = arr.annotation();
+
+        switch (extract_common_type(arr))
+        {
+        case node_data_type_bool:
+            return update_halo1d(
+                extract_boolean_value_strict(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        case node_data_type_int64:
+            return update_halo1d(
+                extract_integer_value_strict(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        case node_data_type_double:
+            return update_halo1d(
+                extract_numeric_value_strict(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        case node_data_type_unknown:
+            return update_halo1d(
+                extract_numeric_value(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_matrixops::primitives::update_halo::update_halo1d",
+            generate_error_message(
+                "the update_halo_d primitive requires for all arguments to "
+                "be numeric data types"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<execution_tree::primitive_argument_type>
+    update_halo::update_halo2d(ir::node_data<T>&& arr,
+        execution_tree::localities_information&& arr_localities,
+        execution_tree::primitive_argument_type::annotation_ptr&& ann) const
+    {
+        using namespace execution_tree;
+
+        std::uint32_t const loc_id = arr_localities.locality_.locality_id_;
+        std::uint32_t const num_localities =
+            arr_localities.locality_.num_localities_;
+
+        // the halos are received directly into the returned tile, the
+        // neighbors concurrently fetch the parts of it this locality owns
+        if (arr.is_ref())
+        {
+            arr = blaze::DynamicMatrix<T>(arr.matrix());
+        }
+        auto result = std::make_shared<ir::node_data<T>>(std::move(arr));
+        std::string halo_name =
+            util::generate_collective_name(
+                "update_halo_" + arr_localities.annotation_.name_);
+        auto m_data = std::make_shared<util::distributed_matrix<T>>(
+            halo_name, result->matrix(), num_localities, loc_id,
+            &transferred_bytes_);
+
+        auto m = result->matrix();
+        auto owned = detail::owned_tiles(arr_localities.tiles_);
+        tiling_information const& local_tile = arr_localities.tiles_[loc_id];
+
+        std::vector<hpx::future<void>> fetches;
+        std::vector<tiling_span> part;
+        for (std::uint32_t loc = 0; loc != num_localities; ++loc)
+        {
+            if (loc == loc_id ||
+                !detail::halo_part(local_tile, owned[loc], part))
+            {
+                continue;
+            }
+
+            tiling_information const& loc_tile = arr_localities.tiles_[loc];
+            std::int64_t row_start =
+                part[0].start_ - loc_tile.spans_[0].start_;
+            std::int64_t col_start =
+                part[1].start_ - loc_tile.spans_[1].start_;
+
+            auto target = blaze::submatrix(m,
+                part[0].start_ - local_tile.spans_[0].start_,
+                part[1].start_ - local_tile.spans_[1].start_, part[0].size(),
+                part[1].size());
+
+            fetches.push_back(m_data->fetch(loc, row_start, col_start,
+                row_start + part[0].size(), col_start + part[1].size(),
+                target));
+        }
+
+        // the fetches receive directly into the local tile, which is kept
+        // alive by the continuation until all of them have completed, even
+        // if one of them failed. The neighbors may still be fetching from the
+        // local tile, which has to stay alive (and unchanged) until all of
+        // them are done as well.
+        return hpx::when_all(std::move(fetches))
+            .then(hpx::launch::async,
+                [result = std::move(result), m_data = std::move(m_data),
+                    ann = std::move(ann), halo_name = std::move(halo_name),
+                    num_localities, loc_id](
+                    hpx::future<std::vector<hpx::future<void>>>&& f)
+                    -> primitive_argument_type {
+                    for (auto& fetch : f.get())
+                    {
+                        fetch.get();    // rethrow exceptions
+                    }
+
+                    hpx::lcos::barrier b(
+                        "barrier_" + halo_name, num_localities, loc_id);
+                    b.wait();
+
+                    return primitive_argument_type(std::move(*result), ann);
+                });
+    }
+
+    hpx::future<execution_tree::primitive_argument_type>
+    update_halo::update_halo2d(
+        execution_tree::primitive_argument_type&& arr) const
+    {
+        using namespace execution_tree;
+        localities_information arr_localities =
+            extract_localities_information(arr, name_, codename_);
+        auto ann = arr.annotation();
+
+        switch (extract_common_type(arr))
+        {
+        case node_data_type_bool:
+            return update_halo2d(
+                extract_boolean_value_strict(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        case node_data_type_int64:
+            return update_halo2d(
+                extract_integer_value_strict(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        case node_data_type_double:
+            return update_halo2d(
+                extract_numeric_value_strict(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        case node_data_type_unknown:
+            return update_halo2d(
+                extract_numeric_value(std::move(arr), name_, codename_),
+                std::move(arr_localities), std::move(ann));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_matrixops::primitives::update_halo::update_halo2d",
+            generate_error_message(
+                "the update_halo_d primitive requires for all arguments to "
+                "be numeric data types"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type> update_halo::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        if (operands.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "update_halo::eval",
+                generate_error_message(
+                    "the update_halo_d primitive requires exactly one "
+                    "operand"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "update_halo::eval",
+                generate_error_message(
+                    "the update_halo_d primitive requires that the argument "
+                    "given by the operands array is valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [this_ = std::move(this_)](
+                    execution_tree::primitive_argument_type&& arr)
+                    -> hpx::future<execution_tree::primitive_argument_type>
+                {
+                    using namespace execution_tree;
+
+                    if (!arr.has_annotation())
+                    {
+                        // a non-distributed array has no halos
+                        return hpx::make_ready_future(std::move(arr));
+                    }
+
+                    switch (extract_numeric_value_dimension(
+                        arr, this_->name_, this_->codename_))
+                    {
+                    case 1:
+                        return this_->update_halo1d(std::move(arr));
+
+                    case 2:
+                        return this_->update_halo2d(std::move(arr));
+
+                    default:
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "update_halo::eval",
+                            this_->generate_error_message(
+                                "operand a has an invalid number of "
+                                "dimensions"));
+                    }
+                }),
+            execution_tree::value_operand(operands[0], args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
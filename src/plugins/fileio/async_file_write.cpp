@@ -0,0 +1,118 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/fileio/async_file_write.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/synchronization/counting_semaphore.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        struct async_file_writes
+        {
+            static std::int64_t max_in_flight()
+            {
+                std::int64_t max_in_flight = std::stol(hpx::get_config_entry(
+                    "phylanx.file_write.max_in_flight", "4"));
+                return (std::max)(max_in_flight, std::int64_t(1));
+            }
+
+            async_file_writes()
+              : slots_(max_in_flight())
+              , issued_(0)
+            {
+            }
+
+            hpx::lcos::local::counting_semaphore slots_;
+
+            hpx::lcos::local::spinlock mtx_;
+            std::vector<hpx::shared_future<void>> pending_;
+            std::size_t issued_;
+        };
+
+        async_file_writes& get_async_file_writes()
+        {
+            static async_file_writes writes;
+            return writes;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void acquire_async_write_slot()
+        {
+            get_async_file_writes().slots_.wait();
+        }
+
+        void release_async_write_slot()
+        {
+            get_async_file_writes().slots_.signal();
+        }
+
+        void register_async_write(hpx::future<void>&& f)
+        {
+            hpx::shared_future<void> write = f.then(
+                [](hpx::future<void>&& f)
+                {
+                    release_async_write_slot();
+                    f.get();    // propagate exceptions
+                });
+
+            auto& writes = get_async_file_writes();
+
+            std::lock_guard<hpx::lcos::local::spinlock> l(writes.mtx_);
+
+            // there is no need to hold on to writes that have already
+            // finished successfully
+            writes.pending_.erase(
+                std::remove_if(writes.pending_.begin(), writes.pending_.end(),
+                    [](hpx::shared_future<void> const& f)
+                    {
+                        return f.is_ready() && !f.has_exception();
+                    }),
+                writes.pending_.end());
+
+            writes.pending_.push_back(std::move(write));
+            ++writes.issued_;
+        }
+
+        hpx::future<std::size_t> wait_for_async_writes()
+        {
+            auto& writes = get_async_file_writes();
+
+            std::vector<hpx::shared_future<void>> pending;
+            std::size_t issued = 0;
+            {
+                std::lock_guard<hpx::lcos::local::spinlock> l(writes.mtx_);
+                std::swap(pending, writes.pending_);
+                std::swap(issued, writes.issued_);
+            }
+
+            return hpx::when_all(std::move(pending)).then(hpx::launch::sync,
+                [issued](
+                    hpx::future<std::vector<hpx::shared_future<void>>>&& f)
+                {
+                    for (auto const& write : f.get())
+                    {
+                        write.get();    // rethrow errors
+                    }
+                    return issued;
+                });
+        }
+    }
+}}}
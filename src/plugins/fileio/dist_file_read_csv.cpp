@@ -16,12 +16,15 @@
 #include <phylanx/plugins/dist_matrixops/tile_calculation_helper.hpp>
 #include <phylanx/plugins/fileio/dist_file_read_csv.hpp>
 #include <phylanx/plugins/fileio/file_read_csv_impl.hpp>
+#include <phylanx/util/collectives.hpp>
 #include <phylanx/util/detail/range_dimension.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/serialization/array.hpp>
 
 #include <array>
 #include <atomic>
@@ -32,6 +35,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -109,6 +113,24 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             return std::move(given_name);
         }
+
+        // scan the part of the file assigned to this locality and exchange
+        // the number of rows with all other localities, returns the overall
+        // number of rows and columns
+        std::tuple<std::size_t, std::size_t> establish_layout(
+            csv_partitioned_reader& reader, std::string const& base_name,
+            std::uint32_t tile_idx, std::uint32_t numtiles)
+        {
+            hpx::future<std::vector<csv_partitioned_reader::partition_info>>
+                f = hpx::all_gather(
+                    util::generate_collective_name(
+                        "file_read_csv_d_" + base_name)
+                        .c_str(),
+                    reader.scan(tile_idx, numtiles), numtiles, std::size_t(-1),
+                    tile_idx);
+
+            return reader.layout(f.get());
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -118,14 +140,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersections,
         std::string&& given_name, std::uint32_t numtiles) const
     {
-        std::vector<double> data;
+        std::uint32_t tile_idx = hpx::get_locality_id();
+        std::string base_name =
+            detail::generate_csv_name(std::move(given_name));
+
+        // each locality scans its part of the file only
+        csv_partitioned_reader reader(std::move(infile), filename);
+
         std::size_t n_rows, n_cols;
-        std::tie(data, n_rows, n_cols) =
-            read_helper(std::move(infile), filename);
+        std::tie(n_rows, n_cols) =
+            detail::establish_layout(reader, base_name, tile_idx, numtiles);
 
         std::int64_t row_start, column_start;
         std::size_t row_size, column_size;
-        std::uint32_t tile_idx = hpx::get_locality_id();
 
         std::tie(row_start, column_start, row_size, column_size) =
             tile_calculation::tile_calculation_2d(
@@ -153,9 +180,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         locality_information locality_info(tile_idx, numtiles);
         annotation locality_ann = locality_info.as_annotation();
 
-        std::string base_name =
-            detail::generate_csv_name(std::move(given_name));
-
         annotation_information ann_info(
             std::move(base_name), 0);    //generation 0
 
@@ -164,10 +188,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 tile_info.as_annotation(name_, codename_), ann_info, name_,
                 codename_));
 
-        blaze::DynamicMatrix<double> whole_data(n_rows, n_cols, data.data());
-        blaze::DynamicMatrix<double> result =
-            blaze::submatrix(std::move(whole_data), row_start, column_start,
-                row_size, column_size);
+        // materialize the local tile only
+        blaze::DynamicMatrix<double> result(row_size, column_size);
+        reader.read_rows(row_start, row_start + row_size,
+            [](std::size_t) { return true; },
+            [&](std::size_t row, std::vector<double> const& values)
+            {
+                auto r = blaze::row(result, row - row_start);
+                for (std::size_t j = 0; j != column_size; ++j)
+                {
+                    r[j] = values[column_start + j];
+                }
+            });
 
         return primitive_argument_type(result, attached_annotation);
     }
@@ -179,10 +211,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersections,
         std::string&& given_name, std::uint32_t numtiles) const
     {
-        std::vector<double> data;
+        std::uint32_t tile_idx = hpx::get_locality_id();
+        std::string base_name =
+            detail::generate_csv_name(std::move(given_name));
+
+        // each locality scans its part of the file only
+        csv_partitioned_reader reader(std::move(infile), filename);
+
         std::size_t n_rows, n_cols;
-        std::tie(data, n_rows, n_cols) =
-            read_helper(std::move(infile), filename);
+        std::tie(n_rows, n_cols) =
+            detail::establish_layout(reader, base_name, tile_idx, numtiles);
         std::size_t n_pages = static_cast<std::size_t>(n_rows / given_nrows);
 
         if (n_rows % given_nrows != 0)
@@ -195,7 +233,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         std::int64_t page_start, row_start, column_start;
         std::size_t page_size, row_size, column_size;
-        std::uint32_t tile_idx = hpx::get_locality_id();
 
         std::tie(page_start, row_start, column_start, page_size, row_size,
             column_size) = tile_calculation::tile_calculation_3d(tile_idx,
@@ -230,9 +267,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         locality_information locality_info(tile_idx, numtiles);
         annotation locality_ann = locality_info.as_annotation();
 
-        std::string base_name =
-            detail::generate_csv_name(std::move(given_name));
-
         annotation_information ann_info(
             std::move(base_name), 0);    //generation 0
 
@@ -241,11 +275,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 tile_info.as_annotation(name_, codename_), ann_info, name_,
                 codename_));
 
-        blaze::DynamicTensor<double> whole_data(
-            n_pages, given_nrows, n_cols, data.data());
-        blaze::DynamicTensor<double> result =
-            blaze::subtensor(std::move(whole_data), page_start, row_start,
-                column_start, page_size, row_size, column_size);
+        // materialize the local tile only, rows of the file that belong to
+        // other tiles are skipped without being parsed
+        blaze::DynamicTensor<double> result(page_size, row_size, column_size);
+        reader.read_rows(page_start * given_nrows,
+            (page_start + page_size) * given_nrows,
+            [&](std::size_t row) -> bool
+            {
+                std::int64_t page_row = row % given_nrows;
+                return page_row >= row_start &&
+                    page_row < std::int64_t(row_start + row_size);
+            },
+            [&](std::size_t row, std::vector<double> const& values)
+            {
+                std::size_t page = row / given_nrows - page_start;
+                std::size_t page_row = row % given_nrows - row_start;
+                for (std::size_t j = 0; j != column_size; ++j)
+                {
+                    result(page, page_row, j) = values[column_start + j];
+                }
+            });
 
         return primitive_argument_type(result, attached_annotation);
     }
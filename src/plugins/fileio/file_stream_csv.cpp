@@ -0,0 +1,737 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/file_read_csv_impl.hpp>
+#include <phylanx/plugins/fileio/file_stream_csv.hpp>
+
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const file_stream_csv::match_data =
+    {
+        hpx::make_tuple("file_stream_csv",
+            std::vector<std::string>{R"(
+                file_stream_csv(
+                    _1_filename,
+                    _2_reduction,
+                    __arg(_3_axis, nil),
+                    __arg(_4_transform, nil),
+                    __arg(_5_rhs, nil),
+                    __arg(_6_block_rows, 4096)
+                )
+            )"},
+            &create_file_stream_csv, &create_primitive<file_stream_csv>,
+            R"(filename, reduction, axis, transform, rhs, block_rows
+            Args:
+
+                filename (string) : file name
+                reduction (string) : the reduction to apply to the data, one
+                    of 'sum', 'mean', 'var', 'min', 'max', or 'dot'.
+                axis (int, optional) : the axis to reduce along, either 0
+                    (along the rows) or 1 (along the columns). If not given,
+                    all elements are reduced into a single value. The axis
+                    is ignored for 'dot'.
+                transform (function, optional) : a function that is applied
+                    to every block of rows before it is reduced.
+                rhs (array, optional) : the right hand side of the 'dot'
+                    reduction, a vector or a matrix.
+                block_rows (int, optional) : the number of rows that are read
+                    from the file at once, defaults to 4096.
+
+            Returns:
+
+            The reduction of the (transformed) contents of a csv file. The
+            file is never read into memory as a whole, at most two blocks of
+            rows are held in memory at any point in time. For instance,
+            `file_stream_csv(f, "mean", 0, lambda(x, x * w))` is equivalent to
+            `mean(file_read_csv(f) * w, 0)`.)"
+            )
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    file_stream_csv::file_stream_csv(
+            primitive_arguments_type && operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Incrementally reduces a sequence of blocks of rows. Mean and
+        // variance are accumulated using the pairwise update of Chan et al.,
+        // which is numerically stable independently of the number of blocks.
+        class stream_accumulator
+        {
+        public:
+            using reduction = file_stream_csv::stream_reduction;
+
+            stream_accumulator(reduction op, bool has_axis, std::int64_t axis,
+                    ir::node_data<double>&& rhs)
+              : op_(op)
+              , has_axis_(has_axis)
+              , axis_(axis)
+              , rhs_(std::move(rhs))
+              , count_(0)
+              , value_(initial_value())
+              , mean_(0.0)
+              , m2_(0.0)
+            {
+            }
+
+            void operator()(blaze::DynamicMatrix<double> const& block)
+            {
+                if (op_ == file_stream_csv::stream_dot)
+                {
+                    consume_dot(block);
+                }
+                else if (!has_axis_)
+                {
+                    consume_all(block);
+                }
+                else if (axis_ == 0)
+                {
+                    consume_columns(block);
+                }
+                else
+                {
+                    consume_rows(block);
+                }
+            }
+
+            primitive_argument_type result(bool vector_blocks) &&
+            {
+                if (op_ == file_stream_csv::stream_dot)
+                {
+                    if (rhs_.num_dimensions() == 2)
+                    {
+                        std::size_t columns = rhs_.dimension(1);
+                        return primitive_argument_type{
+                            blaze::DynamicMatrix<double>(
+                                results_.size() / columns, columns,
+                                results_.data())};
+                    }
+                    return primitive_argument_type{blaze::DynamicVector<double>(
+                        results_.size(), results_.data())};
+                }
+
+                if (!has_axis_)
+                {
+                    return primitive_argument_type{scalar_result()};
+                }
+
+                if (axis_ == 0)
+                {
+                    blaze::DynamicVector<double> result = vector_result();
+                    if (vector_blocks)
+                    {
+                        return primitive_argument_type{result[0]};
+                    }
+                    return primitive_argument_type{std::move(result)};
+                }
+
+                return primitive_argument_type{blaze::DynamicVector<double>(
+                    results_.size(), results_.data())};
+            }
+
+        private:
+            double initial_value() const
+            {
+                switch (op_)
+                {
+                case file_stream_csv::stream_min:
+                    return (std::numeric_limits<double>::max)();
+
+                case file_stream_csv::stream_max:
+                    return std::numeric_limits<double>::lowest();
+
+                default:
+                    break;
+                }
+                return 0.0;
+            }
+
+            static void merge(std::size_t n_a, double& mean_a, double& m2_a,
+                std::size_t n_b, double mean_b, double m2_b)
+            {
+                double const n = static_cast<double>(n_a + n_b);
+                double const delta = mean_b - mean_a;
+                mean_a += delta * (n_b / n);
+                m2_a += m2_b + delta * delta * (double(n_a) * n_b / n);
+            }
+
+            double scalar_result() const
+            {
+                switch (op_)
+                {
+                case file_stream_csv::stream_mean:
+                    return value_ / count_;
+
+                case file_stream_csv::stream_var:
+                    return m2_ / count_;
+
+                default:
+                    break;
+                }
+                return value_;
+            }
+
+            blaze::DynamicVector<double> vector_result() const
+            {
+                switch (op_)
+                {
+                case file_stream_csv::stream_mean:
+                    return values_ / double(count_);
+
+                case file_stream_csv::stream_var:
+                    return m2s_ / double(count_);
+
+                default:
+                    break;
+                }
+                return values_;
+            }
+
+            // reduce all elements of the block
+            void consume_all(blaze::DynamicMatrix<double> const& block)
+            {
+                std::size_t const size = block.rows() * block.columns();
+                if (size == 0)
+                {
+                    return;
+                }
+
+                switch (op_)
+                {
+                case file_stream_csv::stream_sum: HPX_FALLTHROUGH;
+                case file_stream_csv::stream_mean:
+                    value_ += blaze::sum(block);
+                    break;
+
+                case file_stream_csv::stream_var:
+                    {
+                        double const mean = blaze::sum(block) / size;
+                        double m2 = 0.0;
+                        for (std::size_t i = 0; i != block.rows(); ++i)
+                        {
+                            for (std::size_t j = 0; j != block.columns(); ++j)
+                            {
+                                double const d = block(i, j) - mean;
+                                m2 += d * d;
+                            }
+                        }
+                        merge(count_, mean_, m2_, size, mean, m2);
+                    }
+                    break;
+
+                case file_stream_csv::stream_min:
+                    value_ = (std::min)(value_, blaze::min(block));
+                    break;
+
+                case file_stream_csv::stream_max:
+                    value_ = (std::max)(value_, blaze::max(block));
+                    break;
+
+                default:
+                    break;
+                }
+
+                count_ += size;
+            }
+
+            // reduce the block along its rows (axis 0)
+            void consume_columns(blaze::DynamicMatrix<double> const& block)
+            {
+                std::size_t const rows = block.rows();
+                std::size_t const columns = block.columns();
+                if (rows == 0)
+                {
+                    return;
+                }
+
+                if (count_ == 0)
+                {
+                    values_ = blaze::DynamicVector<double>(
+                        columns, initial_value());
+                    m2s_ = blaze::DynamicVector<double>(columns, 0.0);
+                }
+
+                switch (op_)
+                {
+                case file_stream_csv::stream_sum: HPX_FALLTHROUGH;
+                case file_stream_csv::stream_mean:
+                    for (std::size_t i = 0; i != rows; ++i)
+                    {
+                        values_ += blaze::trans(blaze::row(block, i));
+                    }
+                    break;
+
+                case file_stream_csv::stream_var:
+                    {
+                        blaze::DynamicVector<double> mean(columns, 0.0);
+                        for (std::size_t i = 0; i != rows; ++i)
+                        {
+                            mean += blaze::trans(blaze::row(block, i));
+                        }
+                        mean /= double(rows);
+
+                        blaze::DynamicVector<double> m2(columns, 0.0);
+                        for (std::size_t i = 0; i != rows; ++i)
+                        {
+                            for (std::size_t j = 0; j != columns; ++j)
+                            {
+                                double const d = block(i, j) - mean[j];
+                                m2[j] += d * d;
+                            }
+                        }
+
+                        // values_ holds the running means
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            merge(count_, values_[j], m2s_[j], rows, mean[j],
+                                m2[j]);
+                        }
+                    }
+                    break;
+
+                case file_stream_csv::stream_min:
+                    for (std::size_t i = 0; i != rows; ++i)
+                    {
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            values_[j] = (std::min)(values_[j], block(i, j));
+                        }
+                    }
+                    break;
+
+                case file_stream_csv::stream_max:
+                    for (std::size_t i = 0; i != rows; ++i)
+                    {
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            values_[j] = (std::max)(values_[j], block(i, j));
+                        }
+                    }
+                    break;
+
+                default:
+                    break;
+                }
+
+                count_ += rows;
+            }
+
+            // reduce every row of the block (axis 1)
+            void consume_rows(blaze::DynamicMatrix<double> const& block)
+            {
+                std::size_t const columns = block.columns();
+                for (std::size_t i = 0; i != block.rows(); ++i)
+                {
+                    auto row = blaze::row(block, i);
+                    switch (op_)
+                    {
+                    case file_stream_csv::stream_sum:
+                        results_.push_back(blaze::sum(row));
+                        break;
+
+                    case file_stream_csv::stream_mean:
+                        results_.push_back(blaze::sum(row) / columns);
+                        break;
+
+                    case file_stream_csv::stream_var:
+                        {
+                            double const mean = blaze::sum(row) / columns;
+                            double m2 = 0.0;
+                            for (std::size_t j = 0; j != columns; ++j)
+                            {
+                                double const d = row[j] - mean;
+                                m2 += d * d;
+                            }
+                            results_.push_back(m2 / columns);
+                        }
+                        break;
+
+                    case file_stream_csv::stream_min:
+                        results_.push_back(blaze::min(row));
+                        break;
+
+                    case file_stream_csv::stream_max:
+                        results_.push_back(blaze::max(row));
+                        break;
+
+                    default:
+                        break;
+                    }
+                }
+                count_ += block.rows();
+            }
+
+            // multiply the block with the right hand side
+            void consume_dot(blaze::DynamicMatrix<double> const& block)
+            {
+                if (rhs_.num_dimensions() == 2)
+                {
+                    blaze::DynamicMatrix<double> result = block * rhs_.matrix();
+                    for (std::size_t i = 0; i != result.rows(); ++i)
+                    {
+                        auto row = blaze::row(result, i);
+                        results_.insert(results_.end(), row.begin(), row.end());
+                    }
+                }
+                else
+                {
+                    blaze::DynamicVector<double> result = block * rhs_.vector();
+                    results_.insert(
+                        results_.end(), result.begin(), result.end());
+                }
+                count_ += block.rows();
+            }
+
+        private:
+            reduction op_;
+            bool has_axis_;
+            std::int64_t axis_;
+            ir::node_data<double> rhs_;
+
+            std::size_t count_;
+
+            // reduction of all elements
+            double value_;
+            double mean_;
+            double m2_;
+
+            // reduction along axis 0
+            blaze::DynamicVector<double> values_;
+            blaze::DynamicVector<double> m2s_;
+
+            // results for axis 1 and dot, one (or more) values per row
+            std::vector<double> results_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    file_stream_csv::stream_reduction file_stream_csv::extract_reduction(
+        std::string const& name) const
+    {
+        if (name == "sum")
+            return stream_sum;
+        if (name == "mean")
+            return stream_mean;
+        if (name == "var")
+            return stream_var;
+        if (name == "min")
+            return stream_min;
+        if (name == "max")
+            return stream_max;
+        if (name == "dot")
+            return stream_dot;
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "file_stream_csv::extract_reduction",
+            generate_error_message("unknown reduction '" + name +
+                "', expected one of 'sum', 'mean', 'var', 'min', 'max', or "
+                "'dot'"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type file_stream_csv::stream(std::string const& filename,
+        stream_reduction reduction, std::int64_t axis, bool has_axis,
+        primitive_argument_type&& transform, primitive_argument_type&& rhs,
+        std::size_t block_rows, eval_context ctx) const
+    {
+        ir::node_data<double> rhs_data;
+        if (reduction == stream_dot)
+        {
+            if (!valid(rhs))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "file_stream_csv::stream",
+                    generate_error_message(
+                        "the 'dot' reduction requires a right hand side"));
+            }
+
+            rhs_data = extract_numeric_value(std::move(rhs), name_, codename_);
+            if (rhs_data.num_dimensions() != 1 &&
+                rhs_data.num_dimensions() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "file_stream_csv::stream",
+                    generate_error_message(
+                        "the right hand side of the 'dot' reduction must be "
+                        "a vector or a matrix"));
+            }
+        }
+
+        std::ifstream infile(filename.c_str(), std::ios::in);
+        if (!infile.is_open())
+        {
+            throw std::runtime_error(
+                generate_error_message("couldn't open file: " + filename));
+        }
+
+        csv_block_reader reader(std::move(infile), filename);
+
+        std::vector<double> current;
+        std::vector<double> next;
+
+        std::size_t rows = reader.read_block(current, block_rows);
+        if (rows == 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "file_stream_csv::stream",
+                generate_error_message("the file " + filename +
+                    " does not contain any data"));
+        }
+
+        std::size_t const file_columns = reader.columns();
+        std::size_t const rhs_rows =
+            reduction == stream_dot ? rhs_data.dimension(0) : 0;
+
+        detail::stream_accumulator accumulate(
+            reduction, has_axis, axis, std::move(rhs_data));
+
+        bool first = true;
+        bool vector_blocks = false;
+        std::size_t columns = 0;
+
+        while (rows != 0)
+        {
+            // read the next block while the current one is being reduced
+            hpx::future<std::size_t> f = hpx::async(
+                [&]() { return reader.read_block(next, block_rows); });
+
+            try
+            {
+                blaze::DynamicMatrix<double> block(
+                    rows, file_columns, current.data());
+
+                if (valid(transform))
+                {
+                    primitive_arguments_type fargs;
+                    fargs.emplace_back(std::move(block));
+
+                    auto data = extract_numeric_value(
+                        value_operand_sync(transform, std::move(fargs), name_,
+                            codename_, ctx),
+                        name_, codename_);
+
+                    bool is_vector = data.num_dimensions() < 2;
+                    switch (data.num_dimensions())
+                    {
+                    case 0:
+                        block = blaze::DynamicMatrix<double>(
+                            1, 1, data.scalar());
+                        break;
+
+                    case 1:
+                        {
+                            auto v = data.vector();
+                            block = blaze::DynamicMatrix<double>(v.size(), 1);
+                            blaze::column(block, 0) = v;
+                        }
+                        break;
+
+                    case 2:
+                        block = data.matrix();
+                        break;
+
+                    default:
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "file_stream_csv::stream",
+                            generate_error_message(
+                                "the transform function must return a "
+                                "scalar, a vector or a matrix"));
+                    }
+
+                    if (first)
+                    {
+                        vector_blocks = is_vector;
+                    }
+                    else if (vector_blocks != is_vector)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "file_stream_csv::stream",
+                            generate_error_message(
+                                "the transform function must return values "
+                                "of the same dimensionality for all blocks"));
+                    }
+                }
+
+                if (first)
+                {
+                    columns = block.columns();
+
+                    if (has_axis && axis == 1 && vector_blocks &&
+                        reduction != stream_dot)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "file_stream_csv::stream",
+                            generate_error_message(
+                                "axis 1 is out of bounds for the "
+                                "one-dimensional transformed data"));
+                    }
+
+                    if (reduction == stream_dot && rhs_rows != columns)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "file_stream_csv::stream",
+                            generate_error_message(
+                                "the number of columns of the (transformed) "
+                                "data does not match the size of the right "
+                                "hand side of the 'dot' reduction"));
+                    }
+                }
+                else if (block.columns() != columns)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "file_stream_csv::stream",
+                        generate_error_message(
+                            "all (transformed) blocks of rows must have the "
+                            "same number of columns"));
+                }
+
+                accumulate(block);
+                first = false;
+            }
+            catch (...)
+            {
+                // the reader and the buffers must outlive the pending read
+                f.wait();
+                throw;
+            }
+
+            rows = f.get();
+            std::swap(current, next);
+        }
+
+        return std::move(accumulate).result(vector_blocks);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> file_stream_csv::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 6)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "file_stream_csv::eval",
+                generate_error_message("the file_stream_csv primitive "
+                    "requires at least two and at most 6 operands."));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "file_stream_csv::eval",
+                generate_error_message(
+                    "the file_stream_csv primitive requires that the "
+                    "filename and the reduction are valid"));
+        }
+
+        // the transform function is bound, not invoked
+        primitive_arguments_type values(operands);
+        hpx::future<primitive_argument_type> transform;
+        if (values.size() > 3 && valid(values[3]))
+        {
+            transform = value_operand(values[3], args, name_, codename_,
+                add_mode(ctx, eval_mode(eval_dont_evaluate_lambdas |
+                    eval_dont_evaluate_partials)));
+            values[3] = primitive_argument_type{};
+        }
+        else
+        {
+            transform = hpx::make_ready_future(primitive_argument_type{});
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_), ctx](primitive_arguments_type&& args,
+                primitive_argument_type&& transform)
+            -> primitive_argument_type
+            {
+                std::string filename = extract_string_value_strict(
+                    std::move(args[0]), this_->name_, this_->codename_);
+
+                stream_reduction reduction =
+                    this_->extract_reduction(extract_string_value_strict(
+                        std::move(args[1]), this_->name_, this_->codename_));
+
+                bool has_axis = false;
+                std::int64_t axis = 0;
+                if (args.size() > 2 && valid(args[2]))
+                {
+                    has_axis = true;
+                    axis = extract_scalar_integer_value_strict(
+                        std::move(args[2]), this_->name_, this_->codename_);
+                    if (axis < 0)
+                    {
+                        axis += 2;
+                    }
+                    if (axis != 0 && axis != 1)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "file_stream_csv::eval",
+                            this_->generate_error_message(
+                                "the axis must be either 0 or 1"));
+                    }
+                }
+
+                if (valid(transform) &&
+                    util::get_if<primitive>(&transform) == nullptr)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "file_stream_csv::eval",
+                        this_->generate_error_message(
+                            "the transform argument must be an invocable "
+                            "object"));
+                }
+
+                primitive_argument_type rhs;
+                if (args.size() > 4)
+                {
+                    rhs = std::move(args[4]);
+                }
+
+                std::size_t block_rows = 4096;
+                if (args.size() > 5 && valid(args[5]))
+                {
+                    block_rows = static_cast<std::size_t>(
+                        extract_scalar_positive_integer_value_strict(
+                            std::move(args[5]), this_->name_,
+                            this_->codename_));
+                }
+
+                return this_->stream(filename, reduction, axis, has_axis,
+                    std::move(transform), std::move(rhs), block_rows,
+                    std::move(ctx));
+            }),
+            detail::map_operands(values, functional::value_operand{}, args,
+                name_, codename_, ctx),
+            std::move(transform));
+    }
+}}}
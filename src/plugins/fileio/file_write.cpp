@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/async_file_write.hpp>
 #include <phylanx/plugins/fileio/file_write.hpp>
 #include <phylanx/util/serialization/ast.hpp>
 #include <phylanx/util/serialization/execution_tree.hpp>
@@ -30,13 +31,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
     match_pattern_type const file_write::match_data =
     {
         hpx::make_tuple("file_write",
-            std::vector<std::string>{"file_write(_1, _2)"},
+            std::vector<std::string>{
+                "file_write(_1, _2, __arg(_3_async, false))"},
             &create_file_write, &create_primitive<file_write>,
-            R"(fname, obj
+            R"(fname, obj, async
             Args:
 
                 fname (string): the file in which to save the data
                 obj (object): the object to serialize
+                async (bool, optional): if true, the object is serialized
+                    and the primitive returns without waiting for the data
+                    to be written, use file_write_wait() to wait for all
+                    outstanding writes (default: false)
 
             Returns:)"
             )
@@ -76,16 +82,42 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::move(val), std::move(filename));
     }
 
+    void file_write::write_to_file_async(
+        primitive_argument_type const& val, std::string&& filename) const
+    {
+        // serializing the value creates the snapshot to write
+        auto this_ = this->shared_from_this();
+        detail::launch_async_write(
+            [this_ = std::move(this_), data = phylanx::util::serialize(val),
+                filename = std::move(filename)]()
+            {
+                std::ofstream outfile(filename.c_str(),
+                    std::ios::binary | std::ios::out | std::ios::trunc);
+                if (!outfile.is_open())
+                {
+                    throw std::runtime_error(this_->generate_error_message(
+                        "couldn't open file: " + filename));
+                }
+
+                if (!outfile.write(data.data(), data.size()))
+                {
+                    throw std::runtime_error(this_->generate_error_message(
+                        "couldn't write expected number of bytes to file: " +
+                        filename));
+                }
+            });
+    }
+
     hpx::future<primitive_argument_type> file_write::eval(
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 2)
+        if (operands.size() != 2 && operands.size() != 3)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_write::eval",
                 generate_error_message(
-                    "the file_write primitive requires exactly two "
+                    "the file_write primitive requires two or three "
                     "operands"));
         }
 
@@ -101,12 +133,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::string filename = string_operand_sync(
             operands[0], args, name_, codename_, ctx);
 
+        bool async = false;
+        if (operands.size() > 2 && valid(operands[2]))
+        {
+            async = scalar_boolean_operand_sync(
+                operands[2], args, name_, codename_, ctx) != 0;
+        }
+
         auto this_ = this->shared_from_this();
         return value_operand(
                 operands[1], args, name_, codename_, std::move(ctx))
             .then(hpx::launch::sync, hpx::util::unwrapping(
-                [this_ = std::move(this_), filename = std::move(filename)](
-                        primitive_argument_type && val) mutable
+                [this_ = std::move(this_), filename = std::move(filename),
+                    async](primitive_argument_type && val) mutable
                 ->  hpx::future<primitive_argument_type>
                 {
                     if (!valid(val))
@@ -119,6 +158,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                 "non-empty"));
                     }
 
+                    if (async)
+                    {
+                        this_->write_to_file_async(val, std::move(filename));
+                        return hpx::make_ready_future(std::move(val));
+                    }
+
                     return this_->write_to_file(
                         std::move(val), std::move(filename));
                 }));
@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/async_file_write.hpp>
 #include <phylanx/plugins/fileio/file_write_csv.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
@@ -29,13 +30,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
     match_pattern_type const file_write_csv::match_data =
     {
         hpx::make_tuple("file_write_csv",
-            std::vector<std::string>{"file_write_csv(_1, _2)"},
+            std::vector<std::string>{
+                "file_write_csv(_1, _2, __arg(_3_async, false))"},
             &create_file_write_csv, &create_primitive<file_write_csv>,
-            R"(fname, m
+            R"(fname, m, async
             Args:
 
                 fname (string): a file name
                 m (array or matrix): an object to store in the file.
+                async (bool, optional): if true, the primitive returns
+                    without waiting for the data to be written, use
+                    file_write_wait() to wait for all outstanding writes
+                    (default: false)
 
             Returns:
 
@@ -51,80 +57,99 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
     }
 
-    hpx::future<primitive_argument_type>  file_write_csv::write_to_file_csv(
-        ir::node_data<double> && val, std::string && filename) const
+    void file_write_csv::write_csv(
+        ir::node_data<double> const& val, std::string const& filename) const
     {
-        auto this_ = this->shared_from_this();
-        return hpx::threads::run_as_os_thread(
-            [this_ = std::move(this_)](
-                ir::node_data<double> && val, std::string && filename)
-            -> primitive_argument_type
-            {
-                std::ofstream outfile(
-                    filename.c_str(), std::ios::out | std::ios::trunc);
-                if (!outfile.is_open())
-                {
-                    throw std::runtime_error(this_->generate_error_message(
-                        "couldn't open file: " + filename));
-                }
+        std::ofstream outfile(
+            filename.c_str(), std::ios::out | std::ios::trunc);
+        if (!outfile.is_open())
+        {
+            throw std::runtime_error(
+                generate_error_message("couldn't open file: " + filename));
+        }
 
-                outfile << std::setprecision(
-                    std::numeric_limits<long double>::digits10 + 1);
-                outfile << std::scientific;
+        outfile << std::setprecision(
+            std::numeric_limits<long double>::digits10 + 1);
+        outfile << std::scientific;
 
-                switch (val.num_dimensions())
-                {
-                case 0:
-                    outfile << val.scalar() << '\n';
-                    break;
+        switch (val.num_dimensions())
+        {
+        case 0:
+            outfile << val.scalar() << '\n';
+            break;
 
-                case 1:
+        case 1:
+            {
+                auto v = val.vector();
+                for (std::size_t i = 0UL; i != v.size(); ++i)
+                {
+                    if (i != 0)
                     {
-                        auto v = val.vector();
-                        for (std::size_t i = 0UL; i != v.size(); ++i)
-                        {
-                            if (i != 0)
-                            {
-                                outfile << ',';
-                            }
-                            outfile << v[i];
-                        }
-                        outfile << '\n';
+                        outfile << ',';
                     }
-                    break;
+                    outfile << v[i];
+                }
+                outfile << '\n';
+            }
+            break;
 
-                case 2:
+        case 2:
+            {
+                auto matrix = val.matrix();
+                for (std::size_t i = 0UL; i != matrix.rows(); ++i)
+                {
+                    outfile << matrix(i, 0);
+                    for (std::size_t j = 1UL; j != matrix.columns(); ++j)
                     {
-                        auto matrix = val.matrix();
-                        for (std::size_t i = 0UL; i != matrix.rows(); ++i)
-                        {
-                            outfile << matrix(i, 0);
-                            for (std::size_t j = 1UL; j != matrix.columns(); ++j)
-                            {
-                                outfile << ',' << matrix(i, j);
-                            }
-                            outfile << '\n';
-                        }
+                        outfile << ',' << matrix(i, j);
                     }
-                    break;
+                    outfile << '\n';
                 }
+            }
+            break;
+        }
+    }
 
+    hpx::future<primitive_argument_type>  file_write_csv::write_to_file_csv(
+        ir::node_data<double> && val, std::string && filename) const
+    {
+        auto this_ = this->shared_from_this();
+        return hpx::threads::run_as_os_thread(
+            [this_ = std::move(this_)](
+                ir::node_data<double> && val, std::string && filename)
+            -> primitive_argument_type
+            {
+                this_->write_csv(val, filename);
                 return primitive_argument_type{std::move(val)};
             },
             std::move(val), std::move(filename));
     }
 
+    void file_write_csv::write_to_file_csv_async(
+        ir::node_data<double> const& val, std::string&& filename) const
+    {
+        auto this_ = this->shared_from_this();
+        detail::launch_async_write(
+            [this_ = std::move(this_),
+                val = detail::snapshot_for_async_write(
+                    ir::node_data<double>{val}),
+                filename = std::move(filename)]()
+            {
+                this_->write_csv(val, filename);
+            });
+    }
+
     hpx::future<primitive_argument_type> file_write_csv::eval(
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 2)
+        if (operands.size() != 2 && operands.size() != 3)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_write::"
                     "file_write_csv",
                 generate_error_message(
-                    "the file_write primitive requires exactly two "
+                    "the file_write primitive requires two or three "
                         "operands"));
         }
 
@@ -140,14 +165,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::string filename = string_operand_sync(
             operands[0], args, name_, codename_, ctx);
 
+        bool async = false;
+        if (operands.size() > 2 && valid(operands[2]))
+        {
+            async = scalar_boolean_operand_sync(
+                operands[2], args, name_, codename_, ctx) != 0;
+        }
+
         auto this_ = this->shared_from_this();
         return numeric_operand(
                 operands[1], args, name_, codename_, std::move(ctx))
             .then(hpx::launch::sync, hpx::util::unwrapping(
-                [this_ = std::move(this_), filename = std::move(filename)](
-                        ir::node_data<double> && val) mutable
+                [this_ = std::move(this_), filename = std::move(filename),
+                    async](ir::node_data<double> && val) mutable
                 ->  hpx::future<primitive_argument_type>
                 {
+                    if (async)
+                    {
+                        this_->write_to_file_csv_async(
+                            val, std::move(filename));
+                        return hpx::make_ready_future(
+                            primitive_argument_type{std::move(val)});
+                    }
+
                     return this_->write_to_file_csv(
                         std::move(val), std::move(filename));
                 }));
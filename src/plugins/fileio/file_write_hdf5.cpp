@@ -7,6 +7,7 @@
 
 #if defined(PHYLANX_HAVE_HIGHFIVE)
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/async_file_write.hpp>
 #include <phylanx/plugins/fileio/file_write_hdf5.hpp>
 
 #include <hpx/include/lcos.hpp>
@@ -22,6 +23,7 @@
 #include <cstddef>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <utility>
@@ -34,14 +36,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
     match_pattern_type const file_write_hdf5::match_data =
     {
         hpx::make_tuple("file_write_hdf5",
-            std::vector<std::string>{"file_write_hdf5(_1, _2, _3)"},
+            std::vector<std::string>{
+                "file_write_hdf5(_1, _2, _3, __arg(_4_async, false))"},
             &create_file_write_hdf5, &create_primitive<file_write_hdf5>,
-            R"(fname,dsetname,data
+            R"(fname,dsetname,data,async
             Args:
 
                 fname (string) : a file name
                 dsetname (string) : a dataset name
                 data (matrix or vector) : a data set
+                async (bool, optional) : if true, the primitive returns
+                    without waiting for the data to be written, use
+                    file_write_wait() to wait for all outstanding writes
+                    (default: false)
 
             Returns:
 
@@ -57,9 +64,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
     }
 
+    namespace detail
+    {
+        // HDF5 is not necessarily built thread-safe, all writes (including
+        // the ones running in the background on separate OS threads) are
+        // serialized
+        std::mutex& hdf5_write_mutex()
+        {
+            static std::mutex mtx;
+            return mtx;
+        }
+    }
+
     void file_write_hdf5::write_to_file_hdf5(ir::node_data<double> const& val,
         std::string const& filename, std::string const& dataset_name) const
     {
+        std::lock_guard<std::mutex> l(detail::hdf5_write_mutex());
+
         HighFive::File outfile(filename,
             HighFive::File::ReadWrite | HighFive::File::Create |
                 HighFive::File::Truncate);
@@ -107,12 +128,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 3)
+        if (operands.size() != 3 && operands.size() != 4)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_write::file_write_hdf5",
                 generate_error_message(
-                    "the file_write primitive requires exactly three operands"));
+                    "the file_write primitive requires three or four "
+                    "operands"));
         }
 
         if (!valid(operands[0]) || !valid(operands[1]) ||
@@ -130,12 +152,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::string dataset_name =
             string_operand_sync(operands[1], args, name_, codename_, ctx);
 
+        bool async = false;
+        if (operands.size() > 3 && valid(operands[3]))
+        {
+            async = scalar_boolean_operand_sync(
+                operands[3], args, name_, codename_, ctx) != 0;
+        }
+
         auto this_ = this->shared_from_this();
         return numeric_operand(
                 operands[2], args, name_, codename_, std::move(ctx))
             .then(hpx::launch::sync, hpx::util::unwrapping(
                 [this_ = std::move(this_), filename = std::move(filename),
-                    dataset_name = std::move(dataset_name)](
+                    dataset_name = std::move(dataset_name), async](
                     ir::node_data<double>&& val) mutable
                 -> primitive_argument_type
                 {
@@ -149,6 +178,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                 "non-empty"));
                     }
 
+                    if (async)
+                    {
+                        detail::launch_async_write(
+                            [this_,
+                                data = detail::snapshot_for_async_write(
+                                    ir::node_data<double>{val}),
+                                filename = std::move(filename),
+                                dataset_name = std::move(dataset_name)]()
+                            {
+                                this_->write_to_file_hdf5(
+                                    data, filename, dataset_name);
+                            });
+                        return primitive_argument_type(std::move(val));
+                    }
+
                     this_->write_to_file_hdf5(val, std::move(filename),
                         std::move(dataset_name));
                     return primitive_argument_type(std::move(val));
@@ -0,0 +1,69 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/fileio/async_file_write.hpp>
+#include <phylanx/plugins/fileio/file_write_wait.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const file_write_wait::match_data =
+    {
+        hpx::make_tuple("file_write_wait",
+            std::vector<std::string>{"file_write_wait()"},
+            &create_file_write_wait, &create_primitive<file_write_wait>,
+            R"(
+            Args:
+
+            Returns:
+
+            Waits for all asynchronous file writes (issued by file_write,
+            file_write_csv, or file_write_hdf5 with async=true) to finish.
+            Returns the number of writes that were waited for. Errors which
+            occurred while writing are reported here.)"
+            )
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    file_write_wait::file_write_wait(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    hpx::future<primitive_argument_type> file_write_wait::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (!operands.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::file_write_wait::eval",
+                generate_error_message(
+                    "the file_write_wait primitive does not accept any "
+                    "operands"));
+        }
+
+        return detail::wait_for_async_writes().then(hpx::launch::sync,
+            [](hpx::future<std::size_t>&& f)
+            {
+                return primitive_argument_type{
+                    static_cast<std::int64_t>(f.get())};
+            });
+    }
+}}}
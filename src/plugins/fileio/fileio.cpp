@@ -15,10 +15,14 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(file_read_plugin,
     phylanx::execution_tree::primitives::file_read::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(file_read_csv_plugin,
     phylanx::execution_tree::primitives::file_read_csv::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(file_stream_csv_plugin,
+    phylanx::execution_tree::primitives::file_stream_csv::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(file_write_plugin,
     phylanx::execution_tree::primitives::file_write::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(file_write_csv_plugin,
     phylanx::execution_tree::primitives::file_write_csv::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(file_write_wait_plugin,
+    phylanx::execution_tree::primitives::file_write_wait::match_data);
 
 #if defined(PHYLANX_HAVE_HIGHFIVE)
 PHYLANX_REGISTER_PLUGIN_FACTORY(file_read_hdf5_plugin,
@@ -11,9 +11,11 @@
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -28,6 +30,236 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Per page products up to this number of multiply-adds are computed
+        // by the batched kernels below, larger ones are handed to Blaze.
+        constexpr std::size_t batch_dot_max_kernel_work = 128 * 128 * 128;
+
+        // Minimal number of multiply-adds a single HPX task is responsible
+        // for, small pages are grouped until this amount of work is reached.
+        constexpr std::size_t batch_dot_min_task_work = 65536;
+
+        // Strided view of one operand of the batched product: element (i, k)
+        // of page p is located at
+        //     data_ + p * page_stride_ + i * row_stride_ + k * column_stride_
+        template <typename T>
+        struct batch_dot_operand
+        {
+            T const* page(std::size_t p) const
+            {
+                return data_ + p * page_stride_;
+            }
+
+            T const* data_;
+            std::size_t page_stride_;
+            std::size_t row_stride_;
+            std::size_t column_stride_;
+        };
+
+        // The i'th row of a matrix seen as a (1 x columns) page
+        template <typename Matrix>
+        batch_dot_operand<typename Matrix::ElementType> batch_dot_rows(
+            Matrix const& m)
+        {
+            return {m.data(), m.spacing(), 0, 1};
+        }
+
+        // The i'th row of a matrix seen as a (columns x 1) page
+        template <typename Matrix>
+        batch_dot_operand<typename Matrix::ElementType> batch_dot_columns(
+            Matrix const& m)
+        {
+            return {m.data(), m.spacing(), 1, 0};
+        }
+
+        // The pages of a tensor, optionally transposed
+        template <typename Tensor>
+        batch_dot_operand<typename Tensor::ElementType> batch_dot_pages(
+            Tensor const& t, bool transposed = false)
+        {
+            std::size_t const page_stride = t.rows() * t.spacing();
+            if (transposed)
+            {
+                return {t.data(), page_stride, 1, t.spacing()};
+            }
+            return {t.data(), page_stride, t.spacing(), 1};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // c (m x N) = a (m x k) * b (k x N), the rows of b are contiguous.
+        // N is known at compile time, which allows for the accumulators to
+        // be kept in registers and for the inner loop to be fully unrolled.
+        template <std::size_t N, typename T>
+        void batch_gemm_page(T const* a, std::size_t a_row_stride,
+            std::size_t a_column_stride, T const* b, std::size_t b_row_stride,
+            T* c, std::size_t c_row_stride, std::size_t m, std::size_t k)
+        {
+            for (std::size_t i = 0; i != m; ++i)
+            {
+                T acc[N] = {};
+
+                T const* ai = a + i * a_row_stride;
+                for (std::size_t l = 0; l != k; ++l)
+                {
+                    T const ail = ai[l * a_column_stride];
+                    T const* bl = b + l * b_row_stride;
+                    for (std::size_t j = 0; j != N; ++j)
+                    {
+                        acc[j] += ail * bl[j];
+                    }
+                }
+
+                std::copy(acc, acc + N, c + i * c_row_stride);
+            }
+        }
+
+        // Same as above, for an arbitrary number of columns
+        template <typename T>
+        void batch_gemm_page(T const* a, std::size_t a_row_stride,
+            std::size_t a_column_stride, T const* b, std::size_t b_row_stride,
+            T* c, std::size_t c_row_stride, std::size_t m, std::size_t k,
+            std::size_t n)
+        {
+            switch (n)
+            {
+            case 1:
+                return batch_gemm_page<1>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            case 2:
+                return batch_gemm_page<2>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            case 3:
+                return batch_gemm_page<3>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            case 4:
+                return batch_gemm_page<4>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            case 8:
+                return batch_gemm_page<8>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            case 16:
+                return batch_gemm_page<16>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            case 32:
+                return batch_gemm_page<32>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            case 64:
+                return batch_gemm_page<64>(a, a_row_stride, a_column_stride, b,
+                    b_row_stride, c, c_row_stride, m, k);
+            default:
+                break;
+            }
+
+            for (std::size_t i = 0; i != m; ++i)
+            {
+                T* ci = c + i * c_row_stride;
+                std::fill(ci, ci + n, T(0));
+
+                T const* ai = a + i * a_row_stride;
+                for (std::size_t l = 0; l != k; ++l)
+                {
+                    T const ail = ai[l * a_column_stride];
+                    T const* bl = b + l * b_row_stride;
+                    for (std::size_t j = 0; j != n; ++j)
+                    {
+                        ci[j] += ail * bl[j];
+                    }
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inline bool batch_gemm_supported(
+            std::size_t m, std::size_t k, std::size_t n)
+        {
+            return m * k * n <= batch_dot_max_kernel_work;
+        }
+
+        template <typename F>
+        void batch_dot_for_loop(std::size_t count, F&& f)
+        {
+            if (count > 1)
+            {
+                hpx::for_loop(hpx::execution::par, std::size_t(0), count, f);
+            }
+            else if (count == 1)
+            {
+                f(0);
+            }
+        }
+
+        // Compute the pages of c = a * b for all pages at once. Consecutive
+        // pages are grouped into tasks of at least batch_dot_min_task_work
+        // multiply-adds, the tasks are executed concurrently. Pages of b
+        // with non-contiguous rows are packed before being multiplied.
+        template <typename T>
+        void batch_gemm(batch_dot_operand<T> const& a,
+            batch_dot_operand<T> const& b, T* c, std::size_t c_page_stride,
+            std::size_t c_row_stride, std::size_t pages, std::size_t m,
+            std::size_t k, std::size_t n)
+        {
+            bool const pack = b.column_stride_ != 1 && n != 1;
+
+            std::size_t const page_work = (std::max)(m * k * n, std::size_t(1));
+            std::size_t const pages_per_task = (std::max)(
+                batch_dot_min_task_work / page_work, std::size_t(1));
+            std::size_t const tasks =
+                (pages + pages_per_task - 1) / pages_per_task;
+
+            batch_dot_for_loop(tasks, [&](std::size_t task)
+            {
+                std::vector<T> packed(pack ? k * n : 0);
+
+                std::size_t const first = task * pages_per_task;
+                std::size_t const last =
+                    (std::min)(first + pages_per_task, pages);
+
+                for (std::size_t p = first; p != last; ++p)
+                {
+                    T const* bp = b.page(p);
+                    std::size_t b_row_stride = b.row_stride_;
+                    if (pack)
+                    {
+                        for (std::size_t l = 0; l != k; ++l)
+                        {
+                            for (std::size_t j = 0; j != n; ++j)
+                            {
+                                packed[l * n + j] = bp[l * b.row_stride_ +
+                                    j * b.column_stride_];
+                            }
+                        }
+                        bp = packed.data();
+                        b_row_stride = n;
+                    }
+
+                    batch_gemm_page(a.page(p), a.row_stride_,
+                        a.column_stride_, bp, b_row_stride,
+                        c + p * c_page_stride, c_row_stride, m, k, n);
+                }
+            });
+        }
+
+        template <typename T>
+        void batch_gemm(batch_dot_operand<T> const& a,
+            batch_dot_operand<T> const& b, blaze::DynamicMatrix<T>& c,
+            std::size_t k)
+        {
+            batch_gemm(a, b, c.data(), c.spacing(), 0, c.rows(), 1, k,
+                c.columns());
+        }
+
+        template <typename T>
+        void batch_gemm(batch_dot_operand<T> const& a,
+            batch_dot_operand<T> const& b, blaze::DynamicTensor<T>& c,
+            std::size_t k)
+        {
+            batch_gemm(a, b, c.data(), c.rows() * c.spacing(), c.spacing(),
+                c.pages(), c.rows(), k, c.columns());
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     match_pattern_type const batch_dot_operation::match_data = {
         hpx::make_tuple("batch_dot",
@@ -181,10 +413,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(m1.rows(), 1);
 
-        for (std::size_t i = 0; i != m1.rows(); ++i)
-
-            blaze::row(result, i) =
-                blaze::dot(blaze::row(m1, i), blaze::row(m2, i));
+        detail::batch_gemm(detail::batch_dot_rows(m1),
+            detail::batch_dot_columns(m2), result, m1.columns());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -198,9 +428,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.columns());
 
-        for (std::size_t i = 0; i != m.rows(); ++i)
-
-            blaze::row(result, i) = blaze::row(m, i) * blaze::pageslice(t, i);
+        if (detail::batch_gemm_supported(1, t.rows(), t.columns()))
+        {
+            detail::batch_gemm(detail::batch_dot_rows(m),
+                detail::batch_dot_pages(t), result, t.rows());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t.pages(), [&](std::size_t i)
+            {
+                blaze::row(result, i) =
+                    blaze::row(m, i) * blaze::pageslice(t, i);
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -214,9 +454,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(result, i) =
-                blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+        if (detail::batch_gemm_supported(1, t.columns(), t.rows()))
+        {
+            detail::batch_gemm(detail::batch_dot_rows(m),
+                detail::batch_dot_pages(t, true), result, t.columns());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t.pages(), [&](std::size_t i)
+            {
+                blaze::row(result, i) =
+                    blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -288,10 +538,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-
-            blaze::row(result, i) =
-                blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+        if (detail::batch_gemm_supported(1, t.columns(), t.rows()))
+        {
+            detail::batch_gemm(detail::batch_dot_rows(m),
+                detail::batch_dot_pages(t, true), result, t.columns());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t.pages(), [&](std::size_t i)
+            {
+                blaze::row(result, i) =
+                    blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -305,8 +564,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.columns());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(result, i) = blaze::row(m, i) * blaze::pageslice(t, i);
+        if (detail::batch_gemm_supported(1, t.rows(), t.columns()))
+        {
+            detail::batch_gemm(detail::batch_dot_rows(m),
+                detail::batch_dot_pages(t), result, t.rows());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t.pages(), [&](std::size_t i)
+            {
+                blaze::row(result, i) =
+                    blaze::row(m, i) * blaze::pageslice(t, i);
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -334,10 +604,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.columns());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::pageslice(t2, i);
+        if (detail::batch_gemm_supported(t1.rows(), t1.columns(), t2.columns()))
+        {
+            detail::batch_gemm(detail::batch_dot_pages(t1),
+                detail::batch_dot_pages(t2), result, t1.columns());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t1.pages(), [&](std::size_t i)
+            {
+                blaze::pageslice(result, i) =
+                    blaze::pageslice(t1, i) * blaze::pageslice(t2, i);
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -351,10 +630,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.columns());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t1, i)) * blaze::pageslice(t2, i);
+        if (detail::batch_gemm_supported(t1.columns(), t1.rows(), t2.columns()))
+        {
+            detail::batch_gemm(detail::batch_dot_pages(t1, true),
+                detail::batch_dot_pages(t2), result, t1.rows());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t1.pages(), [&](std::size_t i)
+            {
+                blaze::pageslice(result, i) = blaze::trans(
+                    blaze::pageslice(t1, i)) * blaze::pageslice(t2, i);
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -368,10 +656,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.rows());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::trans(blaze::pageslice(t2, i));
+        if (detail::batch_gemm_supported(t1.rows(), t1.columns(), t2.rows()))
+        {
+            detail::batch_gemm(detail::batch_dot_pages(t1),
+                detail::batch_dot_pages(t2, true), result, t1.columns());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t1.pages(), [&](std::size_t i)
+            {
+                blaze::pageslice(result, i) = blaze::pageslice(t1, i) *
+                    blaze::trans(blaze::pageslice(t2, i));
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -385,10 +682,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.rows());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t2, i) * blaze::pageslice(t1, i));
+        if (detail::batch_gemm_supported(t1.columns(), t1.rows(), t2.rows()))
+        {
+            detail::batch_gemm(detail::batch_dot_pages(t1, true),
+                detail::batch_dot_pages(t2, true), result, t1.rows());
+        }
+        else
+        {
+            detail::batch_dot_for_loop(t1.pages(), [&](std::size_t i)
+            {
+                blaze::pageslice(result, i) = blaze::trans(
+                    blaze::pageslice(t2, i) * blaze::pageslice(t1, i));
+            });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
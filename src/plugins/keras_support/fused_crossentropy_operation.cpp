@@ -0,0 +1,422 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+#include <phylanx/plugins/keras_support/fused_crossentropy_operation.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const
+        fused_crossentropy_operation::match_data =
+    {
+        match_pattern_type{"softmax_cross_entropy_with_logits",
+        std::vector<std::string>{
+            "softmax_cross_entropy_with_logits(_1_target,_2_logits)"
+        },
+        &create_softmax_cross_entropy_with_logits_operation,
+        &create_primitive<fused_crossentropy_operation>,
+        R"(target, logits
+        Args:
+
+            target (array_like) : the labels, usually one-hot encoded
+            logits (array_like) : unscaled log probabilities, same shape as
+                target
+
+        Returns:
+
+        A list [loss, gradient], where loss has the shape of logits without
+        its last axis and gradient is the derivative of the loss with respect
+        to logits. The value should be the same as would be returned by the
+        following Python function:
+
+        def softmax_cross_entropy_with_logits(target, logits):
+            s = softmax(logits, axis=-1)
+            loss = np.sum(target * -np.log(s), axis=-1)
+            grad = s * np.sum(target, axis=-1, keepdims=True) - target
+            return [loss, grad]
+
+        The softmax is never materialized, the loss and the gradient are
+        computed in one pass over the logits.)"},
+
+        match_pattern_type{"sigmoid_cross_entropy_with_logits",
+        std::vector<std::string>{
+            "sigmoid_cross_entropy_with_logits(_1_target,_2_logits)"
+        },
+        &create_sigmoid_cross_entropy_with_logits_operation,
+        &create_primitive<fused_crossentropy_operation>,
+        R"(target, logits
+        Args:
+
+            target (array_like) : the labels, values in the range [0, 1]
+            logits (array_like) : unscaled log odds, same shape as target
+
+        Returns:
+
+        A list [loss, gradient], both of the shape of logits. The value
+        should be the same as would be returned by the following Python
+        function:
+
+        def sigmoid_cross_entropy_with_logits(target, logits):
+            loss = (np.maximum(logits, 0) - logits * target +
+                    np.log1p(np.exp(-np.abs(logits))))
+            grad = sigmoid(logits) - target
+            return [loss, grad]
+
+        The loss is evaluated in its numerically stable form, the sigmoid is
+        never materialized.)"}
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    fused_crossentropy_operation::crossentropy_mode extract_crossentropy_mode(
+        std::string const& name)
+    {
+        fused_crossentropy_operation::crossentropy_mode result =
+            fused_crossentropy_operation::crossentropy_mode_softmax;
+
+        if (name.find("sigmoid_cross_entropy_with_logits") != std::string::npos)
+        {
+            result = fused_crossentropy_operation::crossentropy_mode_sigmoid;
+        }
+        return result;
+    }
+
+    fused_crossentropy_operation::fused_crossentropy_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , mode_(extract_crossentropy_mode(name_))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Number of elements of a batch chunk. A chunk of the target, the
+        // logits, and the gradient should comfortably fit into the L2 cache.
+        constexpr std::size_t crossentropy_chunk_elements = 4096;
+
+        // Arrays smaller than this are not worth spawning HPX tasks for.
+        constexpr std::size_t crossentropy_min_parallel_elements = 16384;
+
+        // The arrays are seen as a sequence of rows of length 'columns' (the
+        // last axis), the batch being formed by all other axes.
+        inline std::size_t crossentropy_rows(ir::node_data<double> const& d)
+        {
+            auto dims = d.dimensions();
+            switch (d.num_dimensions())
+            {
+            case 2:
+                return dims[0];
+            case 3:
+                return dims[0] * dims[1];
+            default:
+                break;
+            }
+            return 1;
+        }
+
+        inline std::size_t crossentropy_columns(ir::node_data<double> const& d)
+        {
+            auto dims = d.dimensions();
+            switch (d.num_dimensions())
+            {
+            case 1:
+                return dims[0];
+            case 2:
+                return dims[1];
+            case 3:
+                return dims[2];
+            default:
+                break;
+            }
+            return 1;
+        }
+
+        // Blaze pads the rows of matrices and tensors, we need to access
+        // those separately.
+        inline double* crossentropy_row(ir::node_data<double>& d, std::size_t row)
+        {
+            switch (d.num_dimensions())
+            {
+            case 0:
+                return &d.scalar();
+            case 1:
+                return d.vector().data();
+            case 2:
+                return d.matrix().data(row);
+            case 3:
+                {
+                    auto t = d.tensor();
+                    return t.data(row % t.rows(), row / t.rows());
+                }
+            default:
+                break;
+            }
+            return nullptr;
+        }
+
+        // The per-row loss has one dimension less than the logits.
+        inline double& crossentropy_loss(
+            ir::node_data<double>& loss, std::size_t row)
+        {
+            switch (loss.num_dimensions())
+            {
+            case 1:
+                return loss.vector()[row];
+            case 2:
+                {
+                    auto m = loss.matrix();
+                    return m(row / m.columns(), row % m.columns());
+                }
+            default:
+                break;
+            }
+            return loss.scalar();
+        }
+
+        // Invoke f(first_row, last_row) for all chunks of rows, in parallel
+        // if the arrays are large enough.
+        template <typename F>
+        void crossentropy_for_each_chunk(
+            std::size_t rows, std::size_t columns, F&& f)
+        {
+            std::size_t chunk_rows = (std::max)(std::size_t(1),
+                crossentropy_chunk_elements /
+                    (std::max)(std::size_t(1), columns));
+            std::size_t chunks = (rows + chunk_rows - 1) / chunk_rows;
+
+            auto chunk = [&](std::size_t c) {
+                std::size_t first = c * chunk_rows;
+                f(first, (std::min)(rows, first + chunk_rows));
+            };
+
+            if (chunks > 1 &&
+                rows * columns >= crossentropy_min_parallel_elements)
+            {
+                hpx::for_loop(
+                    hpx::execution::par, std::size_t(0), chunks, chunk);
+            }
+            else
+            {
+                for (std::size_t c = 0; c != chunks; ++c)
+                {
+                    chunk(c);
+                }
+            }
+        }
+
+        inline primitive_argument_type crossentropy_result(
+            ir::node_data<double>&& loss, ir::node_data<double>&& grad)
+        {
+            primitive_arguments_type result;
+            result.reserve(2);
+            result.emplace_back(std::move(loss));
+            result.emplace_back(std::move(grad));
+            return primitive_argument_type{ir::range{std::move(result)}};
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type fused_crossentropy_operation::softmax_cross_entropy(
+        arg_type&& target, arg_type&& logits) const
+    {
+        std::size_t ndim = logits.num_dimensions();
+        std::size_t rows = detail::crossentropy_rows(logits);
+        std::size_t columns = detail::crossentropy_columns(logits);
+
+        // the loss has the shape of the logits without its last axis
+        auto dims = logits.dimensions();
+        if (ndim != 0)
+        {
+            dims[ndim - 1] = 0;
+        }
+        arg_type loss(dims);
+
+        // the gradient is computed in place if we own the logits
+        bool const logits_is_ref = logits.is_ref();
+        arg_type grad =
+            logits_is_ref ? arg_type(logits.dimensions()) : std::move(logits);
+        arg_type& x = logits_is_ref ? logits : grad;
+
+        detail::crossentropy_for_each_chunk(rows, columns,
+            [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t r = first; r != last; ++r)
+                {
+                    double const* t = detail::crossentropy_row(target, r);
+                    double const* xr = detail::crossentropy_row(x, r);
+                    double* g = detail::crossentropy_row(grad, r);
+
+                    // first pass: maximum, sum(target), and target.logits
+                    double max_x = -std::numeric_limits<double>::infinity();
+                    double sum_t = 0.0;
+                    double dot_tx = 0.0;
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        max_x = (std::max)(max_x, xr[j]);
+                        sum_t += t[j];
+                        dot_tx += t[j] * xr[j];
+                    }
+
+                    // second pass: shifted exponentials, may overwrite logits
+                    double sum_exp = 0.0;
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        double e = std::exp(xr[j] - max_x);
+                        g[j] = e;
+                        sum_exp += e;
+                    }
+
+                    // third pass: gradient, the row is still in cache
+                    double scale = sum_t / sum_exp;
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        g[j] = g[j] * scale - t[j];
+                    }
+
+                    detail::crossentropy_loss(loss, r) =
+                        sum_t * (max_x + std::log(sum_exp)) - dot_tx;
+                }
+            });
+
+        return detail::crossentropy_result(std::move(loss), std::move(grad));
+    }
+
+    primitive_argument_type fused_crossentropy_operation::sigmoid_cross_entropy(
+        arg_type&& target, arg_type&& logits) const
+    {
+        std::size_t rows = detail::crossentropy_rows(logits);
+        std::size_t columns = detail::crossentropy_columns(logits);
+
+        arg_type loss(logits.dimensions());
+
+        // the gradient is computed in place if we own the logits
+        bool const logits_is_ref = logits.is_ref();
+        arg_type grad =
+            logits_is_ref ? arg_type(logits.dimensions()) : std::move(logits);
+        arg_type& x = logits_is_ref ? logits : grad;
+
+        detail::crossentropy_for_each_chunk(rows, columns,
+            [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t r = first; r != last; ++r)
+                {
+                    double const* t = detail::crossentropy_row(target, r);
+                    double const* xr = detail::crossentropy_row(x, r);
+                    double* g = detail::crossentropy_row(grad, r);
+                    double* l = detail::crossentropy_row(loss, r);
+
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        // max(x, 0) - x * t + log(1 + exp(-|x|))
+                        double xj = xr[j];
+                        double e = std::exp(-std::abs(xj));
+                        l[j] = (std::max)(xj, 0.0) - xj * t[j] + std::log1p(e);
+
+                        // sigmoid(x) - t, reusing exp(-|x|)
+                        double sig = xj >= 0 ? 1.0 / (1.0 + e) : e / (1.0 + e);
+                        g[j] = sig - t[j];
+                    }
+                }
+            });
+
+        return detail::crossentropy_result(std::move(loss), std::move(grad));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> fused_crossentropy_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args,
+        eval_context ctx) const
+    {
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_crossentropy_operation::eval",
+                util::generate_error_message(
+                    "the fused_crossentropy_operation primitive requires "
+                    "exactly two operands",
+                    name_, codename_));
+        }
+
+        for (auto const& i : operands)
+        {
+            if (!valid(i))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "fused_crossentropy_operation::eval",
+                    util::generate_error_message(
+                        "the fused_crossentropy_operation primitive requires "
+                        "that the arguments given by the operands array are "
+                        "valid",
+                        name_, codename_));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping([this_ = std::move(this_)](
+                                      primitive_arguments_type&& args)
+                                      -> primitive_argument_type {
+                arg_type target = extract_numeric_value(
+                    std::move(args[0]), this_->name_, this_->codename_);
+                arg_type logits = extract_numeric_value(
+                    std::move(args[1]), this_->name_, this_->codename_);
+
+                if (target.dimensions() != logits.dimensions())
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "fused_crossentropy_operation::eval",
+                        util::generate_error_message(
+                            "the target and the logits must have the same "
+                            "shape",
+                            this_->name_, this_->codename_));
+                }
+
+                if (logits.num_dimensions() > 3)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "fused_crossentropy_operation::eval",
+                        util::generate_error_message(
+                            "operand logits has an invalid number of "
+                            "dimensions",
+                            this_->name_, this_->codename_));
+                }
+
+                if (this_->mode_ == crossentropy_mode_sigmoid)
+                {
+                    return this_->sigmoid_cross_entropy(
+                        std::move(target), std::move(logits));
+                }
+                return this_->softmax_cross_entropy(
+                    std::move(target), std::move(logits));
+            }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
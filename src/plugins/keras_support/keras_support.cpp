@@ -36,6 +36,12 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(ctc_decode_operation_plugin,
 
 PHYLANX_REGISTER_PLUGIN_FACTORY(elu_operation_plugin,
     phylanx::execution_tree::primitives::elu_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(softmax_cross_entropy_with_logits_plugin,
+    phylanx::execution_tree::primitives::fused_crossentropy_operation::
+        match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(sigmoid_cross_entropy_with_logits_plugin,
+    phylanx::execution_tree::primitives::fused_crossentropy_operation::
+        match_data[1]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(hard_sigmoid_operation_plugin,
     phylanx::execution_tree::primitives::hard_sigmoid_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(l2_normalize_operation_plugin,
@@ -0,0 +1,548 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/pool_indices_helper.hpp>
+#include <phylanx/plugins/keras_support/pool_kernels.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace pool_kernels
+{
+    ///////////////////////////////////////////////////////////////////////////
+    pool_axis::pool_axis(std::size_t image_size, std::size_t filter_size,
+            std::size_t stride, bool same_padding)
+      : image_size_(image_size)
+      , filter_size_(filter_size)
+      , stride_(stride)
+      , pad_begin_(0)
+      , result_size_(0)
+    {
+        std::size_t pad = 0;
+        if (same_padding)
+        {
+            std::size_t rem = image_size % stride;
+            if (rem == 0)
+            {
+                pad = filter_size > stride ? filter_size - stride : 0;
+            }
+            else
+            {
+                pad = filter_size > rem ? filter_size - rem : 0;
+            }
+            pad_begin_ = static_cast<std::int64_t>(pad / 2);
+        }
+
+        result_size_ = static_cast<std::size_t>(std::ceil(
+            static_cast<double>(image_size + pad - filter_size + 1) / stride));
+    }
+
+    namespace detail
+    {
+        // Arrays smaller than this are not worth spawning HPX tasks for.
+        constexpr std::size_t pool_min_parallel_elements = 16384;
+
+        template <typename F>
+        void pool_for_loop(std::size_t count, std::size_t work, F&& f)
+        {
+            if (count > 1 && work >= pool_min_parallel_elements)
+            {
+                hpx::for_loop(hpx::execution::par, std::size_t(0), count, f);
+            }
+            else
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    f(i);
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct pool_scratch
+        {
+            std::vector<double> prefix_;
+            std::vector<double> suffix_;
+            std::vector<std::int64_t> prefix_idx_;
+            std::vector<std::int64_t> suffix_idx_;
+        };
+
+        // Reduce the windows along the rows of a block of 'count' adjacent
+        // lanes. Row k of the input starts at in + k * in_stride, row j of
+        // the output at out + j * out_stride. The index arrays are optional
+        // and share the strides of their data.
+        void pool_block(double const* in, std::int64_t const* in_idx,
+            std::size_t in_stride, double* out, std::int64_t* out_idx,
+            std::size_t out_stride, std::size_t count, pool_axis const& axis,
+            pool_mode mode, pool_scratch& scratch)
+        {
+            std::size_t n = axis.image_size_;
+            std::size_t f = axis.filter_size_;
+
+            if (!axis.overlapping())
+            {
+                // every element is visited at most once, reduce directly
+                for (std::size_t j = 0; j != axis.result_size_; ++j)
+                {
+                    auto w = axis.window(j);
+                    double* o = out + j * out_stride;
+                    std::int64_t* oi = out_idx ? out_idx + j * out_stride : nullptr;
+
+                    double const* src = in + w.image_beg_ * in_stride;
+                    std::copy(src, src + count, o);
+                    if (oi)
+                    {
+                        std::int64_t const* src_idx =
+                            in_idx + w.image_beg_ * in_stride;
+                        std::copy(src_idx, src_idx + count, oi);
+                    }
+
+                    for (std::int64_t k = 1; k < w.size_; ++k)
+                    {
+                        std::size_t row = (w.image_beg_ + k) * in_stride;
+                        src = in + row;
+                        if (mode == pool_avg)
+                        {
+                            for (std::size_t i = 0; i != count; ++i)
+                            {
+                                o[i] += src[i];
+                            }
+                        }
+                        else
+                        {
+                            for (std::size_t i = 0; i != count; ++i)
+                            {
+                                if (src[i] > o[i])
+                                {
+                                    o[i] = src[i];
+                                    if (oi)
+                                    {
+                                        oi[i] = in_idx[row + i];
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    if (mode == pool_avg && w.size_ != 1)
+                    {
+                        double size = static_cast<double>(w.size_);
+                        for (std::size_t i = 0; i != count; ++i)
+                        {
+                            o[i] /= size;
+                        }
+                    }
+                }
+                return;
+            }
+
+            if (mode == pool_avg)
+            {
+                // prefix sums, the sum over a window is a single difference
+                auto& sums = scratch.prefix_;
+                sums.assign((n + 1) * count, 0.0);
+                for (std::size_t k = 0; k != n; ++k)
+                {
+                    double const* src = in + k * in_stride;
+                    double const* prev = sums.data() + k * count;
+                    double* curr = sums.data() + (k + 1) * count;
+                    for (std::size_t i = 0; i != count; ++i)
+                    {
+                        curr[i] = prev[i] + src[i];
+                    }
+                }
+
+                for (std::size_t j = 0; j != axis.result_size_; ++j)
+                {
+                    auto w = axis.window(j);
+                    double const* first = sums.data() + w.image_beg_ * count;
+                    double const* last =
+                        sums.data() + (w.image_beg_ + w.size_) * count;
+                    double size = static_cast<double>(w.size_);
+                    double* o = out + j * out_stride;
+                    for (std::size_t i = 0; i != count; ++i)
+                    {
+                        o[i] = (last[i] - first[i]) / size;
+                    }
+                }
+                return;
+            }
+
+            // van Herk/Gil-Werman: maxima of the prefixes and suffixes of
+            // blocks of size f, any window of size <= f spans at most two
+            // blocks
+            auto& prefix = scratch.prefix_;
+            auto& suffix = scratch.suffix_;
+            prefix.resize(n * count);
+            suffix.resize(n * count);
+
+            bool with_indices = out_idx != nullptr;
+            auto& prefix_idx = scratch.prefix_idx_;
+            auto& suffix_idx = scratch.suffix_idx_;
+            if (with_indices)
+            {
+                prefix_idx.resize(n * count);
+                suffix_idx.resize(n * count);
+            }
+
+            for (std::size_t k = 0; k != n; ++k)
+            {
+                double const* src = in + k * in_stride;
+                double* p = prefix.data() + k * count;
+                std::int64_t* pi =
+                    with_indices ? prefix_idx.data() + k * count : nullptr;
+
+                if (k % f == 0)
+                {
+                    std::copy(src, src + count, p);
+                    if (with_indices)
+                    {
+                        std::copy(in_idx + k * in_stride,
+                            in_idx + k * in_stride + count, pi);
+                    }
+                    continue;
+                }
+
+                double const* prev = p - count;
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    // prefer the earlier element on ties
+                    if (src[i] > prev[i])
+                    {
+                        p[i] = src[i];
+                        if (with_indices)
+                            pi[i] = in_idx[k * in_stride + i];
+                    }
+                    else
+                    {
+                        p[i] = prev[i];
+                        if (with_indices)
+                            pi[i] = (pi - count)[i];
+                    }
+                }
+            }
+
+            for (std::size_t k = n; k-- != 0; /**/)
+            {
+                double const* src = in + k * in_stride;
+                double* s = suffix.data() + k * count;
+                std::int64_t* si =
+                    with_indices ? suffix_idx.data() + k * count : nullptr;
+
+                if (k == n - 1 || (k + 1) % f == 0)
+                {
+                    std::copy(src, src + count, s);
+                    if (with_indices)
+                    {
+                        std::copy(in_idx + k * in_stride,
+                            in_idx + k * in_stride + count, si);
+                    }
+                    continue;
+                }
+
+                double const* next = s + count;
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    // prefer the earlier element on ties
+                    if (src[i] >= next[i])
+                    {
+                        s[i] = src[i];
+                        if (with_indices)
+                            si[i] = in_idx[k * in_stride + i];
+                    }
+                    else
+                    {
+                        s[i] = next[i];
+                        if (with_indices)
+                            si[i] = (si + count)[i];
+                    }
+                }
+            }
+
+            for (std::size_t j = 0; j != axis.result_size_; ++j)
+            {
+                auto w = axis.window(j);
+                std::size_t first = w.image_beg_;
+                std::size_t last = w.image_beg_ + w.size_ - 1;
+
+                // clipped windows touch the image boundary, thus they either
+                // start a block or end one
+                double const* s = suffix.data() + first * count;
+                double const* p = prefix.data() + last * count;
+                double* o = out + j * out_stride;
+                std::int64_t* oi = with_indices ? out_idx + j * out_stride : nullptr;
+
+                if (first / f == last / f)
+                {
+                    if (first % f == 0)
+                    {
+                        std::copy(p, p + count, o);
+                        if (with_indices)
+                        {
+                            std::copy(prefix_idx.data() + last * count,
+                                prefix_idx.data() + (last + 1) * count, oi);
+                        }
+                    }
+                    else
+                    {
+                        std::copy(s, s + count, o);
+                        if (with_indices)
+                        {
+                            std::copy(suffix_idx.data() + first * count,
+                                suffix_idx.data() + (first + 1) * count, oi);
+                        }
+                    }
+                    continue;
+                }
+
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    if (s[i] >= p[i])
+                    {
+                        o[i] = s[i];
+                        if (with_indices)
+                            oi[i] = suffix_idx[first * count + i];
+                    }
+                    else
+                    {
+                        o[i] = p[i];
+                        if (with_indices)
+                            oi[i] = prefix_idx[last * count + i];
+                    }
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Pool a contiguous (rows x columns) plane, first along the columns,
+        // then along the rows (vectorized over all pooled columns).
+        void pool_plane(std::vector<double> const& in,
+            std::vector<std::int64_t> const& in_idx, pool_axis const& rows,
+            pool_axis const& columns, pool_mode mode, std::vector<double>& out,
+            std::vector<std::int64_t>& out_idx, pool_scratch& scratch)
+        {
+            bool with_indices = !in_idx.empty();
+
+            std::size_t ncolumns = columns.image_size_;
+            std::size_t result_columns = columns.result_size_;
+
+            std::vector<double> tmp(rows.image_size_ * result_columns);
+            std::vector<std::int64_t> tmp_idx(with_indices ? tmp.size() : 0);
+
+            for (std::size_t r = 0; r != rows.image_size_; ++r)
+            {
+                pool_block(in.data() + r * ncolumns,
+                    with_indices ? in_idx.data() + r * ncolumns : nullptr, 1,
+                    tmp.data() + r * result_columns,
+                    with_indices ? tmp_idx.data() + r * result_columns : nullptr,
+                    1, 1, columns, mode, scratch);
+            }
+
+            out.resize(rows.result_size_ * result_columns);
+            out_idx.resize(with_indices ? out.size() : 0);
+
+            pool_block(tmp.data(), with_indices ? tmp_idx.data() : nullptr,
+                result_columns, out.data(),
+                with_indices ? out_idx.data() : nullptr, result_columns,
+                result_columns, rows, mode, scratch);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    blaze::DynamicArray<4UL, double> pool2d(ir::node_data<double>&& arg,
+        pool_axis const& rows, pool_axis const& columns, pool_mode mode,
+        blaze::DynamicArray<4UL, std::int64_t>* indices)
+    {
+        auto q = arg.quatern();
+
+        std::size_t batch = q.quats();
+        std::size_t channels = q.columns();
+        std::size_t nrows = rows.image_size_;
+        std::size_t ncolumns = columns.image_size_;
+        std::size_t result_height = rows.result_size_;
+        std::size_t result_width = columns.result_size_;
+
+        blaze::DynamicArray<4UL, double> result(
+            batch, result_height, result_width, channels);
+        if (indices != nullptr)
+        {
+            *indices = blaze::DynamicArray<4UL, std::int64_t>(
+                batch, result_height, result_width, channels);
+        }
+
+        // every (batch, channel) plane is pooled independently
+        detail::pool_for_loop(batch * channels, q.quats() * q.pages() *
+                q.rows() * q.columns(),
+            [&](std::size_t task)
+            {
+                std::size_t l = task / channels;
+                std::size_t c = task % channels;
+
+                auto t = blaze::quatslice(q, l);
+
+                std::vector<double> plane(nrows * ncolumns);
+                std::vector<std::int64_t> plane_idx;
+                for (std::size_t r = 0; r != nrows; ++r)
+                {
+                    for (std::size_t k = 0; k != ncolumns; ++k)
+                    {
+                        plane[r * ncolumns + k] = t(r, k, c);
+                    }
+                }
+                if (indices != nullptr)
+                {
+                    plane_idx.resize(plane.size());
+                    for (std::size_t i = 0; i != plane_idx.size(); ++i)
+                    {
+                        plane_idx[i] = static_cast<std::int64_t>(i);
+                    }
+                }
+
+                detail::pool_scratch scratch;
+                std::vector<double> pooled;
+                std::vector<std::int64_t> pooled_idx;
+                detail::pool_plane(plane, plane_idx, rows, columns, mode,
+                    pooled, pooled_idx, scratch);
+
+                auto res_tensor = blaze::quatslice(result, l);
+                for (std::size_t r = 0; r != result_height; ++r)
+                {
+                    for (std::size_t k = 0; k != result_width; ++k)
+                    {
+                        res_tensor(r, k, c) = pooled[r * result_width + k];
+                    }
+                }
+                if (indices != nullptr)
+                {
+                    auto idx_tensor = blaze::quatslice(*indices, l);
+                    for (std::size_t r = 0; r != result_height; ++r)
+                    {
+                        for (std::size_t k = 0; k != result_width; ++k)
+                        {
+                            idx_tensor(r, k, c) =
+                                pooled_idx[r * result_width + k];
+                        }
+                    }
+                }
+            });
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    blaze::DynamicTensor<double> pool3d(ir::node_data<double>&& arg,
+        pool_axis const& pages, pool_axis const& rows,
+        pool_axis const& columns, pool_mode mode,
+        blaze::DynamicTensor<std::int64_t>* indices)
+    {
+        auto t = arg.tensor();
+
+        std::size_t npages = pages.image_size_;
+        std::size_t nrows = rows.image_size_;
+        std::size_t ncolumns = columns.image_size_;
+        std::size_t result_depth = pages.result_size_;
+        std::size_t result_height = rows.result_size_;
+        std::size_t result_width = columns.result_size_;
+        std::size_t plane_size = nrows * ncolumns;
+        std::size_t result_plane_size = result_height * result_width;
+
+        bool with_indices = indices != nullptr;
+
+        // pool every page over its rows and columns
+        std::vector<double> planes(npages * result_plane_size);
+        std::vector<std::int64_t> planes_idx(
+            with_indices ? planes.size() : 0);
+
+        detail::pool_for_loop(npages, npages * plane_size,
+            [&](std::size_t p)
+            {
+                std::vector<double> plane(plane_size);
+                std::vector<std::int64_t> plane_idx(
+                    with_indices ? plane_size : 0);
+                for (std::size_t r = 0; r != nrows; ++r)
+                {
+                    for (std::size_t c = 0; c != ncolumns; ++c)
+                    {
+                        plane[r * ncolumns + c] = t(p, r, c);
+                    }
+                }
+                for (std::size_t i = 0; i != plane_idx.size(); ++i)
+                {
+                    plane_idx[i] = static_cast<std::int64_t>(p * plane_size + i);
+                }
+
+                detail::pool_scratch scratch;
+                std::vector<double> pooled;
+                std::vector<std::int64_t> pooled_idx;
+                detail::pool_plane(plane, plane_idx, rows, columns, mode,
+                    pooled, pooled_idx, scratch);
+
+                std::copy(pooled.begin(), pooled.end(),
+                    planes.begin() + p * result_plane_size);
+                std::copy(pooled_idx.begin(), pooled_idx.end(),
+                    planes_idx.begin() + p * result_plane_size);
+            });
+
+        // pool along the pages, chunks of adjacent lanes are independent
+        std::vector<double> pooled(result_depth * result_plane_size);
+        std::vector<std::int64_t> pooled_idx(with_indices ? pooled.size() : 0);
+
+        std::size_t const chunk_size = 256;
+        std::size_t chunks = (result_plane_size + chunk_size - 1) / chunk_size;
+
+        detail::pool_for_loop(chunks, planes.size(),
+            [&](std::size_t chunk)
+            {
+                std::size_t first = chunk * chunk_size;
+                std::size_t count =
+                    (std::min)(chunk_size, result_plane_size - first);
+
+                detail::pool_scratch scratch;
+                detail::pool_block(planes.data() + first,
+                    with_indices ? planes_idx.data() + first : nullptr,
+                    result_plane_size, pooled.data() + first,
+                    with_indices ? pooled_idx.data() + first : nullptr,
+                    result_plane_size, count, pages, mode, scratch);
+            });
+
+        blaze::DynamicTensor<double> result(
+            result_depth, result_height, result_width);
+        if (with_indices)
+        {
+            *indices = blaze::DynamicTensor<std::int64_t>(
+                result_depth, result_height, result_width);
+        }
+
+        for (std::size_t p = 0; p != result_depth; ++p)
+        {
+            for (std::size_t r = 0; r != result_height; ++r)
+            {
+                for (std::size_t c = 0; c != result_width; ++c)
+                {
+                    std::size_t i =
+                        p * result_plane_size + r * result_width + c;
+                    result(p, r, c) = pooled[i];
+                    if (with_indices)
+                    {
+                        (*indices)(p, r, c) = pooled_idx[i];
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+}
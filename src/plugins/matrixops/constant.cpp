@@ -53,7 +53,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             An array of size 'shape' with each element equal to 'value'. If
-            'value' is equal to None, the array elements are uninitialized.)"
+            'value' is equal to None, the array elements are uninitialized.)",
+            false,    // supports dtype
+            true      // pure
         },
         match_pattern_type{"full",
             std::vector<std::string>{R"(
@@ -76,7 +78,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             An array of size 'shape' with each element equal to 'value'. If
-            'value' is equal to None, the array elements are uninitialized.)"
+            'value' is equal to None, the array elements are uninitialized.)",
+            false,    // supports dtype
+            true      // pure
         },
         match_pattern_type{"constant_like",
             std::vector<std::string>{R"(
@@ -101,7 +105,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             An array of the same size as 'a' with each element equal to
             'value'. If 'value' is equal to None, the array elements are
-            uninitialized.)"
+            uninitialized.)",
+            false,    // supports dtype
+            true      // pure
         },
         match_pattern_type{"full_like",
             std::vector<std::string>{R"(
@@ -127,7 +133,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             An array of the same size as 'a' with each element equal to
             'value'. If 'value' is equal to None, the array elements are
-            uninitialized.)"
+            uninitialized.)",
+            false,    // supports dtype
+            true      // pure
         }
     };
 
@@ -42,7 +42,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             Returns:
 
-            Computes the outer product of two arrays. Always returns a matrix)"},
+            Computes the outer product of two arrays. Always returns a matrix)",
+            false,    // supports dtype
+            true      // pure
+        },
 
         match_pattern_type{"dot", std::vector<std::string>{"dot(_1, _2)"},
             &create_dot_operation, &create_primitive<dot_operation>, R"(
@@ -55,7 +58,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The dot product of two arrays: `a` and `b`. The dot product of an
-            N-D array and an M-D array is of dimension N+M-2)"},
+            N-D array and an M-D array is of dimension N+M-2)",
+            false,    // supports dtype
+            true      // pure
+        },
 
         match_pattern_type{"tensordot",
             std::vector<std::string>{
@@ -76,7 +82,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             Returns:
 
-            The tensor dot product along specified axes for arrays>=1-D.)"}};
+            The tensor dot product along specified axes for arrays>=1-D.)",
+            false,    // supports dtype
+            true      // pure
+        }};
 
     ///////////////////////////////////////////////////////////////////////////
     dot_operation::dot_mode extract_dot_mode(std::string const& name)
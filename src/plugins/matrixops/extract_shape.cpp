@@ -39,7 +39,10 @@ namespace phylanx { namespace execution_tree { namespace primitives {
             corresponding to the size of each dimension of the array `a`. If the
             optional `dim` argument is supplied, then the size for that
             dimension is returned as an integer. If the supplied array is
-            distributed, the shape is calculated on the current locality.)"},
+            distributed, the shape is calculated on the current locality.)",
+            false,    // supports dtype
+            true      // pure
+        },
 
         match_pattern_type{"shape_d",
             std::vector<std::string>{"shape_d(_1, _2)", "shape_d(_1)"},
@@ -54,7 +54,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             Return an N x M matrix with ones on the k-th diagonal and zeros
-            elsewhere.)"
+            elsewhere.)",
+            false,    // supports dtype
+            true      // pure
         }
     };
 
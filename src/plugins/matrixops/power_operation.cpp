@@ -39,7 +39,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The value `base`**`pow`.)",
-            true
+            true,    // supports dtype
+            true     // pure
         }
     };
 
@@ -29,7 +29,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     match_pattern_type const transpose_operation::match_data =
     {
-        hpx::make_tuple("transpose",
+        match_pattern_type{"transpose",
             std::vector<std::string>{"transpose(_1)", "transpose(_1,_2)"},
             &create_transpose_operation,
             &create_primitive<transpose_operation>, R"(
@@ -44,7 +44,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
             Returns:
 
             The transpose of `arg`. If axes are provided, it returns `arg` with
-            its axes permuted.)")
+            its axes permuted.)",
+            false,    // supports dtype
+            true      // pure
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
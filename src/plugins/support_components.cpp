@@ -4,6 +4,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/collectives.hpp>
 #include <phylanx/util/distributed_vector.hpp>
 #include <phylanx/util/distributed_tensor.hpp>
 #include <phylanx/util/distributed_matrix.hpp>
@@ -31,3 +32,16 @@ REGISTER_DISTRIBUTED_TENSOR(double);
 REGISTER_DISTRIBUTED_TENSOR(std_int64_t);
 REGISTER_DISTRIBUTED_TENSOR(std_uint8_t);
 
+HPX_REGISTER_CHANNEL(phylanx::util::detail::collective_vector_double,
+    phylanx_collective_vector_double);
+HPX_REGISTER_CHANNEL(phylanx::util::detail::collective_vector_int64,
+    phylanx_collective_vector_int64);
+HPX_REGISTER_CHANNEL(phylanx::util::detail::collective_vector_uint8,
+    phylanx_collective_vector_uint8);
+
+HPX_REGISTER_CHANNEL(phylanx::util::detail::collective_matrix_double,
+    phylanx_collective_matrix_double);
+HPX_REGISTER_CHANNEL(phylanx::util::detail::collective_matrix_int64,
+    phylanx_collective_matrix_int64);
+HPX_REGISTER_CHANNEL(phylanx::util::detail::collective_matrix_uint8,
+    phylanx_collective_matrix_uint8);
@@ -0,0 +1,119 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/collectives.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        collective_algorithm get_configured_algorithm()
+        {
+            std::string const algorithm =
+                hpx::get_config_entry("phylanx.collectives.algorithm", "auto");
+
+            if (algorithm == "direct")
+            {
+                return collective_algorithm::direct;
+            }
+            if (algorithm == "ring")
+            {
+                return collective_algorithm::ring;
+            }
+            if (algorithm == "tree")
+            {
+                return collective_algorithm::tree;
+            }
+            if (algorithm != "auto")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::util::select_collective_algorithm",
+                    "unknown collective algorithm requested in "
+                    "phylanx.collectives.algorithm: " + algorithm +
+                    " (should be 'auto', 'direct', 'ring', or 'tree')");
+            }
+            return collective_algorithm::direct;
+        }
+    }
+
+    collective_algorithm select_collective_algorithm(
+        std::size_t payload, std::size_t num_sites)
+    {
+        static bool const automatic = hpx::get_config_entry(
+            "phylanx.collectives.algorithm", "auto") == "auto";
+        static collective_algorithm const algorithm =
+            detail::get_configured_algorithm();
+
+        static std::size_t const ring_threshold = std::stoul(
+            hpx::get_config_entry(
+                "phylanx.collectives.ring_threshold", "1048576"));
+        static std::size_t const tree_threshold = std::stoul(
+            hpx::get_config_entry("phylanx.collectives.tree_threshold", "8"));
+
+        if (num_sites < 2)
+        {
+            return collective_algorithm::direct;
+        }
+
+        if (!automatic)
+        {
+            return algorithm;
+        }
+
+        // the ring sends 2 * (num_sites - 1) messages per site, each of them
+        // carrying 1 / num_sites of the payload, this pays off only for
+        // large payloads
+        if (payload >= ring_threshold && num_sites > 2)
+        {
+            return collective_algorithm::ring;
+        }
+
+        // the tree needs log2(num_sites) rounds, the direct algorithm
+        // funnels all messages through a single site
+        if (num_sites > tree_threshold)
+        {
+            return collective_algorithm::tree;
+        }
+
+        return collective_algorithm::direct;
+    }
+
+    std::size_t collective_segment_size()
+    {
+        static std::size_t const segment_size = std::stoul(
+            hpx::get_config_entry(
+                "phylanx.collectives.segment_size", "262144"));
+        return segment_size;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string generate_collective_name(std::string const& basename)
+    {
+        // all sites invoke the collective operations on a given base name in
+        // the same order, thus they generate the same sequence of names
+        static hpx::lcos::local::spinlock mtx;
+        static std::map<std::string, std::size_t> generations;
+
+        std::size_t generation = 0;
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+            generation = ++generations[basename];
+        }
+        return "/phylanx/collectives/" + basename + "/" +
+            std::to_string(generation);
+    }
+}}
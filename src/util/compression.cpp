@@ -0,0 +1,263 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/compression.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::atomic<std::int64_t> bytes_uncompressed(0);
+        static std::atomic<std::int64_t> bytes_compressed(0);
+
+        void count_compressed_bytes(
+            std::size_t uncompressed, std::size_t compressed)
+        {
+            bytes_uncompressed += static_cast<std::int64_t>(uncompressed);
+            bytes_compressed += static_cast<std::int64_t>(compressed);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // matches are at least min_match bytes long and are searched for in
+        // a window of max_offset bytes
+        constexpr std::size_t min_match = 4;
+        constexpr std::size_t max_offset = 65536;
+        constexpr std::size_t hash_bits = 14;
+
+        inline std::uint32_t hash(unsigned char const* p)
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return (v * 2654435761u) >> (32 - hash_bits);
+        }
+
+        inline void write_varint(std::vector<char>& out, std::size_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        inline std::size_t read_varint(
+            unsigned char const*& p, unsigned char const* end)
+        {
+            std::size_t value = 0;
+            for (int shift = 0; p != end; shift += 7)
+            {
+                unsigned char const c = *p++;
+                value |= static_cast<std::size_t>(c & 0x7f) << shift;
+                if (!(c & 0x80))
+                {
+                    return value;
+                }
+            }
+
+            HPX_THROW_EXCEPTION(hpx::invalid_data,
+                "phylanx::util::decompress",
+                "unexpected end of compressed data");
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // The compressed stream is a sequence of literal runs, each followed
+        // by an (optional) back-reference:
+        //
+        //      varint(literals), literal bytes,
+        //      varint(match length - min_match + 1), varint(offset)
+        //
+        // A match length of zero marks the end of the stream.
+        std::vector<char> lz_compress(
+            unsigned char const* data, std::size_t size)
+        {
+            std::vector<char> out;
+            out.reserve(size / 2);
+
+            std::vector<std::size_t> table(std::size_t(1) << hash_bits, 0);
+
+            std::size_t literal_start = 0;
+            std::size_t i = 0;
+            while (i + min_match <= size)
+            {
+                std::uint32_t const h = hash(data + i);
+                std::size_t const candidate = table[h];
+                table[h] = i + 1;     // zero marks an empty slot
+
+                if (candidate == 0 || i - (candidate - 1) > max_offset ||
+                    std::memcmp(data + candidate - 1, data + i, min_match) != 0)
+                {
+                    ++i;
+                    continue;
+                }
+
+                std::size_t const match = candidate - 1;
+                std::size_t length = min_match;
+                while (i + length != size && data[match + length] == data[i + length])
+                {
+                    ++length;
+                }
+
+                write_varint(out, i - literal_start);
+                out.insert(out.end(), data + literal_start, data + i);
+                write_varint(out, length - min_match + 1);
+                write_varint(out, i - match);
+
+                // give up as soon as the output grows too large
+                if (out.size() >= size)
+                {
+                    return std::vector<char>();
+                }
+
+                i += length;
+                literal_start = i;
+            }
+
+            write_varint(out, size - literal_start);
+            out.insert(out.end(), data + literal_start, data + size);
+            write_varint(out, 0);
+
+            if (out.size() >= size)
+            {
+                return std::vector<char>();
+            }
+            return out;
+        }
+
+        void lz_decompress(unsigned char const* p, std::size_t size,
+            unsigned char* target, std::size_t target_size)
+        {
+            unsigned char const* end = p + size;
+            std::size_t pos = 0;
+
+            while (true)
+            {
+                std::size_t const literals = read_varint(p, end);
+                if (literals > std::size_t(end - p) ||
+                    literals > target_size - pos)
+                {
+                    HPX_THROW_EXCEPTION(hpx::invalid_data,
+                        "phylanx::util::decompress",
+                        "corrupted compressed data (literals)");
+                }
+                std::memcpy(target + pos, p, literals);
+                p += literals;
+                pos += literals;
+
+                std::size_t length = read_varint(p, end);
+                if (length == 0)
+                {
+                    break;
+                }
+                length += min_match - 1;
+
+                std::size_t const offset = read_varint(p, end);
+                if (offset == 0 || offset > pos || length > target_size - pos)
+                {
+                    HPX_THROW_EXCEPTION(hpx::invalid_data,
+                        "phylanx::util::decompress",
+                        "corrupted compressed data (match)");
+                }
+
+                // the source and target ranges may overlap
+                unsigned char* dest = target + pos;
+                unsigned char const* src = dest - offset;
+                for (std::size_t j = 0; j != length; ++j)
+                {
+                    dest[j] = src[j];
+                }
+                pos += length;
+            }
+
+            if (pos != target_size)
+            {
+                HPX_THROW_EXCEPTION(hpx::invalid_data,
+                    "phylanx::util::decompress",
+                    "compressed data does not match the expected size");
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool use_compression(std::size_t bytes)
+    {
+        static bool const enabled =
+            hpx::get_config_entry("phylanx.compression", "0") == "1";
+        static std::size_t const threshold = std::stoul(
+            hpx::get_config_entry("phylanx.compression.threshold", "65536"));
+
+        return enabled && bytes >= threshold;
+    }
+
+    std::vector<char> compress(
+        char const* data, std::size_t size, std::size_t element_size)
+    {
+        // group the n-th bytes of all elements
+        std::size_t const count = size / element_size;
+        std::vector<unsigned char> shuffled(size);
+        unsigned char const* src = reinterpret_cast<unsigned char const*>(data);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            for (std::size_t b = 0; b != element_size; ++b)
+            {
+                shuffled[b * count + i] = src[i * element_size + b];
+            }
+        }
+
+        // trailing bytes not forming a full element are left in place
+        std::size_t const shuffled_size = count * element_size;
+        std::memcpy(shuffled.data() + shuffled_size, src + shuffled_size,
+            size - shuffled_size);
+
+        return detail::lz_compress(shuffled.data(), size);
+    }
+
+    void decompress(char const* data, std::size_t size, char* target,
+        std::size_t target_size, std::size_t element_size)
+    {
+        std::vector<unsigned char> shuffled(target_size);
+        detail::lz_decompress(reinterpret_cast<unsigned char const*>(data),
+            size, shuffled.data(), target_size);
+
+        std::size_t const count = target_size / element_size;
+        unsigned char* dest = reinterpret_cast<unsigned char*>(target);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            for (std::size_t b = 0; b != element_size; ++b)
+            {
+                dest[i * element_size + b] = shuffled[b * count + i];
+            }
+        }
+
+        std::size_t const shuffled_size = count * element_size;
+        std::memcpy(dest + shuffled_size, shuffled.data() + shuffled_size,
+            target_size - shuffled_size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t compression_bytes_uncompressed(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::bytes_uncompressed, reset);
+    }
+
+    std::int64_t compression_bytes_compressed(bool reset)
+    {
+        return hpx::util::get_and_reset_value(detail::bytes_compressed, reset);
+    }
+}}
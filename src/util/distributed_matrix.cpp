@@ -0,0 +1,91 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static std::atomic<std::int64_t> prefetch_hits(0);
+        static std::atomic<std::int64_t> prefetch_misses(0);
+
+        void count_prefetch_cache_access(bool hit)
+        {
+            if (hit)
+            {
+                ++prefetch_hits;
+            }
+            else
+            {
+                ++prefetch_misses;
+            }
+        }
+
+        std::size_t prefetch_cache_capacity()
+        {
+            static std::size_t const capacity = std::stoul(
+                hpx::get_config_entry(
+                    "phylanx.distributed_matrix.prefetch_cache_size", "16"));
+            return capacity;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static hpx::lcos::local::spinlock fetch_targets_mtx;
+        static std::uint64_t next_fetch_target = 0;
+        static std::unordered_map<std::uint64_t, std::shared_ptr<void>>
+            fetch_targets;
+
+        std::uint64_t register_fetch_target(std::shared_ptr<void> target)
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(fetch_targets_mtx);
+            std::uint64_t const handle = ++next_fetch_target;
+            fetch_targets.emplace(handle, std::move(target));
+            return handle;
+        }
+
+        std::shared_ptr<void> find_fetch_target(std::uint64_t handle)
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(fetch_targets_mtx);
+            auto it = fetch_targets.find(handle);
+            if (it == fetch_targets.end())
+            {
+                return nullptr;
+            }
+            return it->second;
+        }
+
+        void unregister_fetch_target(std::uint64_t handle)
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(fetch_targets_mtx);
+            fetch_targets.erase(handle);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t prefetch_cache_hits(bool reset)
+    {
+        return hpx::util::get_and_reset_value(detail::prefetch_hits, reset);
+    }
+
+    std::int64_t prefetch_cache_misses(bool reset)
+    {
+        return hpx::util::get_and_reset_value(detail::prefetch_misses, reset);
+    }
+}}
@@ -7,6 +7,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
 #include <phylanx/util/performance_data.hpp>
 
 #include <hpx/assert.hpp>
@@ -34,7 +35,7 @@ namespace phylanx { namespace util {
         using phylanx::execution_tree::primitives::primitive_component;
 
         hpx::id_type id =
-            hpx::agas::resolve_name(hpx::launch::sync, primitive_instance);
+            execution_tree::resolve_primitive_name(primitive_instance);
 
         if (!id)
         {
@@ -56,8 +57,7 @@ namespace phylanx { namespace util {
         if (primitive_instances.empty())
         {
             // find all local primitives only
-            return enable_measurements(hpx::agas::find_symbols(
-                hpx::launch::sync,
+            return enable_measurements(execution_tree::find_primitives(
                 hpx::util::format("/phylanx${}/*$*", hpx::get_locality_id())));
         }
 
@@ -69,12 +69,8 @@ namespace phylanx { namespace util {
 
         for (auto const& entry : primitive_instances)
         {
-            hpx::future<hpx::id_type> f = hpx::agas::resolve_name(entry);
-            primitives.emplace_back(f.then(
-                [](hpx::future<hpx::id_type>&& f)
-                    -> hpx::future<std::shared_ptr<primitive_component>> {
-                    return hpx::get_ptr<primitive_component>(f.get());
-                }));
+            primitives.emplace_back(hpx::get_ptr<primitive_component>(
+                execution_tree::resolve_primitive_name(entry)));
         }
 
         hpx::wait_all(primitives);
@@ -118,7 +114,7 @@ namespace phylanx { namespace util {
 
     std::vector<std::string> enable_measurements()
     {
-        return enable_measurements(hpx::agas::find_symbols(hpx::launch::sync,
+        return enable_measurements(execution_tree::find_primitives(
             hpx::util::format("/phylanx${}/*$*", hpx::get_locality_id())));
     }
 
@@ -284,7 +280,7 @@ namespace phylanx { namespace util {
     std::map<std::string, std::vector<std::int64_t>> retrieve_counter_data(
         hpx::naming::id_type const& locality_id)
     {
-        auto entries = hpx::agas::find_symbols(hpx::launch::sync,
+        auto entries = execution_tree::find_primitives(
             hpx::util::format("/phylanx${}/*$*",
                 hpx::naming::get_locality_id_from_id(locality_id)));
 
@@ -0,0 +1,101 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Generate a synthetic PhySL program with the given number of lines. The
+// program exercises the different kinds of pattern dispatch performed by the
+// compiler: operators, built-in functions with fixed and variadic arguments,
+// default values and keyword arguments, and calls to user defined functions.
+std::string generate_program(std::int64_t lines)
+{
+    // '@' is replaced by a sequence number
+    char const* const chunk[] = {
+        "    define(f@, a, b, a * b + @.0 - a / (b + 1.0)),\n",
+        "    define(v@, f@(1.0, 2.0) + sum(constant(1.0, list(3)))),\n",
+        "    define(w@, shape(reshape(linspace(0, 1, 6), list(2, 3)), 0)),\n",
+        "    define(x@, sum(random(list(4, 4)), __arg(axis, 0))),\n",
+        "    store(v@, if(v@ > 0.0, v@ * v@, -v@)),\n",
+    };
+    std::size_t const chunk_lines = sizeof(chunk) / sizeof(chunk[0]);
+
+    std::string code = "block(\n";
+    for (std::int64_t i = 0; i < lines; ++i)
+    {
+        std::string const seq = std::to_string(i / chunk_lines);
+        for (char const* p = chunk[i % chunk_lines]; *p != '\0'; ++p)
+        {
+            if (*p == '@')
+            {
+                code += seq;
+            }
+            else
+            {
+                code += *p;
+            }
+        }
+    }
+    code += "    nil\n)\n";
+    return code;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::int64_t const lines = vm["lines"].as<std::int64_t>();
+    std::int64_t const repetitions = vm["repetitions"].as<std::int64_t>();
+
+    std::string const code = generate_program(lines);
+
+    for (std::int64_t i = 0; i != repetitions; ++i)
+    {
+        std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+
+        std::vector<phylanx::ast::expression> ast =
+            phylanx::ast::generate_ast(code);
+
+        std::uint64_t const parse_time =
+            hpx::chrono::high_resolution_clock::now() - t;
+
+        t = hpx::chrono::high_resolution_clock::now();
+
+        phylanx::execution_tree::compiler::function_list snippets;
+        phylanx::execution_tree::compile("compile_time", ast, snippets);
+
+        std::uint64_t const compile_time =
+            hpx::chrono::high_resolution_clock::now() - t;
+
+        std::cout << "lines: " << lines << ", parse: " << (parse_time / 1e6)
+                  << " ms, compile: " << (compile_time / 1e6) << " ms.\n";
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description desc(
+        "usage: compile_time [options]");
+    desc.add_options()("lines,l",
+        hpx::program_options::value<std::int64_t>()->default_value(50000),
+        "number of lines of the generated PhySL program (default: 50000)")(
+        "repetitions,r",
+        hpx::program_options::value<std::int64_t>()->default_value(3),
+        "number of times the program is compiled (default: 3)");
+
+    hpx::init_params params;
+    params.desc_cmdline = desc;
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,107 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Generate a synthetic PhySL program with the given number of lines, covering
+// function calls, operators, literals of all kinds, lists, and comments.
+std::string generate_program(std::int64_t lines)
+{
+    // '@' is replaced by a sequence number
+    char const* const chunk[] = {
+        "    define(f@, a, b, a * b + @.0 - a / (b + 1.0)),   // comment\n",
+        "    define(v@, f@(1.5e-3, -2) + sum([[1, 2, 3], [4, 5, 6]])),\n",
+        "    define(s@, \"string literal @\\n\", '(1, 2.0, \"three\")),\n",
+        "    store(v@, if(v@ > 0.0 && !(v@ == 1), -v@, [1.0, 2.5, @.0])),\n",
+        "    /* block comment */ cout(v@$1$1, s@, [true, false]),\n",
+    };
+    std::size_t const chunk_lines = sizeof(chunk) / sizeof(chunk[0]);
+
+    std::string code = "block(\n";
+    for (std::int64_t i = 0; i < lines; ++i)
+    {
+        std::string const seq = std::to_string(i / chunk_lines);
+        for (char const* p = chunk[i % chunk_lines]; *p != '\0'; ++p)
+        {
+            if (*p == '@')
+            {
+                code += seq;
+            }
+            else
+            {
+                code += *p;
+            }
+        }
+    }
+    code += "    nil\n)\n";
+    return code;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void measure(std::string const& name, std::string const& code,
+    phylanx::ast::parser_type type, std::int64_t repetitions)
+{
+    std::uint64_t best = std::uint64_t(-1);
+    for (std::int64_t i = 0; i != repetitions; ++i)
+    {
+        std::uint64_t const t = hpx::chrono::high_resolution_clock::now();
+
+        std::vector<phylanx::ast::expression> ast =
+            phylanx::ast::generate_ast(code, type);
+
+        std::uint64_t const elapsed =
+            hpx::chrono::high_resolution_clock::now() - t;
+        if (elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+
+    std::cout << name << ": " << (best / 1e6) << " ms, "
+              << (code.size() / (best / 1e9) / (1024 * 1024)) << " MB/s\n";
+}
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::int64_t const lines = vm["lines"].as<std::int64_t>();
+    std::int64_t const repetitions = vm["repetitions"].as<std::int64_t>();
+
+    std::string const code = generate_program(lines);
+
+    std::cout << "lines: " << lines << ", size: " << code.size()
+              << " bytes\n";
+
+    measure("spirit", code, phylanx::ast::parser_type::spirit, repetitions);
+    measure("recursive_descent", code,
+        phylanx::ast::parser_type::recursive_descent, repetitions);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::program_options::options_description desc(
+        "usage: parse_time [options]");
+    desc.add_options()("lines,l",
+        hpx::program_options::value<std::int64_t>()->default_value(50000),
+        "number of lines of the generated PhySL program (default: 50000)")(
+        "repetitions,r",
+        hpx::program_options::value<std::int64_t>()->default_value(3),
+        "number of times the program is parsed (default: 3)");
+
+    hpx::init_params params;
+    params.desc_cmdline = desc;
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,61 @@
+#  Copyright (c) 2020 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# Measure the throughput of invoking a compiled PhySL function concurrently
+# from several Python threads. The evaluation of PhySL functions does not
+# hold the GIL, which allows for the throughput to scale with the number of
+# calling threads.
+
+import argparse
+import threading
+import time
+
+import numpy as np
+from phylanx import Phylanx
+
+
+@Phylanx
+def kernel(x, y):
+    return np.sum(np.exp(x) * y)
+
+
+def worker(x, y, calls):
+    for _ in range(calls):
+        kernel(x, y)
+
+
+def run(num_threads, x, y, calls):
+    threads = [
+        threading.Thread(target=worker, args=(x, y, calls))
+        for _ in range(num_threads)
+    ]
+
+    start = time.time()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return time.time() - start
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--size', type=int, default=1 << 16)
+    parser.add_argument('--calls', type=int, default=100)
+    parser.add_argument('--max-threads', type=int, default=8)
+    args = parser.parse_args()
+
+    x = np.random.rand(args.size)
+    y = np.random.rand(args.size)
+
+    # warm up, this compiles the function
+    kernel(x, y)
+
+    num_threads = 1
+    while num_threads <= args.max_threads:
+        elapsed = run(num_threads, x, y, args.calls)
+        print('threads: %d, calls/s: %.1f' %
+              (num_threads, num_threads * args.calls / elapsed))
+        num_threads *= 2
@@ -0,0 +1,288 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that the hand-written recursive-descent parser generates the same
+// ASTs (including line/column information) as the Spirit based parser. Apart
+// from a set of snippets exercising the corner cases of the grammar, all
+// PhySL files and all raw string literals found in the examples and tests
+// directories are parsed with both parsers.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/filesystem.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Collect the tags (line/column information) of all nodes of an AST, those
+// are not compared by the equality operators of the AST nodes
+struct collect_tags
+{
+    template <typename T>
+    void operator()(T const&) const
+    {
+    }
+
+    template <typename T>
+    void operator()(phylanx::util::recursive_wrapper<T> const& val) const
+    {
+        (*this)(val.get());
+    }
+
+    void operator()(phylanx::ast::identifier const& id) const
+    {
+        record(id.name, id);
+    }
+
+    void operator()(phylanx::ast::primary_expr const& pe) const
+    {
+        record("primary_expr", pe);
+        phylanx::util::visit(*this, pe);
+    }
+
+    void operator()(phylanx::ast::operand const& op) const
+    {
+        phylanx::util::visit(*this, op);
+    }
+
+    void operator()(phylanx::ast::unary_expr const& ue) const
+    {
+        record("unary_expr", ue);
+        (*this)(ue.operand_);
+    }
+
+    void operator()(phylanx::ast::expression const& expr) const
+    {
+        (*this)(expr.first);
+        for (auto const& op : expr.rest)
+        {
+            (*this)(op.operand_);
+        }
+    }
+
+    void operator()(phylanx::ast::function_call const& fc) const
+    {
+        (*this)(fc.function_name);
+        (*this)(fc.args);
+    }
+
+    void operator()(std::vector<phylanx::ast::expression> const& l) const
+    {
+        for (auto const& expr : l)
+        {
+            (*this)(expr);
+        }
+    }
+
+    void record(std::string const& name, phylanx::ast::tagged const& t) const
+    {
+        strm_ << name << ':';
+        if (t.col != -1)
+        {
+            strm_ << t.id << ':' << t.col;
+        }
+        strm_ << '\n';
+    }
+
+    std::stringstream& strm_;
+};
+
+std::string tags_of(std::vector<phylanx::ast::expression> const& asts)
+{
+    std::stringstream strm;
+    collect_tags{strm}(asts);
+    return strm.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Parse the given code using both parsers, returns whether the code was
+// accepted
+bool compare_parsers(std::string const& code, std::string const& origin)
+{
+    std::vector<phylanx::ast::expression> expected;
+    bool spirit_failed = false;
+    try
+    {
+        expected = phylanx::ast::generate_ast(
+            code, phylanx::ast::parser_type::spirit);
+    }
+    catch (...)
+    {
+        spirit_failed = true;
+    }
+
+    std::vector<phylanx::ast::expression> result;
+    bool recursive_descent_failed = false;
+    try
+    {
+        result = phylanx::ast::generate_ast(
+            code, phylanx::ast::parser_type::recursive_descent);
+    }
+    catch (...)
+    {
+        recursive_descent_failed = true;
+    }
+
+    HPX_TEST_EQ_MSG(spirit_failed, recursive_descent_failed, origin);
+    if (!spirit_failed && !recursive_descent_failed)
+    {
+        HPX_TEST_MSG(expected == result, origin);
+        HPX_TEST_EQ_MSG(tags_of(expected), tags_of(result), origin);
+    }
+
+    return !spirit_failed;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const valid_snippets[] = {
+    // identifiers, explicit tags, and function calls
+    "A", "A$1$2", "A$1", "A$-1", "A $ 3 $ 4", "_a1", "A()", "A$1$2()",
+    "f(x, y)", "f (x)", "f{attribute}(x)", "f { attr } ( x , y )",
+    "f(g(h(1)), 'x', \"y\")", "f$3(x)", "define(x, 42)",
+
+    // lists
+    "'()", "'(1, 2.0, \"three\")", "' (a, '(b, c))",
+
+    // literals
+    "42", "-42", "+42", "1.0", "-1.5", ".5", "5.", "1e5", "1E-5", "1.5e+3",
+    "-inf", "infinity", "true", "false", "nil",
+    "\"string\"", "\"\\a\\b\\f\\n\\r\\t\\v\\\\\\'\\\"\"", "\"\\x41\\x4a4\"",
+    "\"\\q\\x\"", "\"multi\nline\"",
+
+    // array literals
+    "[]", "[[]]", "[[], []]", "[[[]]]", "[[[[]]]]", "[true, false]",
+    "[[true], [false]]", "[1, 2, 3]", "[-1, +2]", "[[1, 2], [3, 4]]",
+    "[[[1]], [[2]]]", "[[[[1, 2]]]]", "[1.5, 2]", "[1, 2.5]", "[[1], [2.5]]",
+    "[ 1 , 2 ]", "[inf, -inf]", "[1e3]",
+
+    // operators
+    "A + B", "A - B * C / D % E", "A || B && C", "A == B != C",
+    "A < B <= C > D >= E", "-A", "!A", "+A", "- A", "--A", "- -1",
+    "-(A + B)", "!(A && B)", "A -1", "A - -1", "(A)", "((A))",
+    "(A + B) * C",
+
+    // multiple expressions, whitespace and comments
+    "A B", "42 43", "A\n42", "42\n43", "f(x)\n\n  42", "  \t 42  ",
+    "// comment\n42", "# comment\n42", "/* comment */ 42", "42 // comment",
+    "42 # comment", "f(/* x */ 1, // y\n 2)", "1 +\n 2", "1\r\n+\r\n2",
+    "",
+
+    // a small program
+    R"(
+        define(fib, n,
+            if(n < 2, n,
+                fib(n - 1) + fib(n - 2)
+            )
+        )
+        fib(10)
+    )",
+};
+
+char const* const invalid_snippets[] = {
+    "(", ")", "f(", "f(x", "f(x,)", "'(", "'(1", "A +", "-", "\"unterminated",
+    "f{x(y)", "A$", "A$x", "[1, [2]]", "[[1], 2]", "[1, true]", "[[1.5], 2]",
+    "[1.5", "(1 + )", "99999999999999999999", "/* unterminated", "A{x}",
+    "@",
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Extract all raw string literals from the given C++ source
+std::vector<std::string> extract_raw_strings(std::string const& source)
+{
+    std::vector<std::string> result;
+
+    std::size_t pos = 0;
+    while ((pos = source.find("R\"", pos)) != std::string::npos)
+    {
+        std::size_t const open = source.find('(', pos + 2);
+        if (open == std::string::npos || open - pos - 2 > 16)
+        {
+            pos += 2;
+            continue;
+        }
+
+        std::string const delimiter =
+            ")" + source.substr(pos + 2, open - pos - 2) + "\"";
+        std::size_t const close = source.find(delimiter, open + 1);
+        if (close == std::string::npos)
+        {
+            break;
+        }
+
+        result.push_back(source.substr(open + 1, close - open - 1));
+        pos = close + delimiter.size();
+    }
+
+    return result;
+}
+
+void compare_directory(std::string const& dir)
+{
+    namespace fs = hpx::filesystem;
+
+    std::size_t snippets = 0;
+
+    for (auto const& entry : fs::recursive_directory_iterator(dir))
+    {
+        if (!fs::is_regular_file(entry.path()))
+        {
+            continue;
+        }
+
+        std::string const ext = entry.path().extension().string();
+        if (ext != ".physl" && ext != ".cpp" && ext != ".hpp")
+        {
+            continue;
+        }
+
+        std::ifstream in(entry.path().string(), std::ios::binary);
+        std::string const content{std::istreambuf_iterator<char>(in),
+            std::istreambuf_iterator<char>()};
+
+        std::string const origin = entry.path().string();
+        if (ext == ".physl")
+        {
+            HPX_TEST_MSG(compare_parsers(content, origin), origin);
+            ++snippets;
+        }
+        else
+        {
+            for (auto const& code : extract_raw_strings(content))
+            {
+                compare_parsers(code, origin);
+                ++snippets;
+            }
+        }
+    }
+
+    HPX_TEST_LT(std::size_t(0), snippets);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    for (char const* code : valid_snippets)
+    {
+        HPX_TEST_MSG(compare_parsers(code, code), code);
+    }
+
+    for (char const* code : invalid_snippets)
+    {
+        HPX_TEST_MSG(!compare_parsers(code, code), code);
+    }
+
+    compare_directory(std::string(PHYLANX_SOURCE_DIR) + "/examples");
+    compare_directory(std::string(PHYLANX_SOURCE_DIR) + "/tests");
+
+    return hpx::util::report_errors();
+}
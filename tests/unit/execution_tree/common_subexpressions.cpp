@@ -0,0 +1,89 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// exp(-x * 2.0) appears twice in the loop body, both occurrences are compiled
+// into the same primitive which is evaluated once per iteration
+char const* const code = R"(block(
+    define(x, 0.5),
+    define(y, 0.0),
+    define(i, 0),
+    while(i < 3,
+        block(
+            store(y, y + exp(-x * 2.0) * exp(-x * 2.0)),
+            store(x, x + 1.0),
+            store(i, i + 1)
+        )
+    ),
+    y
+))";
+
+std::int64_t memoized_count(bool reset = false)
+{
+    hpx::performance_counters::performance_counter pc(
+        "/phylanx{locality#0/total}/eval/count/memoized");
+    return pc.get_value<std::int64_t>(hpx::launch::sync, reset);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    memoized_count(true);
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f = phylanx::execution_tree::compile(code, snippets);
+
+    // the identical subexpressions share their primitives
+    HPX_TEST_EQ(
+        phylanx::execution_tree::find_primitives("/phylanx$0/exp$*").size(),
+        std::size_t(1));
+    HPX_TEST_EQ(
+        phylanx::execution_tree::find_primitives("/phylanx$0/__minus$*").size(),
+        std::size_t(1));
+
+    // the shared result has to be recomputed whenever x was modified
+    auto result = f.run()();
+
+    double expected = 0.0;
+    for (double x = 0.5; x < 3.0; x += 1.0)
+    {
+        expected += std::exp(-x * 2.0) * std::exp(-x * 2.0);
+    }
+
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_scalar_numeric_value(result),
+        expected);
+
+    // one of the two evaluations of exp() per iteration used the memoized
+    // result
+    HPX_TEST_EQ(memoized_count(), std::int64_t(3));
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "phylanx.cse!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,113 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t count_primitives(std::string const& name)
+{
+    return phylanx::execution_tree::find_primitives(
+        "/phylanx$0/" + name + "$*").size();
+}
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f = phylanx::execution_tree::compile(code, snippets);
+    return f.run()();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_fold_arithmetics()
+{
+    auto result = compile_and_run("constant(2.0, 4) + 2 * 3");
+
+    // all of the expression was evaluated by the compiler
+    HPX_TEST_EQ(count_primitives("constant"), std::size_t(0));
+    HPX_TEST_EQ(count_primitives("__add"), std::size_t(0));
+    HPX_TEST_EQ(count_primitives("__mul"), std::size_t(0));
+
+    blaze::DynamicVector<double> expected(4, 8.0);
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_numeric_value(result),
+        phylanx::ir::node_data<double>(std::move(expected)));
+}
+
+void test_fold_nested()
+{
+    auto result = compile_and_run("shape(eye(3))");
+
+    HPX_TEST_EQ(count_primitives("eye"), std::size_t(0));
+    HPX_TEST_EQ(count_primitives("shape"), std::size_t(0));
+
+    auto shape = phylanx::execution_tree::extract_list_value(result);
+    HPX_TEST_EQ(shape.size(), std::size_t(2));
+    for (auto const& dim : shape)
+    {
+        HPX_TEST_EQ(
+            phylanx::execution_tree::extract_scalar_integer_value(dim),
+            std::int64_t(3));
+    }
+}
+
+void test_no_fold_variables()
+{
+    // expressions depending on variables are evaluated at runtime
+    auto result = compile_and_run("block(define(x, 21.0), x * 2.0)");
+
+    HPX_TEST_EQ(count_primitives("__mul"), std::size_t(1));
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_scalar_numeric_value(result), 42.0);
+}
+
+void test_no_fold_errors()
+{
+    // errors detected while folding are reported at runtime
+    bool caught_exception = false;
+    try
+    {
+        compile_and_run("[1.0, 2.0] + [1.0, 2.0, 3.0]");
+    }
+    catch (std::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+    HPX_TEST_EQ(count_primitives("__add"), std::size_t(1));
+}
+
+void test_no_fold_large_arrays()
+{
+    // arrays larger than phylanx.constant_folding.max_size are created at
+    // runtime
+    auto result = compile_and_run("constant(1.0, list(100, 100))");
+
+    HPX_TEST_EQ(count_primitives("constant"), std::size_t(1));
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_numeric_value_size(result),
+        std::size_t(10000));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_fold_arithmetics();
+    test_fold_nested();
+    test_no_fold_variables();
+    test_no_fold_errors();
+    test_no_fold_large_arrays();
+
+    return hpx::util::report_errors();
+}
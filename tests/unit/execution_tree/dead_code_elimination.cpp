@@ -0,0 +1,94 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t dead_code_count(bool reset = false)
+{
+    hpx::performance_counters::performance_counter pc(
+        "/phylanx{locality#0/total}/compiler/count/dead_code");
+    return pc.get_value<std::int64_t>(hpx::launch::sync, reset);
+}
+
+double compile_and_run(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f = phylanx::execution_tree::compile(code, snippets);
+    return phylanx::execution_tree::extract_scalar_numeric_value(f.run()());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_dead_code()
+{
+    // the defines for 'unused' and 'unused_function' and the first store to
+    // 'y' are removed
+    char const* const code = R"(block(
+        define(unused, exp(2.0) * 2.0),
+        define(unused_function, a, a + 1.0),
+        define(y, 0.0),
+        define(z, 1.0),
+        store(y, z * 2.0),
+        store(y, z + 3.0),
+        y
+    ))";
+
+    dead_code_count(true);
+    HPX_TEST_EQ(compile_and_run(code), 4.0);
+    HPX_TEST_EQ(dead_code_count(), std::int64_t(3));
+}
+
+void test_live_code()
+{
+    // all stores are read before being overwritten, the define of 'unused'
+    // has side effects
+    char const* const code = R"(block(
+        define(unused, random(2)),
+        define(x, 1.0),
+        define(y, 0.0),
+        store(y, x),
+        store(x, y + 1.0),
+        store(y, 2.0),
+        x + y
+    ))";
+
+    dead_code_count(true);
+    HPX_TEST_EQ(compile_and_run(code), 4.0);
+    HPX_TEST_EQ(dead_code_count(), std::int64_t(0));
+}
+
+void test_nested_dead_code()
+{
+    // removing the define of 'b' turns the define of 'a' into dead code
+    char const* const code = R"(
+        define(f, x, block(
+            define(a, x * 2.0),
+            define(b, a + 1.0),
+            x
+        ))
+        f(21.0)
+    )";
+
+    dead_code_count(true);
+    HPX_TEST_EQ(compile_and_run(code), 21.0);
+    HPX_TEST_EQ(dead_code_count(), std::int64_t(2));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_dead_code();
+    test_live_code();
+    test_nested_dead_code();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,50 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const fib_code = R"(block(
+    define(fib, n,
+        if(n < 2, n, fib(n - 1) + fib(n - 2))
+    ),
+    fib
+))";
+
+std::int64_t counter_value(std::string const& name, bool reset = false)
+{
+    hpx::performance_counters::performance_counter pc(
+        "/phylanx{locality#0/total}/eval/count/" + name);
+    return pc.get_value<std::int64_t>(hpx::launch::sync, reset);
+}
+
+int main()
+{
+    // reset both counters
+    counter_value("local", true);
+    counter_value("action", true);
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(fib_code, snippets);
+    auto fib = code.run();
+
+    auto result = fib(std::int64_t(10));
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_scalar_integer_value(result), 55);
+
+    // all primitives live on this locality, therefore every evaluation should
+    // have been dispatched directly
+    HPX_TEST_LT(std::int64_t(0), counter_value("local"));
+    HPX_TEST_EQ(std::int64_t(0), counter_value("action"));
+
+    return hpx::util::report_errors();
+}
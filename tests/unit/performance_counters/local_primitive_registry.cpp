@@ -0,0 +1,98 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/agas.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(sum_squares, x, y, x * x + y * y),
+    define(z, 3.0),
+    sum_squares(z, 4.0) + sum_squares(1.0, 2.0)
+))";
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& f = phylanx::execution_tree::compile(code, snippets);
+    auto result = f.run()();
+
+    HPX_TEST_EQ(phylanx::execution_tree::extract_scalar_numeric_value(result),
+        30.0);
+
+    // anonymous expression nodes are not registered with AGAS
+    auto find_agas = [](char const* pattern) {
+        return hpx::agas::find_symbols(hpx::launch::sync, pattern);
+    };
+
+    HPX_TEST(find_agas("/phylanx$0/__add$*").empty());
+    HPX_TEST(find_agas("/phylanx$0/__mul$*").empty());
+
+    // defined entities are still registered with AGAS
+    HPX_TEST(!find_agas("/phylanx$0/function$*").empty());
+    HPX_TEST(!find_agas("/phylanx$0/variable$*").empty());
+
+    // the anonymous nodes can be found through the local registry
+    auto adds = phylanx::execution_tree::find_primitives("/phylanx$0/__add$*");
+    HPX_TEST_EQ(adds.size(), std::size_t(2));
+
+    auto muls = phylanx::execution_tree::find_primitives("/phylanx$0/__mul$*");
+    HPX_TEST_EQ(muls.size(), std::size_t(2));
+
+    for (auto const& entry : adds)
+    {
+        HPX_TEST(phylanx::execution_tree::resolve_primitive_name(entry.first) ==
+            entry.second);
+    }
+
+    // performance counters cover the locally registered primitives
+    hpx::performance_counters::performance_counter count_pc(
+        "/phylanx{locality#0/total}/primitives/__mul/count/eval");
+
+    // reset the counter values, this also enables the measurements
+    auto const values =
+        count_pc.get_counter_values_array(hpx::launch::sync, true);
+
+    HPX_TEST_EQ(values.values_.size(), muls.size());
+
+    // sum_squares is invoked twice, each invocation evaluates both of the
+    // multiplications
+    f.run()();
+
+    auto const values_after =
+        count_pc.get_counter_values_array(hpx::launch::sync, false);
+
+    std::int64_t evals = 0;
+    for (auto value : values_after.values_)
+    {
+        evals += value;
+    }
+    HPX_TEST_EQ(evals, std::int64_t(4));
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "phylanx.agas_registration!=defined"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
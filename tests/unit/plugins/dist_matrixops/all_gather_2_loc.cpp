@@ -113,6 +113,56 @@ void test_all_gather_2d_2()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void test_gather_2d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_all_gather_d_operation("test_gather2d_0", R"(
+            gather_d(
+                annotate_d([[1, 2, 3], [4, 5, 6]], "gather_array_0",
+                    list("tile", list("columns", 0, 3), list("rows", 0, 2))
+                )
+            )
+        )", "[[1, 2, 3], [4, 5, 6], [7, 8, 9]]");
+    }
+    else
+    {
+        test_all_gather_d_operation("test_gather2d_0", R"(
+            gather_d(
+                annotate_d([[7, 8, 9]], "gather_array_0",
+                    list("tile", list("columns", 0, 3), list("rows", 2, 3))
+                )
+            )
+        )", "[[7, 8, 9]]");
+    }
+}
+
+void test_gather_2d_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_all_gather_d_operation("test_gather2d_1", R"(
+            gather_d(
+                annotate_d([[1, 4], [2, 5], [3, 6]], "gather_array_1",
+                    list("tile", list("columns", 0, 2), list("rows", 0, 3))
+                ),
+                1
+            )
+        )", "[[1, 4], [2, 5], [3, 6]]");
+    }
+    else
+    {
+        test_all_gather_d_operation("test_gather2d_1", R"(
+            gather_d(
+                annotate_d([[7], [8], [9]], "gather_array_1",
+                    list("tile", list("columns", 2, 3), list("rows", 0, 3))
+                ),
+                1
+            )
+        )", "[[1, 4, 7], [2, 5, 8], [3, 6, 9]]");
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
@@ -121,6 +171,9 @@ int hpx_main(int argc, char* argv[])
     test_all_gather_2d_1();
     test_all_gather_2d_2();
 
+    test_gather_2d_0();
+    test_gather_2d_1();
+
     hpx::finalize();
     return hpx::util::report_errors();
 }
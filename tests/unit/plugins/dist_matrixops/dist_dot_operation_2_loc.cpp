@@ -405,6 +405,40 @@ void test_dot_2d1d_4()
     }
 }
 
+void test_dot_2d1d_5()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_dot_operation("test2d1d_5", R"(
+            dot_d(
+                annotate_d([[1, 2, 3], [2, 3, 4]], "test2d1d_5_1",
+                    list("tile", list("columns", 0, 3), list("rows", 0, 2))),
+                annotate_d([4, 5, 6], "test2d1d_5_2",
+                    list("tile", list("columns", 3, 6))),
+                "row"
+            )
+        )", R"(
+            annotate_d([91], "test2d1d_5_1/1",
+                list("tile", list("columns", 0, 1)))
+        )");
+    }
+    else
+    {
+        test_dot_operation("test2d1d_5", R"(
+            dot_d(
+                annotate_d([[4, 5, 6], [5, 6, 7]], "test2d1d_5_1",
+                    list("tile", list("columns", 3, 6), list("rows", 0, 2))),
+                annotate_d([1, 2, 3], "test2d1d_5_2",
+                    list("tile", list("columns", 0, 3))),
+                "row"
+            )
+        )", R"(
+            annotate_d([112], "test2d1d_5_1/1",
+                list("tile", list("columns", 1, 2)))
+        )");
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void test_dot_2d2d_1()
 {
@@ -558,6 +592,70 @@ void test_dot_2d2d_5()
     }
 }
 
+void test_dot_2d2d_6()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_dot_operation("test2d2d_6", R"(
+            dot_d(
+                annotate_d([[1, 2, 3], [2, 3, 4]], "test2d2d_6_1",
+                    list("tile", list("columns", 0, 3), list("rows", 0, 2))),
+                [[1, 2], [2, 3], [3, 4], [4, 5], [5, 6], [6, 7]],
+                "row"
+            )
+        )", R"(
+            annotate_d([[91, 112]], "test2d2d_6_1/1",
+                list("tile", list("columns", 0, 2), list("rows", 0, 1)))
+        )");
+    }
+    else
+    {
+        test_dot_operation("test2d2d_6", R"(
+            dot_d(
+                annotate_d([[4, 5, 6], [5, 6, 7]], "test2d2d_6_1",
+                    list("tile", list("columns", 3, 6), list("rows", 0, 2))),
+                [[1, 2], [2, 3], [3, 4], [4, 5], [5, 6], [6, 7]],
+                "row"
+            )
+        )", R"(
+            annotate_d([[112, 139]], "test2d2d_6_1/1",
+                list("tile", list("columns", 0, 2), list("rows", 1, 2)))
+        )");
+    }
+}
+
+void test_dot_2d2d_7()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_dot_operation("test2d2d_7", R"(
+            dot_d(
+                annotate_d([[1, 2, 3], [2, 3, 4]], "test2d2d_7_1",
+                    list("tile", list("columns", 0, 3), list("rows", 0, 2))),
+                [[1, 2], [2, 3], [3, 4], [4, 5], [5, 6], [6, 7]],
+                "column"
+            )
+        )", R"(
+            annotate_d([[91], [112]], "test2d2d_7_1/1",
+                list("tile", list("columns", 0, 1), list("rows", 0, 2)))
+        )");
+    }
+    else
+    {
+        test_dot_operation("test2d2d_7", R"(
+            dot_d(
+                annotate_d([[4, 5, 6], [5, 6, 7]], "test2d2d_7_1",
+                    list("tile", list("columns", 3, 6), list("rows", 0, 2))),
+                [[1, 2], [2, 3], [3, 4], [4, 5], [5, 6], [6, 7]],
+                "column"
+            )
+        )", R"(
+            annotate_d([[112], [139]], "test2d2d_7_1/1",
+                list("tile", list("columns", 1, 2), list("rows", 0, 2)))
+        )");
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -577,12 +675,15 @@ int hpx_main(int argc, char* argv[])
     test_dot_2d1d_2();
     test_dot_2d1d_3();
     test_dot_2d1d_4();
+    test_dot_2d1d_5();
 
     test_dot_2d2d_1();
     test_dot_2d2d_2();
     test_dot_2d2d_3();
     test_dot_2d2d_4();
     test_dot_2d2d_5();
+    test_dot_2d2d_6();
+    test_dot_2d2d_7();
 
     hpx::finalize();
     return hpx::util::report_errors();
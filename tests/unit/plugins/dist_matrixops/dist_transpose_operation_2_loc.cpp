@@ -0,0 +1,131 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_transpose_d_operation(std::string const& name,
+    std::string const& code, std::string const& expected_str)
+{
+    phylanx::execution_tree::primitive_argument_type result =
+        compile_and_run(name, code);
+    phylanx::execution_tree::primitive_argument_type comparison =
+        compile_and_run(name, expected_str);
+
+    HPX_TEST_EQ(hpx::cout, result, comparison);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// the transposed matrix is tiled the same way as the original one
+void test_transpose_keep_tiling_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_transpose_d_operation("test_keep_tiling_0", R"(
+            transpose_d(
+                annotate_d([[1, 2, 3], [4, 5, 6], [7, 8, 9]], "keep_tiling_0",
+                    list("tile", list("columns", 0, 2), list("rows", 0, 3))
+                ),
+                nil, true
+            )
+        )", R"(
+            annotate_d([[1, 4], [2, 5], [3, 6]], "keep_tiling_0_transposed/1",
+                list("tile", list("rows", 0, 3), list("columns", 0, 2))
+            )
+        )");
+    }
+    else
+    {
+        test_transpose_d_operation("test_keep_tiling_0", R"(
+            transpose_d(
+                annotate_d([[3], [6], [9]], "keep_tiling_0",
+                    list("tile", list("columns", 2, 3), list("rows", 0, 3))
+                ),
+                nil, true
+            )
+        )", R"(
+            annotate_d([[7], [8], [9]], "keep_tiling_0_transposed/1",
+                list("tile", list("rows", 0, 3), list("columns", 2, 3))
+            )
+        )");
+    }
+}
+
+// a non-square row-tiled matrix gives a row-tiled result
+void test_transpose_keep_tiling_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_transpose_d_operation("test_keep_tiling_1", R"(
+            transpose_d(
+                annotate_d([[1, 2], [3, 4]], "keep_tiling_1",
+                    list("tile", list("rows", 0, 2), list("columns", 0, 2))
+                ),
+                nil, true
+            )
+        )", R"(
+            annotate_d([[1, 3, 5, 7]], "keep_tiling_1_transposed/1",
+                list("tile", list("rows", 0, 1), list("columns", 0, 4))
+            )
+        )");
+    }
+    else
+    {
+        test_transpose_d_operation("test_keep_tiling_1", R"(
+            transpose_d(
+                annotate_d([[5, 6], [7, 8]], "keep_tiling_1",
+                    list("tile", list("rows", 2, 4), list("columns", 0, 2))
+                ),
+                nil, true
+            )
+        )", R"(
+            annotate_d([[2, 4, 6, 8]], "keep_tiling_1_transposed/1",
+                list("tile", list("rows", 1, 2), list("columns", 0, 4))
+            )
+        )");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_transpose_keep_tiling_0();
+    test_transpose_keep_tiling_1();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
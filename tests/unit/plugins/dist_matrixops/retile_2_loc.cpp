@@ -10,8 +10,10 @@
 #include <hpx/hpx_init.hpp>
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -679,6 +681,79 @@ void test_retile_2loc_3d_2()
     }
 }
 
+std::int64_t retile_plans_count(char const* name, bool reset = false)
+{
+    hpx::performance_counters::performance_counter pc(
+        "/phylanx{locality#" + std::to_string(hpx::get_locality_id()) +
+        "/total}/retile/count/" + name);
+    return pc.get_value<std::int64_t>(hpx::launch::sync, reset);
+}
+
+// retiling the same array repeatedly reuses the redistribution plan
+void test_retile_2loc_2d_4()
+{
+    retile_plans_count("plans_computed", true);
+    retile_plans_count("plans_reused", true);
+
+    if (hpx::get_locality_id() == 0)
+    {
+        test_retile_d_operation("test_retile_2loc2d_4", R"(
+            block(
+                define(a, annotate_d([[1, 2], [5, 6], [9, 10], [13, 14]],
+                    "tiled_array_2d_4",
+                    list("tile", list("rows", 0, 4), list("columns", 0, 2))
+                )),
+                define(r, a),
+                define(i, 0),
+                while(i < 3,
+                    block(
+                        store(r, retile_d(a, "row")),
+                        store(i, i + 1)
+                    )
+                ),
+                r
+            )
+        )", R"(
+            annotate_d([[1, 2, 3, 4], [5, 6, 7, 8]],
+                "tiled_array_2d_4_retiled/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("rows", 0, 2), list("columns", 0, 4))))
+        )");
+    }
+    else
+    {
+        test_retile_d_operation("test_retile_2loc2d_4", R"(
+            block(
+                define(a, annotate_d([[3, 4], [7, 8], [11, 12], [15, 16]],
+                    "tiled_array_2d_4",
+                    list("tile", list("rows", 0, 4), list("columns", 2, 4))
+                )),
+                define(r, a),
+                define(i, 0),
+                while(i < 3,
+                    block(
+                        store(r, retile_d(a, "row")),
+                        store(i, i + 1)
+                    )
+                ),
+                r
+            )
+        )", R"(
+            annotate_d([[9, 10, 11, 12], [13, 14, 15, 16]],
+                "tiled_array_2d_4_retiled/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("rows", 2, 4), list("columns", 0, 4))))
+        )");
+    }
+
+    // the plan is computed by the first and reused by the two remaining
+    // invocations of retile_d
+    HPX_TEST_EQ(retile_plans_count("plans_computed"), std::int64_t(1));
+    HPX_TEST_EQ(retile_plans_count("plans_reused"), std::int64_t(2));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(int argc, char* argv[])
 {
@@ -696,6 +771,7 @@ int hpx_main(int argc, char* argv[])
     test_retile_2loc_2d_1();
     test_retile_2loc_2d_2();
     test_retile_2loc_2d_3();
+    test_retile_2loc_2d_4();
 
     test_retile_2loc_3d_0();
     test_retile_2loc_3d_1();
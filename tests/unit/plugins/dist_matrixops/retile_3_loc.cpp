@@ -10,8 +10,10 @@
 #include <hpx/hpx_init.hpp>
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -641,6 +643,98 @@ void test_retile_3loc_2d_3()
     }
 }
 
+std::int64_t retile_plans_count(char const* name, bool reset = false)
+{
+    hpx::performance_counters::performance_counter pc(
+        "/phylanx{locality#" + std::to_string(hpx::get_locality_id()) +
+        "/total}/retile/count/" + name);
+    return pc.get_value<std::int64_t>(hpx::launch::sync, reset);
+}
+
+// each locality exchanges one block with each of the other localities, the
+// redistribution plan is reused by repeated retilings
+void test_retile_3loc_2d_4()
+{
+    retile_plans_count("plans_computed", true);
+    retile_plans_count("plans_reused", true);
+
+    if (hpx::get_locality_id() == 0)
+    {
+        test_retile_d_operation("test_retile_3loc2d_4", R"(
+            block(
+                define(a, annotate_d([[1, 2, 3]], "tiled_array_2d_4",
+                    list("tile", list("rows", 0, 1), list("columns", 0, 3))
+                )),
+                define(r, a),
+                define(i, 0),
+                while(i < 3,
+                    block(
+                        store(r, retile_d(a, "column")),
+                        store(i, i + 1)
+                    )
+                ),
+                r
+            )
+        )", R"(
+            annotate_d([[1], [4], [7]], "tiled_array_2d_4_retiled/1",
+                list("args",
+                    list("locality", 0, 3),
+                    list("tile", list("rows", 0, 3), list("columns", 0, 1))))
+        )");
+    }
+    else if (hpx::get_locality_id() == 1)
+    {
+        test_retile_d_operation("test_retile_3loc2d_4", R"(
+            block(
+                define(a, annotate_d([[4, 5, 6]], "tiled_array_2d_4",
+                    list("tile", list("rows", 1, 2), list("columns", 0, 3))
+                )),
+                define(r, a),
+                define(i, 0),
+                while(i < 3,
+                    block(
+                        store(r, retile_d(a, "column")),
+                        store(i, i + 1)
+                    )
+                ),
+                r
+            )
+        )", R"(
+            annotate_d([[2], [5], [8]], "tiled_array_2d_4_retiled/1",
+                list("args",
+                    list("locality", 1, 3),
+                    list("tile", list("rows", 0, 3), list("columns", 1, 2))))
+        )");
+    }
+    else
+    {
+        test_retile_d_operation("test_retile_3loc2d_4", R"(
+            block(
+                define(a, annotate_d([[7, 8, 9]], "tiled_array_2d_4",
+                    list("tile", list("rows", 2, 3), list("columns", 0, 3))
+                )),
+                define(r, a),
+                define(i, 0),
+                while(i < 3,
+                    block(
+                        store(r, retile_d(a, "column")),
+                        store(i, i + 1)
+                    )
+                ),
+                r
+            )
+        )", R"(
+            annotate_d([[3], [6], [9]], "tiled_array_2d_4_retiled/1",
+                list("args",
+                    list("locality", 2, 3),
+                    list("tile", list("rows", 0, 3), list("columns", 2, 3))))
+        )");
+    }
+
+    HPX_TEST_EQ(retile_plans_count("plans_computed"), std::int64_t(1));
+    HPX_TEST_EQ(retile_plans_count("plans_reused"), std::int64_t(2));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void test_retile_3loc_3d_0()
 {
@@ -771,6 +865,7 @@ int hpx_main(int argc, char* argv[])
     test_retile_3loc_2d_1();
     test_retile_3loc_2d_2();
     test_retile_3loc_2d_3();
+    test_retile_3loc_2d_4();
 
     test_retile_3loc_3d_0();
     test_retile_3loc_3d_1();
@@ -0,0 +1,133 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_update_halo_d_operation(std::string const& name,
+    std::string const& code, std::string const& expected_str)
+{
+    phylanx::execution_tree::primitive_argument_type result =
+        compile_and_run(name, code);
+    phylanx::execution_tree::primitive_argument_type comparison =
+        compile_and_run(name, expected_str);
+
+    HPX_TEST_EQ(hpx::cout, result, comparison);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the tiles overlap on [3, 5), locality 0 owns [3, 4), locality 1 owns [4, 5)
+void test_update_halo_2loc_1d()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_update_halo_d_operation("test_update_halo_2loc1d", R"(
+            update_halo_d(
+                annotate_d([1, 2, 3, 4, 0], "halo_array_1d",
+                    list("tile", list("columns", 0, 5))
+                )
+            )
+        )", R"(
+            annotate_d([1, 2, 3, 4, 50], "halo_array_1d",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 5))))
+        )");
+    }
+    else
+    {
+        test_update_halo_d_operation("test_update_halo_2loc1d", R"(
+            update_halo_d(
+                annotate_d([-1, 50, 6, 7, 8], "halo_array_1d",
+                    list("tile", list("columns", 3, 8))
+                )
+            )
+        )", R"(
+            annotate_d([4, 50, 6, 7, 8], "halo_array_1d",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 8))))
+        )");
+    }
+}
+
+// the tiles overlap on rows [1, 3), locality 0 owns row 1, locality 1 owns
+// row 2
+void test_update_halo_2loc_2d()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_update_halo_d_operation("test_update_halo_2loc2d", R"(
+            update_halo_d(
+                annotate_d([[1, 2, 3], [4, 5, 6], [0, 0, 0]], "halo_array_2d",
+                    list("tile", list("rows", 0, 3), list("columns", 0, 3))
+                )
+            )
+        )", R"(
+            annotate_d([[1, 2, 3], [4, 5, 6], [7, 8, 9]], "halo_array_2d",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("rows", 0, 3), list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_update_halo_d_operation("test_update_halo_2loc2d", R"(
+            update_halo_d(
+                annotate_d([[-1, -1, -1], [7, 8, 9], [10, 11, 12]],
+                    "halo_array_2d",
+                    list("tile", list("rows", 1, 4), list("columns", 0, 3))
+                )
+            )
+        )", R"(
+            annotate_d([[4, 5, 6], [7, 8, 9], [10, 11, 12]], "halo_array_2d",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("rows", 1, 4), list("columns", 0, 3))))
+        )");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_update_halo_2loc_1d();
+    test_update_halo_2loc_2d();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
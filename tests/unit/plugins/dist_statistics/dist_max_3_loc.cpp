@@ -0,0 +1,140 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_amax_d_operation(std::string const& name, std::string const& code,
+    std::string const& expected_str)
+{
+    phylanx::execution_tree::primitive_argument_type result =
+        compile_and_run(name, code);
+    phylanx::execution_tree::primitive_argument_type comparison =
+        compile_and_run(name, expected_str);
+
+    HPX_TEST_EQ(hpx::cout, result, comparison);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// all localities receive the maximum of the whole array
+void test_amax_d_1d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_amax_d_operation("test_amax_d_3loc1d_0", R"(
+            amax_d(annotate_d([-5.0, -2.0, -9.0], "amax_array_0",
+                list("tile", list("columns", 0, 3))))
+        )", "-2.0");
+    }
+    else if (hpx::get_locality_id() == 1)
+    {
+        test_amax_d_operation("test_amax_d_3loc1d_0", R"(
+            amax_d(annotate_d([-7.0, -3.0], "amax_array_0",
+                list("tile", list("columns", 3, 5))))
+        )", "-2.0");
+    }
+    else
+    {
+        test_amax_d_operation("test_amax_d_3loc1d_0", R"(
+            amax_d(annotate_d([-4.0], "amax_array_0",
+                list("tile", list("columns", 5, 6))))
+        )", "-2.0");
+    }
+}
+
+// an empty tile does not contribute to the result
+void test_amax_d_1d_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_amax_d_operation("test_amax_d_3loc1d_1", R"(
+            amax_d(annotate_d([-5.0, -2.0, -9.0], "amax_array_1",
+                list("tile", list("columns", 0, 3))))
+        )", "-2.0");
+    }
+    else if (hpx::get_locality_id() == 1)
+    {
+        test_amax_d_operation("test_amax_d_3loc1d_1", R"(
+            amax_d(annotate_d([], "amax_array_1",
+                list("tile", list("columns", 0, 0))))
+        )", "-2.0");
+    }
+    else
+    {
+        test_amax_d_operation("test_amax_d_3loc1d_1", R"(
+            amax_d(annotate_d([-4.0, -6.0], "amax_array_1",
+                list("tile", list("columns", 3, 5))))
+        )", "-2.0");
+    }
+}
+
+void test_amax_d_2d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_amax_d_operation("test_amax_d_3loc2d_0", R"(
+            amax_d(annotate_d([[-3, -7], [-1, -8]], "amax_array2d_0",
+                list("tile", list("rows", 0, 2), list("columns", 0, 2))))
+        )", "-1.0");
+    }
+    else if (hpx::get_locality_id() == 1)
+    {
+        test_amax_d_operation("test_amax_d_3loc2d_0", R"(
+            amax_d(annotate_d(astype([[]], "int"), "amax_array2d_0",
+                list("tile", list("rows", 0, 0), list("columns", 0, 0))))
+        )", "-1.0");
+    }
+    else
+    {
+        test_amax_d_operation("test_amax_d_3loc2d_0", R"(
+            amax_d(annotate_d([[-4, -6]], "amax_array2d_0",
+                list("tile", list("rows", 2, 3), list("columns", 0, 2))))
+        )", "-1.0");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_amax_d_1d_0();
+    test_amax_d_1d_1();
+
+    test_amax_d_2d_0();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -10,6 +10,7 @@
 #include <hpx/modules/testing.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <string>
 #include <utility>
@@ -85,10 +86,58 @@ void test_file_io_primitive(phylanx::ir::node_data<double> const& in)
     std::remove(filename.c_str());
 }
 
+void test_file_io_async(phylanx::ir::node_data<double> const& in)
+{
+    std::string filename = std::tmpnam(nullptr);
+
+    // write to file, without waiting for the write to finish
+    {
+        phylanx::execution_tree::primitive outfile =
+            phylanx::execution_tree::primitives::create_file_write_csv(
+                hpx::find_here(),
+                phylanx::execution_tree::primitive_arguments_type{
+                    {filename}, in,
+                    phylanx::execution_tree::primitive_argument_type{true}});
+
+        auto f = outfile.eval();
+        HPX_TEST(in == phylanx::execution_tree::extract_numeric_value(f.get()));
+    }
+
+    // wait for all outstanding writes
+    {
+        phylanx::execution_tree::primitive wait =
+            phylanx::execution_tree::primitives::create_file_write_wait(
+                hpx::find_here(),
+                phylanx::execution_tree::primitive_arguments_type{});
+
+        auto f = wait.eval();
+        HPX_TEST_EQ(phylanx::execution_tree::extract_scalar_integer_value(
+                        f.get()),
+            std::int64_t(1));
+    }
+
+    // read back the file
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f;
+    {
+        phylanx::execution_tree::primitive infile =
+            phylanx::execution_tree::primitives::create_file_read_csv(
+                hpx::find_here(),
+                phylanx::execution_tree::primitive_arguments_type{
+                    {filename}});
+
+        f = infile.eval();
+    }
+
+    HPX_TEST(in == phylanx::execution_tree::extract_numeric_value(f.get()));
+
+    std::remove(filename.c_str());
+}
+
 void test_file_io(phylanx::ir::node_data<double> const& in)
 {
     test_file_io_lit(in);
     test_file_io_primitive(in);
+    test_file_io_async(in);
 }
 
 int main(int argc, char* argv[])
@@ -0,0 +1,79 @@
+//   Copyright (c) 2020 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string const data = R"(
+    define(data, [[1., 2., 3.], [4., -5., 6.], [7., 8., -9.], [0., 1., 1.],
+        [-2., 3., 5.], [6., 6., 6.], [1., 0., 2.]]))";
+
+// streaming the file in blocks of two rows has to give the same results as
+// the reduction of the whole data set
+void test_file_stream_csv(std::string const& filename,
+    std::string const& stream, std::string const& expected)
+{
+    std::string const prefix =
+        "block(" + data + ", define(w, [1., 2., -1.]), define(f, \"" +
+        filename + "\"), ";
+
+    auto result = compile_and_run(prefix + stream + ")");
+    auto expected_result = compile_and_run(prefix + expected + ")");
+
+    HPX_TEST(allclose(phylanx::execution_tree::extract_numeric_value(result),
+        phylanx::execution_tree::extract_numeric_value(expected_result)));
+}
+
+int main(int argc, char* argv[])
+{
+    std::string filename = std::tmpnam(nullptr);
+    compile_and_run(
+        "block(" + data + ", file_write_csv(\"" + filename + "\", data))");
+
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"sum\", nil, nil, nil, 2)", "sum(data)");
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"mean\", 0, nil, nil, 2)", "mean(data, 0)");
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"var\", nil, nil, nil, 2)", "var(data)");
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"var\", 0, nil, nil, 2)", "var(data, 0)");
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"min\", 0, nil, nil, 2)", "amin(data, 0)");
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"max\", 1, nil, nil, 2)", "amax(data, 1)");
+
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"mean\", 0, lambda(x, x * w), nil, 2)",
+        "mean(data * w, 0)");
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"sum\", 0, lambda(x, dot(x, w)), nil, 2)",
+        "sum(dot(data, w), 0)");
+    test_file_stream_csv(filename,
+        "file_stream_csv(f, \"dot\", nil, nil, w, 2)", "dot(data, w)");
+
+    std::remove(filename.c_str());
+
+    return hpx::util::report_errors();
+}
@@ -10,6 +10,8 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -35,6 +37,122 @@ void test_batch_dot_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// distinct values for all elements of the operands, small enough for the
+// results to be exact
+std::int64_t element_value(std::size_t page, std::size_t i, std::size_t j)
+{
+    return std::int64_t((page * 31 + i * 7 + j * 3) % 17) - 8;
+}
+
+phylanx::execution_tree::primitive_argument_type batch_dot(
+    phylanx::execution_tree::primitive_arguments_type&& operands)
+{
+    phylanx::execution_tree::primitive op =
+        phylanx::execution_tree::primitives::create_batch_dot_operation(
+            hpx::find_here(), std::move(operands));
+
+    return op.eval().get();
+}
+
+// batch_dot of a (pages, rows, k) and a (pages, k, columns) tensor, or of a
+// (pages, rows, k) and a (pages, columns, k) tensor if the right operand is
+// transposed (axes (2, 2))
+void test_batch_dot_operation_3d(std::size_t pages, std::size_t rows,
+    std::size_t k, std::size_t columns, bool transposed)
+{
+    blaze::DynamicTensor<std::int64_t> lhs(pages, rows, k);
+    blaze::DynamicTensor<std::int64_t> rhs = transposed ?
+        blaze::DynamicTensor<std::int64_t>(pages, columns, k) :
+        blaze::DynamicTensor<std::int64_t>(pages, k, columns);
+
+    for (std::size_t p = 0; p != pages; ++p)
+    {
+        for (std::size_t i = 0; i != lhs.rows(); ++i)
+        {
+            for (std::size_t j = 0; j != lhs.columns(); ++j)
+            {
+                lhs(p, i, j) = element_value(p, i, j);
+            }
+        }
+        for (std::size_t i = 0; i != rhs.rows(); ++i)
+        {
+            for (std::size_t j = 0; j != rhs.columns(); ++j)
+            {
+                rhs(p, i, j) = element_value(p + 1, j, i);
+            }
+        }
+    }
+
+    blaze::DynamicTensor<std::int64_t> expected(pages, rows, columns, 0);
+    for (std::size_t p = 0; p != pages; ++p)
+    {
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                for (std::size_t l = 0; l != k; ++l)
+                {
+                    expected(p, i, j) += lhs(p, i, l) *
+                        (transposed ? rhs(p, j, l) : rhs(p, l, j));
+                }
+            }
+        }
+    }
+
+    phylanx::execution_tree::primitive_arguments_type operands{
+        phylanx::ir::node_data<std::int64_t>(std::move(lhs)),
+        phylanx::ir::node_data<std::int64_t>(std::move(rhs))};
+    if (transposed)
+    {
+        operands.emplace_back(phylanx::execution_tree::primitive_arguments_type{
+            phylanx::execution_tree::primitive_argument_type{std::int64_t(2)},
+            phylanx::execution_tree::primitive_argument_type{std::int64_t(2)}});
+    }
+
+    HPX_TEST_EQ(phylanx::ir::node_data<std::int64_t>(std::move(expected)),
+        phylanx::execution_tree::extract_integer_value(
+            batch_dot(std::move(operands))));
+}
+
+// batch_dot of a (pages, k) matrix and a (pages, k, columns) tensor
+void test_batch_dot_operation_2d(
+    std::size_t pages, std::size_t k, std::size_t columns)
+{
+    blaze::DynamicMatrix<std::int64_t> lhs(pages, k);
+    blaze::DynamicTensor<std::int64_t> rhs(pages, k, columns);
+
+    for (std::size_t p = 0; p != pages; ++p)
+    {
+        for (std::size_t l = 0; l != k; ++l)
+        {
+            lhs(p, l) = element_value(p, 0, l);
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                rhs(p, l, j) = element_value(p + 1, j, l);
+            }
+        }
+    }
+
+    blaze::DynamicMatrix<std::int64_t> expected(pages, columns, 0);
+    for (std::size_t p = 0; p != pages; ++p)
+    {
+        for (std::size_t j = 0; j != columns; ++j)
+        {
+            for (std::size_t l = 0; l != k; ++l)
+            {
+                expected(p, j) += lhs(p, l) * rhs(p, l, j);
+            }
+        }
+    }
+
+    HPX_TEST_EQ(phylanx::ir::node_data<std::int64_t>(std::move(expected)),
+        phylanx::execution_tree::extract_integer_value(
+            batch_dot(phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<std::int64_t>(std::move(lhs)),
+                phylanx::ir::node_data<std::int64_t>(std::move(rhs))})));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -124,5 +242,10 @@ int main(int argc, char* argv[])
         "[[[ -23,  -58],[  0,  -5],[ 1, 3]],[[ -600, -1307],[ -335,  -808],"
         "[-39, -96]]]");
 
+    // batches of many small pages are grouped and computed concurrently
+    test_batch_dot_operation_3d(512, 8, 8, 8, false);
+    test_batch_dot_operation_3d(64, 5, 7, 6, true);
+    test_batch_dot_operation_2d(128, 64, 64);
+
     return hpx::util::report_errors();
 }
@@ -0,0 +1,140 @@
+// Copyright (c) 2020 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the fused primitives have to produce the same results as the unfused
+// expressions
+void test_fused_crossentropy_operation(std::string const& code,
+    std::string const& expected_str)
+{
+    auto result = phylanx::execution_tree::extract_list_value(
+        compile_and_run(code));
+    auto expected = phylanx::execution_tree::extract_list_value(
+        compile_and_run(expected_str));
+
+    HPX_TEST_EQ(result.size(), expected.size());
+
+    auto it = result.begin();
+    for (auto const& e : expected)
+    {
+        HPX_TEST(allclose(phylanx::execution_tree::extract_numeric_value(e),
+            phylanx::execution_tree::extract_numeric_value(*it++)));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string const softmax_expected = R"(
+        make_list(
+            0.0 - sum(t * log(softmax(x)), -1),
+            softmax(x) - t))
+    )";
+
+std::string const sigmoid_expected = R"(
+        make_list(
+            maximum(x, 0.0) - x * t + log(1.0 + exp(0.0 - absolute(x))),
+            sigmoid(x) - t))
+    )";
+
+void test_softmax_cross_entropy_1d()
+{
+    std::string const define = R"(block(
+        define(t, [0., 0., 1., 0.]),
+        define(x, [1., 2., 3., -4.]),)";
+
+    test_fused_crossentropy_operation(
+        define + "softmax_cross_entropy_with_logits(t, x))",
+        define + softmax_expected);
+}
+
+void test_softmax_cross_entropy_2d()
+{
+    std::string const define = R"(block(
+        define(t, [[0., 1., 0.], [1., 0., 0.], [0., 0., 1.]]),
+        define(x, [[1., 2., 3.], [-1., 0., 5.], [100., 200., 300.]]),)";
+
+    test_fused_crossentropy_operation(
+        define + "softmax_cross_entropy_with_logits(t, x))",
+        define + softmax_expected);
+}
+
+void test_softmax_cross_entropy_3d()
+{
+    std::string const define = R"(block(
+        define(t, [[[0., 1.], [1., 0.], [0., 1.]],
+                   [[1., 0.], [0., 1.], [1., 0.]]]),
+        define(x, [[[1., 2.], [-3., 0.5], [7., 2.]],
+                   [[0., 0.], [4., -4.], [1., 1.5]]]),)";
+
+    test_fused_crossentropy_operation(
+        define + "softmax_cross_entropy_with_logits(t, x))",
+        define + softmax_expected);
+}
+
+void test_sigmoid_cross_entropy_1d()
+{
+    std::string const define = R"(block(
+        define(t, [0., 1., 1., 0.]),
+        define(x, [1., -2., 3., -40.]),)";
+
+    test_fused_crossentropy_operation(
+        define + "sigmoid_cross_entropy_with_logits(t, x))",
+        define + sigmoid_expected);
+}
+
+void test_sigmoid_cross_entropy_2d()
+{
+    std::string const define = R"(block(
+        define(t, [[0., 1., 0.], [1., 0.5, 0.]]),
+        define(x, [[1., 2., -3.], [-1., 0., 5.]]),)";
+
+    test_fused_crossentropy_operation(
+        define + "sigmoid_cross_entropy_with_logits(t, x))",
+        define + sigmoid_expected);
+}
+
+void test_sigmoid_cross_entropy_3d()
+{
+    std::string const define = R"(block(
+        define(t, [[[0., 1.], [1., 0.]], [[1., 0.], [0., 1.]]]),
+        define(x, [[[1., 2.], [-3., 0.5]], [[0., 0.], [4., -4.]]]),)";
+
+    test_fused_crossentropy_operation(
+        define + "sigmoid_cross_entropy_with_logits(t, x))",
+        define + sigmoid_expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_softmax_cross_entropy_1d();
+    test_softmax_cross_entropy_2d();
+    test_softmax_cross_entropy_3d();
+
+    test_sigmoid_cross_entropy_1d();
+    test_sigmoid_cross_entropy_2d();
+    test_sigmoid_cross_entropy_3d();
+
+    return hpx::util::report_errors();
+}
@@ -114,5 +114,25 @@ int main(int argc, char* argv[])
         "[[[[ 4.,  5.,  6.,  7.]], [[28., 29., 30., 31.]]],"
         "[[[40., 41., 42., 43.]], [[64., 61., 62., 67.]]]]");
 
+    // overlapping windows, with indices of the maxima
+    test_max_pool2d_operation(
+        R"(max_pool2d(
+        [[[[1.], [5.], [2.], [0.]], [[3.], [4.], [4.], [8.]],
+          [[7.], [6.], [1.], [2.]], [[0.], [2.], [9.], [4.]]]],
+        make_list(3,3), "valid", make_list(1,1), true))",
+        R"(make_list(
+        [[[[7.], [8.]], [[9.], [9.]]]],
+        [[[[8], [7]], [[14], [14]]]]))");
+    test_max_pool2d_operation(
+        R"(max_pool2d(
+        [[[[1.], [5.], [2.], [0.]], [[3.], [4.], [4.], [8.]],
+          [[7.], [6.], [1.], [2.]], [[0.], [2.], [9.], [4.]]]],
+        make_list(3,3), "same", make_list(1,1), true))",
+        R"(make_list(
+        [[[[5.], [5.], [8.], [8.]], [[7.], [7.], [8.], [8.]],
+          [[7.], [9.], [9.], [9.]], [[7.], [9.], [9.], [9.]]]],
+        [[[[1], [1], [7], [7]], [[8], [8], [7], [7]],
+          [[8], [14], [14], [14]], [[8], [14], [14], [14]]]]))");
+
     return hpx::util::report_errors();
 }
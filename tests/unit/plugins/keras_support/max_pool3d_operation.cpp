@@ -58,5 +58,11 @@ int main(int argc, char* argv[])
           make_list(3,2,1)))",
         "[[[42., 42.,  3.], [13., 23., 23.]]]");
 
+    // indices of the maxima
+    test_max_pool3d_operation(
+        R"(max_pool3d([[[1, 3], [2, 0]], [[4, 0], [1, 5]]],
+          make_list(2,2,1), "valid", make_list(1,1,1), true))",
+        "make_list([[[4., 5.]]], [[[4, 7]]])");
+
     return hpx::util::report_errors();
 }
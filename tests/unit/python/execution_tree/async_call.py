@@ -0,0 +1,54 @@
+#  Copyright (c) 2020 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import asyncio
+from concurrent import futures
+
+import numpy as np
+from phylanx import Phylanx
+
+
+@Phylanx
+def scale(x, factor):
+    return x * factor
+
+
+@Phylanx
+def fail(x):
+    return x[10]
+
+
+x = np.arange(8, dtype=np.float64)
+
+f = scale.async_call(x, 2.0)
+assert isinstance(f, futures.Future)
+
+# the arguments were copied, modifying them does not change the result
+x[0] = 42.0
+assert (f.result() == np.arange(8, dtype=np.float64) * 2.0).all()
+
+# several evaluations may be in flight at the same time
+fs = [scale.async_call(x, float(i)) for i in range(4)]
+for i, f in enumerate(fs):
+    assert (f.result() == x * float(i)).all()
+
+# errors are reported through the future
+f = fail.async_call(np.arange(3, dtype=np.float64))
+caught_exception = False
+try:
+    f.result()
+except RuntimeError:
+    caught_exception = True
+assert caught_exception
+
+
+# the returned futures can be awaited
+async def awaitable():
+    return await asyncio.wrap_future(scale.async_call(x, 3.0))
+
+
+loop = asyncio.new_event_loop()
+assert (loop.run_until_complete(awaitable()) == x * 3.0).all()
+loop.close()
@@ -0,0 +1,51 @@
+#  Copyright (c) 2020 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import numpy as np
+from phylanx import Phylanx
+
+
+@Phylanx
+def add_one(x):
+    return x + 1.0
+
+
+@Phylanx
+def identity(x):
+    return x
+
+
+@Phylanx
+def greater(x, y):
+    return x > y
+
+
+# contiguous arrays are referenced by the evaluation without being copied
+x = np.arange(16, dtype=np.float64).reshape(2, 8)
+assert (add_one(x) == x + 1.0).all()
+assert (x == np.arange(16, dtype=np.float64).reshape(2, 8)).all()
+
+y = identity(x)
+assert np.shares_memory(y, x)
+assert y.shape == x.shape
+
+# arrays that can't be referenced directly are copied
+f = np.asfortranarray(x)
+assert (add_one(f) == f + 1.0).all()
+assert (identity(f) == f).all()
+assert not np.shares_memory(identity(f), f)
+
+s = np.arange(32, dtype=np.float64)[::2]
+assert (add_one(s) == s + 1.0).all()
+assert (identity(s) == s).all()
+assert not np.shares_memory(identity(s), s)
+
+v = np.arange(5, dtype=np.float64)
+assert (add_one(v) == v + 1.0).all()
+
+# boolean results are returned as numpy arrays of type bool
+r = greater(np.array([1.0, 3.0, 2.0]), np.array([2.0, 2.0, 2.0]))
+assert r.dtype == np.bool_
+assert (r == np.array([False, True, False])).all()
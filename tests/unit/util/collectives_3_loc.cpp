@@ -0,0 +1,91 @@
+//  Copyright (c) 2020 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/include/util.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// the algorithm (ring or tree) is selected on the command line (see
+// CMakeLists.txt), for the ring each segment holds two elements only (see
+// main below)
+void test_all_reduce_vector()
+{
+    std::size_t const num_sites = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t const this_site = hpx::get_locality_id();
+
+    blaze::DynamicVector<double> v(11);
+    blaze::DynamicVector<double> expected(11);
+    for (std::size_t i = 0; i != v.size(); ++i)
+    {
+        v[i] = double(this_site * 100 + i);
+        expected[i] = double(num_sites * (num_sites - 1) / 2 * 100) +
+            double(num_sites * i);
+    }
+
+    for (int i = 0; i != 3; ++i)
+    {
+        auto result = phylanx::util::all_reduce("test_all_reduce_vector", v,
+            blaze::Add{}, num_sites, this_site)
+                          .get();
+        HPX_TEST_EQ(result, expected);
+    }
+}
+
+void test_all_reduce_matrix()
+{
+    std::size_t const num_sites = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t const this_site = hpx::get_locality_id();
+
+    blaze::DynamicMatrix<std::int64_t> m(5, 3);
+    blaze::DynamicMatrix<std::int64_t> expected(5, 3);
+    for (std::size_t i = 0; i != m.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != m.columns(); ++j)
+        {
+            m(i, j) = std::int64_t(this_site + 1) * std::int64_t(i * 3 + j);
+            expected(i, j) = std::int64_t(num_sites * (num_sites + 1) / 2) *
+                std::int64_t(i * 3 + j);
+        }
+    }
+
+    auto result = phylanx::util::all_reduce("test_all_reduce_matrix",
+        std::move(m), blaze::Add{}, num_sites, this_site)
+                      .get();
+    HPX_TEST_EQ(result, expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_all_reduce_vector();
+    test_all_reduce_matrix();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1",
+        "phylanx.collectives.segment_size!=16"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
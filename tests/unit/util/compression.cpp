@@ -0,0 +1,121 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/compression.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// compression is enabled for all payloads of at least 1024 bytes (see main
+// below)
+void test_compress_sparse()
+{
+    std::vector<double> data(10000, 0.0);
+    for (std::size_t i = 0; i < data.size(); i += 37)
+    {
+        data[i] = double(i % 5);
+    }
+
+    std::size_t const bytes = data.size() * sizeof(double);
+    std::vector<char> compressed = phylanx::util::compress(
+        reinterpret_cast<char const*>(data.data()), bytes, sizeof(double));
+
+    HPX_TEST(!compressed.empty());
+    HPX_TEST_LT(compressed.size(), bytes / 4);
+
+    std::vector<double> result(data.size());
+    phylanx::util::decompress(compressed.data(), compressed.size(),
+        reinterpret_cast<char*>(result.data()), bytes, sizeof(double));
+
+    HPX_TEST(result == data);
+}
+
+void test_compress_random()
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist;
+
+    std::vector<double> data(1000);
+    for (auto& d : data)
+    {
+        d = dist(gen);
+    }
+
+    // random data is not compressible
+    std::vector<char> compressed =
+        phylanx::util::compress(reinterpret_cast<char const*>(data.data()),
+            data.size() * sizeof(double), sizeof(double));
+
+    HPX_TEST(compressed.empty());
+}
+
+void test_serialize_block()
+{
+    blaze::DynamicMatrix<std::int64_t> m(47, 31, 0);
+    for (std::size_t i = 0; i != m.rows(); ++i)
+    {
+        m(i, i % m.columns()) = std::int64_t(i);
+    }
+
+    auto sm = blaze::submatrix(m, 3, 5, 40, 20);
+    blaze::DynamicMatrix<std::int64_t> result(40, 20, -1);
+
+    phylanx::util::compression_bytes_uncompressed(true);
+    phylanx::util::compression_bytes_compressed(true);
+
+    std::vector<char> buffer;
+    {
+        hpx::serialization::output_archive oar(buffer);
+        phylanx::util::save_block(
+            oar, sm.data(), sm.rows(), sm.columns(), sm.spacing());
+    }
+    {
+        hpx::serialization::input_archive iar(buffer);
+        phylanx::util::load_block(iar, result.data(), result.rows(),
+            result.columns(), result.spacing());
+    }
+
+    HPX_TEST_EQ(result, blaze::DynamicMatrix<std::int64_t>(sm));
+
+    HPX_TEST_EQ(phylanx::util::compression_bytes_uncompressed(false),
+        std::int64_t(40 * 20 * sizeof(std::int64_t)));
+    HPX_TEST_LT(phylanx::util::compression_bytes_compressed(false),
+        std::int64_t(40 * 20 * sizeof(std::int64_t)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_compress_sparse();
+    test_compress_random();
+    test_serialize_block();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "phylanx.compression!=1",
+        "phylanx.compression.threshold!=1024"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+REGISTER_DISTRIBUTED_MATRIX_DECLARATION(double);
+
+///////////////////////////////////////////////////////////////////////////////
+blaze::DynamicMatrix<double> generate_tile(std::size_t site)
+{
+    blaze::DynamicMatrix<double> m(4, 4);
+    for (std::size_t i = 0; i != m.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != m.columns(); ++j)
+        {
+            m(i, j) = double(site * 100 + i * m.columns() + j);
+        }
+    }
+    return m;
+}
+
+// the cache holds two parts only (see main below)
+void test_prefetch()
+{
+    std::size_t const num_sites = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t const this_site = hpx::get_locality_id();
+    std::size_t const other_site = (this_site + 1) % num_sites;
+
+    blaze::DynamicMatrix<double> tile = generate_tile(this_site);
+    blaze::DynamicMatrix<double> expected = generate_tile(other_site);
+
+    {
+        phylanx::util::distributed_matrix<double> m_data("test_prefetch",
+            blaze::CustomMatrix<double, blaze::aligned, blaze::padded>(
+                tile.data(), tile.rows(), tile.columns(), tile.spacing()),
+            num_sites, this_site);
+
+        phylanx::util::prefetch_cache_hits(true);
+        phylanx::util::prefetch_cache_misses(true);
+
+        // fetch a prefetched part
+        m_data.prefetch(other_site, 0, 0, 2, 4);
+        HPX_TEST_EQ(m_data.fetch(other_site, 0, 0, 2, 4).get(),
+            blaze::submatrix(expected, 0, 0, 2, 4));
+
+        HPX_TEST_EQ(phylanx::util::prefetch_cache_hits(true), 1);
+        HPX_TEST_EQ(phylanx::util::prefetch_cache_misses(true), 0);
+
+        // a part is taken from the cache only once
+        HPX_TEST_EQ(m_data.fetch(other_site, 0, 0, 2, 4).get(),
+            blaze::submatrix(expected, 0, 0, 2, 4));
+
+        HPX_TEST_EQ(phylanx::util::prefetch_cache_hits(true), 0);
+        HPX_TEST_EQ(phylanx::util::prefetch_cache_misses(true), 1);
+
+        // the part prefetched first is evicted
+        m_data.prefetch(other_site, 0, 0, 1, 4);
+        m_data.prefetch(other_site, 1, 0, 2, 4);
+        m_data.prefetch(other_site, 2, 1, 4, 3);
+
+        HPX_TEST_EQ(m_data.fetch(other_site, 0, 0, 1, 4).get(),
+            blaze::submatrix(expected, 0, 0, 1, 4));
+        HPX_TEST_EQ(m_data.fetch(other_site, 2, 1, 4, 3).get(),
+            blaze::submatrix(expected, 2, 1, 2, 2));
+
+        // fetch a prefetched part into a given target
+        blaze::DynamicMatrix<double> target(3, 5, 0.0);
+        auto sm = blaze::submatrix(target, 1, 1, 1, 4);
+        m_data.fetch(other_site, 1, 0, 2, 4, sm).get();
+
+        HPX_TEST_EQ(blaze::submatrix(target, 1, 1, 1, 4),
+            blaze::submatrix(expected, 1, 0, 1, 4));
+        HPX_TEST_EQ(target(0, 0), 0.0);
+
+        HPX_TEST_EQ(phylanx::util::prefetch_cache_hits(true), 2);
+        HPX_TEST_EQ(phylanx::util::prefetch_cache_misses(true), 1);
+
+        // keep the local part alive until all sites are done
+        hpx::lcos::barrier b("barrier_test_prefetch", num_sites, this_site);
+        b.wait();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_prefetch();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1",
+        "phylanx.distributed_matrix.prefetch_cache_size!=2"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}